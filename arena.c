@@ -0,0 +1,220 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   arena.c
+/
+/  File Description:
+/    This file implements the Arena bump allocator that backs the
+/    per-run state of the simulator (timelines, ready sets, metric
+/    tables, chart buffers, trace and series buffers). Each thread has
+/    its own arena, so parallel runs never contend for it, and a run
+/    resets it rather than freeing what it used. A worker running
+/    thousands of short simulations back to back therefore reuses the
+/    same memory each time, with no allocator calls and no
+/    fragmentation.
+/
+/    Every function also accepts a NULL arena, in which case it falls
+/    back to malloc, realloc and free. This lets the data structures
+/    be used on their own.
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+#define ARENA_DEFAULT_BLOCK (64 * 1024)
+#define ARENA_ALIGN 16
+
+_Thread_local Arena thread_arena_storage;
+_Thread_local int thread_arena_ready = 0;
+
+ArenaBlock *arena_new_block(size_t size, ArenaBlock *next);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions manage the lifetime of an Arena.
+/
+/  Functions and Their Purpose:
+/    - arena_init: Initializes an empty arena. No memory is allocated
+/      until the first allocation.
+/    - arena_free: Returns all of the arena's memory to the system.
+/    - arena_reset: Hands back every allocation at once and clears
+/      failed. The memory is kept; if the last run needed more than one
+/      block, they are replaced by a single block as large as all of
+/      them, so the next run of the same size fits without allocating.
+/    - thread_arena: The calling thread's arena, created on first use.
+/    - thread_arena_free: Frees the calling thread's arena. Worker
+/      threads should call this before exiting.
+/
+/  Input Parameters:
+/    - Arena *arena: the arena to operate on
+/    - size_t block_size: minimum size of each block (0 for 64 KB)
+/
+/  Output:
+/    - thread_arena returns a pointer to the thread's arena
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - if the single block cannot be allocated, arena_reset leaves the
+/      arena empty, to allocate again on first use
+/------------------------------------------------------------------------*/
+void arena_init(Arena *arena, size_t block_size) {
+    arena->current = NULL;
+    arena->block_size = block_size > 0 ? block_size : ARENA_DEFAULT_BLOCK;
+    arena->last = NULL;
+    arena->last_size = 0;
+    arena->failed = 0;
+}
+
+void arena_free(Arena *arena) {
+    ArenaBlock *block = arena->current;
+
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena_init(arena, arena->block_size);
+}
+
+void arena_reset(Arena *arena) {
+    ArenaBlock *block = arena->current;
+
+    if (block != NULL && block->next != NULL) {
+        size_t total = 0;
+        for (ArenaBlock *b = block; b != NULL; b = b->next) {
+            total += b->size;
+        }
+        arena_free(arena);
+        arena->current = arena_new_block(total, NULL);
+    } else if (block != NULL) {
+        block->used = 0;
+    }
+
+    arena->last = NULL;
+    arena->last_size = 0;
+    arena->failed = 0;
+}
+
+Arena *thread_arena(void) {
+    if (!thread_arena_ready) {
+        arena_init(&thread_arena_storage, 0);
+        thread_arena_ready = 1;
+    }
+    return &thread_arena_storage;
+}
+
+void thread_arena_free(void) {
+    if (thread_arena_ready) {
+        arena_free(&thread_arena_storage);
+    }
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions hand out memory from an Arena.
+/
+/  Functions and Their Purpose:
+/    - arena_alloc: Returns size bytes, aligned to 16 bytes.
+/    - arena_grow: Resizes an allocation, like realloc. The most recent
+/      allocation is extended in place when its block has room;
+/      otherwise the contents are copied to a new allocation and the
+/      old space is reclaimed at the next reset.
+/    - arena_release: Gives an allocation back. A no-op for an arena,
+/      since its memory is reclaimed by arena_reset.
+/
+/  Input Parameters:
+/    - Arena *arena: the arena, or NULL to use malloc/realloc/free
+/    - size_t size, old_size, new_size: allocation sizes in bytes
+/    - void *ptr: an allocation made from the same arena, or NULL
+/
+/  Output:
+/    - a pointer to the memory, or NULL if it cannot be allocated (the
+/      arena is then marked failed, and arena_grow leaves ptr as it was)
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - prints an error if memory cannot be allocated
+/    - the memory is not zeroed
+/------------------------------------------------------------------------*/
+void *arena_alloc(Arena *arena, size_t size) {
+    ArenaBlock *block;
+    size_t offset;
+    void *ptr;
+
+    if (arena == NULL) {
+        ptr = malloc(size > 0 ? size : 1);
+        if (ptr == NULL) {
+            fprintf(stderr, "Error: out of memory.\n");
+        }
+        return ptr;
+    }
+
+    block = arena->current;
+    offset = block != NULL ? (block->used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1) : 0;
+
+    if (block == NULL || offset + size > block->size) {
+        size_t block_size = size > arena->block_size ? size : arena->block_size;
+        block = arena_new_block(block_size, arena->current);
+        if (block == NULL) {
+            fprintf(stderr, "Error: out of memory.\n");
+            arena->failed = 1;
+            return NULL;
+        }
+        arena->current = block;
+        offset = 0;
+    }
+
+    ptr = block->data + offset;
+    block->used = offset + size;
+    arena->last = ptr;
+    arena->last_size = size;
+    return ptr;
+}
+
+void *arena_grow(Arena *arena, void *ptr, size_t old_size, size_t new_size) {
+    void *grown;
+
+    if (arena == NULL) {
+        grown = realloc(ptr, new_size > 0 ? new_size : 1);
+        if (grown == NULL) {
+            fprintf(stderr, "Error: out of memory.\n");
+        }
+        return grown;
+    }
+
+    if (ptr != NULL && ptr == arena->last) {
+        ArenaBlock *block = arena->current;
+        size_t offset = (char *)ptr - block->data;
+        if (offset + new_size <= block->size) {
+            block->used = offset + new_size;
+            arena->last_size = new_size;
+            return ptr;
+        }
+    }
+
+    grown = arena_alloc(arena, new_size);
+    if (grown != NULL && ptr != NULL && old_size > 0) {
+        memcpy(grown, ptr, old_size < new_size ? old_size : new_size);
+    }
+    return grown;
+}
+
+void arena_release(Arena *arena, void *ptr) {
+    if (arena == NULL) {
+        free(ptr);
+    }
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+
+ArenaBlock *arena_new_block(size_t size, ArenaBlock *next) {
+    ArenaBlock *block = malloc(sizeof(ArenaBlock) + size);
+
+    if (block == NULL) return NULL;
+    block->next = next;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
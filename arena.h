@@ -0,0 +1,83 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   arena.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/*---------- STRUCTURE: ArenaBlock ------------------------
+/  Structure Description:
+/    One chunk of memory owned by an Arena. Allocations are carved
+/    from data in order.
+/
+/  Fields:
+/    struct ArenaBlock *next
+/      The block allocated before this one, or NULL
+/    size_t size
+/      Number of bytes in data
+/    size_t used
+/      Number of bytes of data handed out
+/    char data[]
+/      The memory itself
+/
+/  Relationships:
+/    - chained together by an Arena
+/---------------------------------------------------------*/
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t size;
+    size_t used;
+    _Alignas(16) char data[];
+} ArenaBlock;
+
+/*---------- STRUCTURE: Arena ------------------------------
+/  Structure Description:
+/    A bump allocator for the transient state of simulation runs.
+/    Allocating is a pointer increment, nothing is freed on its own,
+/    and arena_reset hands all of the memory back at once while
+/    keeping it for the next run. Once an arena has grown to fit the
+/    largest run, later runs make no calls to malloc at all.
+/
+/  Fields:
+/    ArenaBlock *current
+/      The block allocations are taken from (the newest block)
+/    size_t block_size
+/      Minimum size of a new block
+/    void *last
+/      The most recent allocation, which arena_grow can extend in place
+/    size_t last_size
+/      Size of the most recent allocation
+/    int failed
+/      1 once an allocation could not be made, until the next
+/      arena_reset; a run checks it to report that it ran out of memory
+/
+/  Relationships:
+/    - contains a chain of ArenaBlocks
+/    - used by sim_run, sim_stream and the per-run data structures
+/---------------------------------------------------------*/
+typedef struct {
+    ArenaBlock *current;
+    size_t block_size;
+    void *last;
+    size_t last_size;
+    int failed;
+} Arena;
+
+void arena_init(Arena *arena, size_t block_size);
+void arena_free(Arena *arena);
+void arena_reset(Arena *arena);
+void *arena_alloc(Arena *arena, size_t size);
+void *arena_grow(Arena *arena, void *ptr, size_t old_size, size_t new_size);
+void arena_release(Arena *arena, void *ptr);
+Arena *thread_arena(void);
+void thread_arena_free(void);
+
+#endif
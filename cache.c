@@ -0,0 +1,146 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   cache.c
+/
+/  File Description:
+/    This file implements the cache warm-up model. Each process has a
+/    working set, measured by the time it takes to reload from cold,
+/    and a warmth: the fraction of it still in the cache. When the
+/    process is dispatched, the part that is missing must be reloaded
+/    before it makes progress again, so the refill is charged as extra
+/    time at the start of the run, and the penalty is gone once the
+/    process has run that long. A process switched away before the 
+/    refill is done leaves with only the part it reloaded. The refill
+/    does not use up a Round Robin time slice, so every run makes some
+/    progress however short the slice.
+/
+/    While a process waits, the processes that run in its place evict
+/    its lines, so its warmth decays exponentially with their CPU time:
+/
+/      warmth = warmth when it left * e^(-(busy time since) / decay)
+/
+/    Rather than store both the warmth and the busy time at which the
+/    process left, the two are folded into one stamp, the busy time at
+/    which the process would have been fully warm:
+/
+/      stamp = busy when it left + decay * ln(warmth when it left)
+/      warmth = e^((stamp - busy) / decay), at most 1
+/
+/    A process that has not run has a stamp of minus infinity.
+/
+/  Citations:
+/  - Thiebaut and Stone, "Footprints in the Cache", ACM Transactions on
+/    Computer Systems 5(4), 1987
+/  - Mogul and Borg, "The Effect of Context Switches on Cache
+/    Performance", ASPLOS IV, 1991
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "process.h"
+#include "cache.h"
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: init_cache_model --------------------
+/  Function Description:
+/    Turns the cache model off.
+/
+/  Caller Input:
+/    CacheModel *model: the model to initialize
+/
+/  Caller Output:
+/    N/A - No return value
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void init_cache_model(CacheModel *model) {
+    model->enabled = 0;
+    model->working_set = 0;
+    model->decay = 0;
+}
+
+/*---------- FUNCTION: parse_cache_model -------------------
+/  Function Description:
+/    Reads a cache model as given with --cache-penalty:
+/    "working_set[,decay]". The decay defaults to the working set.
+/
+/  Caller Input:
+/    const char *spec: the model
+/    CacheModel *model: filled in and enabled
+/
+/  Caller Output:
+/    0 on success, 1 if the working set is not a non-negative integer
+/    or the decay is not a positive number
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - a working set of 0 (only processes that give their own are 
+/      charged) needs a decay
+/---------------------------------------------------------*/
+int parse_cache_model(const char *spec, CacheModel *model) {
+    char *end;
+    long working_set;
+
+    init_cache_model(model);
+    working_set = strtol(spec, &end, 10);
+    if (end == spec || working_set < 0 || working_set > 1000000000L) return 1;
+    model->working_set = (int)working_set;
+    model->decay = working_set;
+
+    if (*end == ',') {
+        const char *decay = end + 1;
+
+        model->decay = strtod(decay, &end);
+        if (end == decay) return 1;
+    }
+    if (*end != '\0' || model->decay <= 0) return 1;
+
+    model->enabled = 1;
+    return 0;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions follow a process's warmth across its runs.
+/
+/  Functions and Their Purpose:
+/    - cache_refill: The time the process must spend reloading its
+/      working set when it is dispatched: the part that is missing,
+/      rounded to the nearest time unit.
+/    - cache_leave: Records the process's warmth as it is switched
+/      away, with unpaid time units of its refill still owed (those
+/      parts of the working set are still missing).
+/
+/  Input Parameters:
+/    - const CacheModel *model: the model
+/    - Process *process: the process
+/    - long long unpaid: refill time not yet paid
+/    - long long busy: CPU busy time so far in the run
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the process's working_set must have been set, and its
+/      cache_stamp reset by reset_process
+/------------------------------------------------------------------------*/
+long long cache_refill(const CacheModel *model, const Process *process, long long busy) {
+    double warmth;
+
+    if (!model->enabled || process->working_set == 0) return 0;
+    warmth = exp((process->cache_stamp - busy) / model->decay);
+    if (warmth > 1) warmth = 1;
+    return (long long)(process->working_set * (1 - warmth) + 0.5);
+}
+
+void cache_leave(const CacheModel *model, Process *process, long long unpaid, long long busy) {
+    if (!model->enabled || process->working_set == 0) return;
+    if (unpaid >= process->working_set) {
+        process->cache_stamp = -HUGE_VAL;
+    } else {
+        process->cache_stamp = busy + model->decay * log(1 - (double)unpaid / process->working_set);
+    }
+}
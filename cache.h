@@ -0,0 +1,48 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   cache.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "process.h"
+
+/*---------- STRUCTURE: CacheModel -------------------------
+/  Structure Description:
+/    A model of the time a process loses reloading its cache working
+/    set when it is dispatched. A process that has not run yet starts
+/    cold; one that waits keeps its cache while the CPU is idle, and
+/    loses it gradually while other processes run.
+/
+/  Fields:
+/    int enabled
+/      1 if refills are charged, 0 if CPU time is all useful work
+/    int working_set
+/      Working set of processes whose input gives none: the time it 
+/      takes to reload from cold, in time units
+/    double decay
+/      CPU time of other processes after which a waiting process has 
+/      1/e of its working set left in the cache
+/
+/  Relationships:
+/    - contained in SimContext
+/    - reads and updates the cache fields of Process
+/---------------------------------------------------------*/
+typedef struct {
+    int enabled;
+    int working_set;
+    double decay;
+} CacheModel;
+
+void init_cache_model(CacheModel *model);
+int parse_cache_model(const char *spec, CacheModel *model);
+long long cache_refill(const CacheModel *model, const Process *process, long long busy);
+void cache_leave(const CacheModel *model, Process *process, long long unpaid, long long busy);
+
+#endif
@@ -7,8 +7,8 @@
 /    This file implements a circular queue data structure and provides
 /    functions to manipulate and display elements within it. The circular
 /    queue supports operations such as enqueue, dequeue, display, and sort.
-/    It uses a fixed-size array to store the elements and wraps the queue
-/    around when the end of the array is reached.
+/    It uses an array given by the caller to store the elements and 
+/    wraps the queue around when the end of the array is reached.
 /
 /---------------------------------------------------------*/
 #include <stdio.h>
@@ -18,11 +18,13 @@
 #include "globals.h"
 #include "process.h"
 #include "compare.h"
+#include "stats.h"
 
 void circ_queue_test_1();
 void init_process(Process *process, int proc_id);
 void peek_front(CircularQueue *queue);
 void peek_rear(CircularQueue *queue);
+void reverse_processes(Process *data, int count);
 
 
 /*---------- Public Functions Used Outside Module ----------------------------*/
@@ -32,8 +34,9 @@ void peek_rear(CircularQueue *queue);
 /    queue for scheduling processes.
 /
 /  Functions and Their Purpose:
-/    - init_queue: Initializes the circular queue by setting the front,
-/      rear, and fill attributes to indicate an empty queue.
+/    - init_queue: Initializes the circular queue to hold up to 
+/      capacity processes in data, and sets the front, rear, and fill
+/      attributes to indicate an empty queue.
 /    - isEmpty: Checks if the queue is empty.
 /    - isFull: Checks if the queue is full.
 /    - enqueue: Adds a process to the rear of the queue. If the queue
@@ -44,6 +47,8 @@ void peek_rear(CircularQueue *queue);
 /  Input Parameters:
 /    - All functions operate on a pointer to a CircularQueue structure and,
 /      where applicable, take a Process structure as input.
+/    - init_queue also takes the array to store the queue in, and how 
+/      many processes it has room for.
 /  
 /  Output:
 /    - The functions either return an integer value (for checking if the
@@ -51,10 +56,12 @@ void peek_rear(CircularQueue *queue);
 /      or modify the queue by enqueuing or dequeuing processes. 
 /
 /  Assumptions, Limitations, Known Bugs:
-/    - No known bugs at this time.
+/    - the array must outlive the queue
 /
 /------------------------------------------------------------------------*/
-void init_queue(CircularQueue *queue) {
+void init_queue(CircularQueue *queue, Process *data, int capacity) {
+    queue->data = data;
+    queue->capacity = capacity;
     queue->front = -1;
     queue->rear = -1;
     queue->fill = 0;
@@ -66,28 +73,30 @@ int isEmpty(CircularQueue *queue) {
 
 
 int isFull(CircularQueue *queue) {
-    return queue->fill == MAX_PROCESSES;
+    return queue->fill == queue->capacity;
 }
 
 
 void enqueue(CircularQueue *queue, Process process) {
+    STAT_INC(enqueues);
     if (isFull(queue)) {
         fprintf(stderr, "Error: queue is full, cannot enqueue.\n");
         return;
     } else if (isEmpty(queue)) {
         queue->front++;
     }
-    queue->rear = (queue->rear + 1) % MAX_PROCESSES;
+    queue->rear = (queue->rear + 1) % queue->capacity;
     queue->data[queue->rear] = process;
     queue->fill++;
 }
 
 Process dequeue(CircularQueue *queue) {
+    STAT_INC(dequeues);
     if (isEmpty(queue)) {
         fprintf(stderr, "Error: queue is empty, cannot dequeue.\n");
     } else {
         Process process = queue->data[queue->front];
-        queue->front = (queue->front + 1) % MAX_PROCESSES;
+        queue->front = (queue->front + 1) % queue->capacity;
         queue->fill--;
 
         if (queue->fill == 0) {
@@ -118,29 +127,29 @@ Process dequeue(CircularQueue *queue) {
 /    - No known bugs at this time
 /
 ------------------------------------------------------------------------*/
-void display_queue(CircularQueue *queue) {
+void display_queue(CircularQueue *queue, FILE *fp) {
 
-    fprintf(stdout, "[");
+    fprintf(fp, "[");
     if (!isEmpty(queue)) {
         for (int i = 0; i < queue->fill; i++) {
             if (i > 0 && i % 8 == 0) {
                 // print empty row to wrap queue when getting too long
-                printf("\n| %-8s| %-20s| ", "", "");
+                fprintf(fp, "\n| %-8s| %-20s| ", "", "");
             }
-            int index = (queue->front + i) % MAX_PROCESSES;
-            fprintf(stdout, "P%s", queue->data[index].id); // Add "P" before the process ID
-            if (i < queue->fill - 1) fprintf(stdout, ", ");
+            int index = (queue->front + i) % queue->capacity;
+            fprintf(fp, "P%s", queue->data[index].id); // Add "P" before the process ID
+            if (i < queue->fill - 1) fprintf(fp, ", ");
         }
     }
-    fprintf(stdout, "]");
+    fprintf(fp, "]");
 }
 
 /*---------- FUNCTION: sort_queue -------------------------------------
 /  Function Description:
 /    Sorts the elements in a circular queue using a comparison function. 
-/    The function extracts all elements from the circular queue, sorts 
-/    them in a temporary array, and then reinserts them back into the 
-/    queue in sorted order.
+/    If the queue wraps around the end of its array, the array is first
+/    rotated so that the queue starts at the beginning; the elements 
+/    are then sorted where they are.
 /  
 /  Caller Input:
 /    - CircularQueue *queue: Pointer to the circular queue to be sorted.
@@ -156,25 +165,45 @@ void display_queue(CircularQueue *queue) {
 /
 ------------------------------------------------------------------------*/
 void sort_queue(CircularQueue *queue, int (*compare)(const void *, const void *)) {
+    STAT_INC(sorts);
     if (queue->fill <= 1) return; 
-
-    Process temp_array[MAX_PROCESSES];
-    int index = queue->front;
-    for (int i = 0; i < queue->fill; i++) {
-        temp_array[i] = queue->data[index];
-        index = (index + 1) % MAX_PROCESSES; 
+    STAT_ADD(sort_moves, 2 * queue->fill);
+
+    if (queue->front + queue->fill > queue->capacity) {
+        /* rotate left by front: reverse both parts, then the whole */
+        reverse_processes(queue->data, queue->front);
+        reverse_processes(queue->data + queue->front, queue->capacity - queue->front);
+        reverse_processes(queue->data, queue->capacity);
+        queue->front = 0;
+        queue->rear = queue->fill - 1;
     }
 
-    
-    qsort(temp_array, queue->fill, sizeof(Process), compare);
-
+    qsort(&queue->data[queue->front], queue->fill, sizeof(Process), compare);
+}
 
-    for (int i = 0; i < queue->fill; i++) {
-        queue->data[(queue->front + i) % MAX_PROCESSES] = temp_array[i];
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION: reverse_processes ------------------
+/  Function Description:
+/    Reverses the order of count processes in place.
+/
+/  Caller Input:
+/    - Process *data: the first process
+/    - int count: how many to reverse
+/
+/  Caller Output:
+/    N/A - No return value.
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void reverse_processes(Process *data, int count) {
+    for (int i = 0, j = count - 1; i < j; i++, j--) {
+        Process temp = data[i];
+        data[i] = data[j];
+        data[j] = temp;
     }
 }
 
-/*---------- Helper Functions Not Used Outside Module ------------------------*/
 
 void circ_queue_test_1() {
 
@@ -187,8 +216,9 @@ void circ_queue_test_1() {
         init_process(&processes[i], i + 1);
     }
 
+    Process queue_data[MAX_PROCESSES];
     CircularQueue ready_queue;
-    init_queue(&ready_queue);
+    init_queue(&ready_queue, queue_data, MAX_PROCESSES);
 
 
     /* check if empty and/or full */
@@ -226,7 +256,7 @@ void circ_queue_test_1() {
     printf("Enqueuing an item.\n");
     enqueue(&ready_queue, processes[MAX_PROCESSES - 1]);
     printf("Displaying current queue: ");
-    display_queue(&ready_queue);
+    display_queue(&ready_queue, fp);
     printf("\n\n");
     
     /* check if empty and/or full */
@@ -240,7 +270,7 @@ void circ_queue_test_1() {
     printf("Enqueuing out of top bound.\n");
     enqueue(&ready_queue, processes[MAX_PROCESSES]);
     printf("Displaying current queue: ");
-    display_queue(&ready_queue);
+    display_queue(&ready_queue, fp);
     printf("\n\n");
 
     /* peek at front and rear */
@@ -252,7 +282,7 @@ void circ_queue_test_1() {
         printf("Dequeuing an item.\n");
         dequeue(&ready_queue);
         printf("Displaying current queue: ");
-        display_queue(&ready_queue);
+        display_queue(&ready_queue, fp);
         printf("\n\n");
         /* peek at front and rear */
         peek_front(&ready_queue);
@@ -292,4 +322,5 @@ void init_process(Process *process, int proc_id) {
     process->turnaround_time = 0;   
     process->waiting_time = 0;
     process->response_time = -1;
+    process->index = proc_id - 1;
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #define CIRCULAR_QUEUE_H
 
 #include "globals.h"
+#include <stdio.h>
 #include "process.h"
 
 /*---------- STRUCTURE: CircularQueue ----------------------
@@ -21,8 +22,11 @@
 /    the process scheduling algorithms. 
 /  
 /  Members:
-/    Process data[MAX_PROCESSES]
-/      The contents of the queue: an array of Process structs
+/    Process *data
+/      The contents of the queue: an array of Process structs, 
+/      given by the caller
+/    int capacity
+/      Number of Process structs data has room for
 /    int front
 /      represents the index of the front end of the queue 
 /    int rear
@@ -34,18 +38,19 @@
 /    - contains an array of Process structs 
 /---------------------------------------------------------*/
 typedef struct {
-    Process data[MAX_PROCESSES];
+    Process *data;
+    int capacity;
     int front;
     int rear;
     int fill;
 } CircularQueue;
 
-void init_queue(CircularQueue *queue);
+void init_queue(CircularQueue *queue, Process *data, int capacity);
 int isEmpty(CircularQueue *queue);
 int isFull(CircularQueue *queue);
 void enqueue(CircularQueue *queue, Process process);
 Process dequeue(CircularQueue *queue);
-void display_queue(CircularQueue *queue);
+void display_queue(CircularQueue *queue, FILE *fp);
 void sort_queue(CircularQueue *queue, int (*compare)(const void *, const void *));
 
 #endif
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "process.h"
 #include "scheduling.h"
 #include "globals.h"
+#include "stats.h"
 
 /*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
 /  Functions Overview:
@@ -37,7 +38,8 @@
 /      are cast to Process* to perform the comparison.
 /  
 /  Output:
-/    - Each comparison function returns an integer value:
+/    - Each comparison function returns an integer value (values are 
+/      compared rather than subtracted, so 64-bit times cannot overflow):
 /        * < 0: Indicates the first process is "less than" the second 
 /        * 0: Indicates both processes are "equal" with respect to the 
 /          comparison criteria.
@@ -50,60 +52,74 @@
 / 
 /------------------------------------------------------------------------*/
 int compare_arrival(const void *a, const void *b) {
+    STAT_INC(comparisons);
     Process *process_a = (Process *)a;
     Process *process_b = (Process *)b;
     
-    return process_a->arrival_time - process_b->arrival_time;
+    return (process_a->arrival_time > process_b->arrival_time) -
+           (process_a->arrival_time < process_b->arrival_time);
 }
 
 int compare_burst(const void *a, const void *b) {
+    STAT_INC(comparisons);
     Process *process_a = (Process *)a;
     Process *process_b = (Process *)b;
 
     if (process_a->burst_time != process_b->burst_time) {
-        return process_a->burst_time - process_b->burst_time;
+        return (process_a->burst_time > process_b->burst_time) -
+               (process_a->burst_time < process_b->burst_time);
     }
 
     
-    return process_a->arrival_time - process_b->arrival_time;
+    return (process_a->arrival_time > process_b->arrival_time) -
+           (process_a->arrival_time < process_b->arrival_time);
 }
 
 int compare_completion(const void *a, const void *b) {
+    STAT_INC(comparisons);
     Process *process_a = (Process *)a;
     Process *process_b = (Process *)b;
-    return process_a->completion_time - process_b->completion_time;
+    return (process_a->completion_time > process_b->completion_time) -
+           (process_a->completion_time < process_b->completion_time);
 }
 
 int compare_priority(const void *a, const void *b) {
+    STAT_INC(comparisons);
     Process *process_a = (Process *)a;
     Process *process_b = (Process *)b;
 
     if (process_a->priority != process_b->priority) {
-        return process_a->priority - process_b->priority;
+        return (process_a->priority > process_b->priority) -
+               (process_a->priority < process_b->priority);
     }
 
     
-    return process_a->arrival_time - process_b->arrival_time;
+    return (process_a->arrival_time > process_b->arrival_time) -
+           (process_a->arrival_time < process_b->arrival_time);
 }
 
 int compare_pid(const void *a, const void *b) {
+    STAT_INC(comparisons);
     Process *process1 = (Process *)a;
     Process *process2 = (Process *)b;
 
-    int pid1 = atoi(process1->id);
-    int pid2 = atoi(process2->id);
+    long long pid1 = atoll(process1->id);
+    long long pid2 = atoll(process2->id);
 
-    return pid1 - pid2;
+    return (pid1 > pid2) - (pid1 < pid2);
 }
 
 int compare_remaining(const void *a, const void *b) {
+    STAT_INC(comparisons);
     Process *process_a = (Process *)a;
     Process *process_b = (Process *)b;
 
     if (process_a->remaining_time != process_b->remaining_time) {
-        return process_a->remaining_time - process_b->remaining_time;
+        return (process_a->remaining_time > process_b->remaining_time) -
+               (process_a->remaining_time < process_b->remaining_time);
     }
 
     
-    return process_a->arrival_time - process_b->arrival_time;
+    return (process_a->arrival_time > process_b->arrival_time) -
+           (process_a->arrival_time < process_b->arrival_time);
 }
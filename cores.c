@@ -0,0 +1,360 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   cores.c
+/
+/  File Description:
+/    This file describes the cores of a multi-core run and decides
+/    which core a process is placed on. Cores may differ in speed, as
+/    the big and LITTLE cores of a heterogeneous CPU do: a process
+/    makes speed units of progress per time unit on a core, so a burst
+/    of B takes B / speed. Time stays in whole units, so a burst that
+/    would end partway through a time unit completes at the end of it,
+/    and a process switched away partway through one keeps only the
+/    whole units of work it did.
+/
+/    The placement policies are:
+/      fastest  a process goes to the fastest idle core
+/      energy   a process goes to the slowest idle core, so the big
+/               cores are only used once the LITTLE ones are all busy
+/      big      as fastest, and whenever a faster core is left idle,
+/               the process on the slowest busy core moves up to it
+/    Among idle cores of the same speed, the one the process last ran
+/    on is preferred, so that it is not moved needlessly. Only
+/    processes on one core are moved up.
+/
+/    A multi-threaded process (a job) may have to be co-scheduled: 
+/      strict    all its threads start at once, each on its own core,
+/                and until enough cores are idle every process behind
+/                it in the ready queue waits too
+/      backfill  as strict, except that a process behind it may start
+/                in the idle cores if it will be done before enough
+/                cores free up for the first, or leaves enough idle
+/                then (EASY backfilling)
+/      relaxed   it starts on as many idle cores as there are, up to
+/                one per thread, and threads without a core of their 
+/                own share one, so it runs slower
+/
+/    Energy is estimated from the usual model of dynamic power, which
+/    grows with the frequency times the square of the voltage, the
+/    voltage being scaled with the frequency: a core at speed s draws
+/    s^3 per time unit busy, relative to a core at speed 1. Idle cores
+/    are taken to draw nothing.
+/
+/  Citations:
+/  - Ousterhout, "Scheduling Techniques for Concurrent Systems", 
+/    ICDCS 3, 1982
+/  - Feitelson and Rudolph, "Gang Scheduling Performance Benefits for 
+/    Fine-Grain Synchronization", Journal of Parallel and Distributed 
+/    Computing 16(4), 1992
+/  - Lifka, "The ANL/IBM SP Scheduling System", JSSPP, 1995
+/  - Kumar et al., "Single-ISA Heterogeneous Multi-Core Architectures:
+/    The Potential for Processor Power Reduction", MICRO-36, 2003
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include "process.h"
+#include "cores.h"
+
+int core_class_first(const CoreSet *set, int cls);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: init_core_set -----------------------
+/  Function Description:
+/    Sets up no cores, so that runs use the single-CPU simulators,
+/    with the fastest placement and no co-scheduling should cores be 
+/    given later.
+/
+/  Caller Input:
+/    CoreSet *set: the set to initialize
+/
+/  Caller Output:
+/    N/A - No return value
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void init_core_set(CoreSet *set) {
+    memset(set, 0, sizeof(CoreSet));
+    set->placement = PLACE_FASTEST;
+    set->gang = GANG_NONE;
+}
+
+/*---------- FUNCTION: parse_core_set ----------------------
+/  Function Description:
+/    Reads the cores as given with --cores: comma-separated groups of
+/    "count[xspeed]", the speed defaulting to 1. Groups of the same
+/    speed are merged into one class, and the classes are ordered
+/    fastest first. The placement and gang mode are left as they 
+/    were.
+/
+/  Caller Input:
+/    const char *spec: the cores, e.g. "4x1,4x0.5"
+/    CoreSet *set: filled in
+/
+/  Caller Output:
+/    0 on success, 1 if a count is not a positive integer, a speed is
+/    not a positive number, or there are more than MAX_CORES cores or
+/    MAX_CORE_CLASSES speeds
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - speeds are limited to 0.01 through 100
+/---------------------------------------------------------*/
+int parse_core_set(const char *spec, CoreSet *set) {
+    char copy[128];
+    char *group;
+    char *end;
+    int placement = set->placement;
+    int gang = set->gang;
+
+    init_core_set(set);
+    set->placement = placement;
+    set->gang = gang;
+    snprintf(copy, sizeof(copy), "%s", spec);
+
+    for (group = strtok(copy, ","); group != NULL; group = strtok(NULL, ",")) {
+        long count = strtol(group, &end, 10);
+        double speed = 1;
+        int cls;
+
+        if (end == group || count < 1 || count > MAX_CORES) return 1;
+        if (*end == 'x' || *end == 'X') {
+            const char *factor = end + 1;
+
+            speed = strtod(factor, &end);
+            if (end == factor) return 1;
+        }
+        if (*end != '\0' || !(speed >= 0.01 && speed <= 100)) return 1;
+        if (set->num_cores + count > MAX_CORES) return 1;
+
+        for (cls = 0; cls < set->num_classes && set->speed[cls] != speed; cls++);
+        if (cls == set->num_classes) {
+            if (cls == MAX_CORE_CLASSES) return 1;
+            set->num_classes++;
+            set->speed[cls] = speed;
+            set->count[cls] = 0;
+        }
+        set->count[cls] += (int)count;
+        set->num_cores += (int)count;
+    }
+    if (set->num_cores == 0) return 1;
+
+    /* fastest first */
+    for (int i = 1; i < set->num_classes; i++) {
+        double speed = set->speed[i];
+        int count = set->count[i];
+        int j = i;
+
+        for (; j > 0 && set->speed[j - 1] < speed; j--) {
+            set->speed[j] = set->speed[j - 1];
+            set->count[j] = set->count[j - 1];
+        }
+        set->speed[j] = speed;
+        set->count[j] = count;
+    }
+    return 0;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions translate between placement policies and gang 
+/    modes and their names, as used with --placement and --gang.
+/
+/  Functions and Their Purpose:
+/    - placement_policy: The PLACE_* policy of a name, or -1 if it is
+/      not one (case-insensitive).
+/    - placement_name: The name of a PLACE_* policy.
+/    - gang_mode: The GANG_* mode of a name other than none, or -1 if 
+/      it is not one (case-insensitive).
+/    - gang_mode_name: The name of a GANG_* mode.
+/
+/  Input Parameters:
+/    - const char *name: fastest, energy or big; strict, backfill or
+/      relaxed
+/    - int placement: PLACE_*
+/    - int mode: GANG_*
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+int placement_policy(const char *name) {
+    if (strcasecmp(name, "fastest") == 0) return PLACE_FASTEST;
+    if (strcasecmp(name, "energy") == 0) return PLACE_ENERGY;
+    if (strcasecmp(name, "big") == 0) return PLACE_BIG;
+    return -1;
+}
+
+const char *placement_name(int placement) {
+    switch (placement) {
+        case PLACE_ENERGY: return "energy";
+        case PLACE_BIG: return "big";
+        default: return "fastest";
+    }
+}
+
+int gang_mode(const char *name) {
+    if (strcasecmp(name, "strict") == 0) return GANG_STRICT;
+    if (strcasecmp(name, "backfill") == 0) return GANG_BACKFILL;
+    if (strcasecmp(name, "relaxed") == 0) return GANG_RELAXED;
+    return -1;
+}
+
+const char *gang_mode_name(int mode) {
+    switch (mode) {
+        case GANG_STRICT: return "strict";
+        case GANG_BACKFILL: return "backfill";
+        case GANG_RELAXED: return "relaxed";
+        default: return "none";
+    }
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions place processes on the cores of a run.
+/
+/  Functions and Their Purpose:
+/    - cores_init: Sets up one Core per core of the set, all idle.
+/    - core_pick: The idle core the set's placement puts a process
+/      on, given the core it last ran on (or -1); -1 if every core is
+/      busy.
+/    - core_promote: Under the big placement, the busy core whose
+/      process should move up to a faster idle core, or -1 if none
+/      should; the faster core is returned through to. Processes on
+/      several cores stay where they are.
+/
+/  Input Parameters:
+/    - const CoreSet *set: the cores and placement
+/    - Core cores[]: one per core, in the set's order
+/    - int previous: the core a process last ran on, or -1
+/    - int *to: set to the core to move to
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - each call scans the cores, which suits the tens of cores of a
+/      real machine
+/------------------------------------------------------------------------*/
+void cores_init(const CoreSet *set, Core cores[]) {
+    int c = 0;
+
+    for (int cls = 0; cls < set->num_classes; cls++) {
+        for (int k = 0; k < set->count[cls]; k++, c++) {
+            memset(&cores[c], 0, sizeof(Core));
+            cores[c].speed = set->speed[cls];
+            cores[c].cls = cls;
+            cores[c].lead = -1;
+            cores[c].last_index = -1;
+        }
+    }
+}
+
+int core_pick(const CoreSet *set, const Core cores[], int previous) {
+    for (int k = 0; k < set->num_classes; k++) {
+        int cls = set->placement == PLACE_ENERGY ? set->num_classes - 1 - k : k;
+        int first = core_class_first(set, cls);
+        int last = first + set->count[cls];
+        int idle = -1;
+
+        if (previous >= first && previous < last && !cores[previous].has_running) {
+            return previous;
+        }
+        for (int c = first; c < last && idle == -1; c++) {
+            if (!cores[c].has_running) idle = c;
+        }
+        if (idle != -1) return idle;
+    }
+    return -1;
+}
+
+int core_promote(const CoreSet *set, const Core cores[], int *to) {
+    int idle = -1;
+
+    if (set->placement != PLACE_BIG) return -1;
+    for (int c = 0; c < set->num_cores && idle == -1; c++) {
+        if (!cores[c].has_running) idle = c;
+    }
+    if (idle == -1) return -1;
+
+    /* the slowest classes are numbered last */
+    for (int c = set->num_cores - 1; c > idle && cores[c].speed < cores[idle].speed; c--) {
+        if (cores[c].has_running && cores[c].lead == c && cores[c].width == 1) {
+            *to = idle;
+            return c;
+        }
+    }
+    return -1;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions convert between work and time on a core.
+/
+/  Functions and Their Purpose:
+/    - core_time: The whole time units a core takes to do work units
+/      of a burst (rounded up), carried of the first already done.
+/    - core_work: The whole units of work a core does in time units
+/      (rounded down), carried of the first already done.
+/    - core_energy: The energy a class of cores used, in time units of
+/      a busy speed-1 core.
+/
+/  Input Parameters:
+/    - long long work: units of burst time
+/    - long long time: time units
+/    - double carried: the part of a unit of work done before, below 1
+/    - double speed: the core's speed factor
+/    - const CoreUsage *usage: the class
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - speed 1 is exact, and a carried part below 1 never adds up to a
+/      unit there; other speeds go through a double, so they are exact
+/      only below 2^53 time units
+/------------------------------------------------------------------------*/
+long long core_time(long long work, double carried, double speed) {
+    if (speed == 1) return work;
+    return (long long)ceil((work - carried) / speed - 1e-9);
+}
+
+long long core_work(long long time, double carried, double speed) {
+    if (speed == 1) return time;
+    return (long long)floor(carried + time * speed + 1e-9);
+}
+
+double core_energy(const CoreUsage *usage) {
+    return usage->busy_time * usage->speed * usage->speed * usage->speed;
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION: core_class_first --------------------
+/  Function Description:
+/    Gives the number of the first core of a class.
+/
+/  Caller Input:
+/    const CoreSet *set: the cores
+/    int cls: the class
+/
+/  Caller Output:
+/    The core number
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+int core_class_first(const CoreSet *set, int cls) {
+    int first = 0;
+
+    for (int k = 0; k < cls; k++) {
+        first += set->count[k];
+    }
+    return first;
+}
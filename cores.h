@@ -0,0 +1,198 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   cores.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef CORES_H
+#define CORES_H
+
+#include "process.h"
+
+#define MAX_CORES 256
+#define MAX_CORE_CLASSES 8
+
+#define PLACE_FASTEST 0
+#define PLACE_ENERGY 1
+#define PLACE_BIG 2
+
+#define GANG_NONE 0
+#define GANG_STRICT 1
+#define GANG_BACKFILL 2
+#define GANG_RELAXED 3
+
+/*---------- STRUCTURE: CoreSet ----------------------------
+/  Structure Description:
+/    The CPUs of a multi-core run, as given with --cores: classes of
+/    identical cores, each with a speed factor (a burst of B takes
+/    B / speed on one of its cores), and the policy that chooses the
+/    core a process is placed on. Cores are numbered fastest class
+/    first.
+/
+/  Fields:
+/    int num_cores
+/      Number of cores, or 0 for the single-CPU simulators
+/    int num_classes
+/      Number of distinct speeds
+/    double speed[MAX_CORE_CLASSES]
+/      Each class's speed factor, fastest first
+/    int count[MAX_CORE_CLASSES]
+/      Each class's number of cores
+/    int placement
+/      PLACE_FASTEST (the fastest idle core), PLACE_ENERGY (the
+/      slowest idle core) or PLACE_BIG (the fastest idle core, and a
+/      process on a slower core moves up to a faster one left idle)
+/    int gang
+/      How the threads of a multi-threaded process are co-scheduled:
+/      GANG_NONE (every process has one thread), GANG_STRICT (all of
+/      them at once, the first ready process blocking the rest until
+/      enough cores are idle), GANG_BACKFILL (as strict, but a later
+/      process may start in the idle cores if that does not delay the 
+/      first) or GANG_RELAXED (on as many idle cores as there are, up
+/      to one per thread, the threads sharing them)
+/
+/  Relationships:
+/    - contained in SimContext
+/---------------------------------------------------------*/
+typedef struct {
+    int num_cores;
+    int num_classes;
+    double speed[MAX_CORE_CLASSES];
+    int count[MAX_CORE_CLASSES];
+    int placement;
+    int gang;
+} CoreSet;
+
+/*---------- STRUCTURE: CoreUsage --------------------------
+/  Structure Description:
+/    What one class of cores did over a multi-core run.
+/
+/  Fields:
+/    double speed
+/      The class's speed factor
+/    int cores
+/      Its number of cores
+/    long long busy_time
+/      Time its cores spent running processes, added over the cores
+/    long long dispatches
+/      Times a process was put on one of its cores
+/    long long started, response_sum
+/      Processes that first ran on the class, and the total of their
+/      response times
+/    long long completed, turnaround_sum
+/      Processes that finished on the class, and the total of their
+/      turnaround times
+/
+/  Relationships:
+/    - contained in SimResult, one per class of the CoreSet
+/---------------------------------------------------------*/
+typedef struct {
+    double speed;
+    int cores;
+    long long busy_time;
+    long long dispatches;
+    long long started;
+    long long response_sum;
+    long long completed;
+    long long turnaround_sum;
+} CoreUsage;
+
+/*---------- STRUCTURE: GangUsage --------------------------
+/  Structure Description:
+/    How the co-scheduling of multi-threaded processes went over a
+/    multi-core run.
+/
+/  Fields:
+/    int mode
+/      The CoreSet's gang mode, GANG_NONE if processes were not
+/      co-scheduled (the other fields are then 0)
+/    long long backfilled
+/      Processes started ahead of the first ready one (GANG_BACKFILL)
+/    long long fragmentation_time
+/      Core time left idle while processes were waiting, added over
+/      the cores
+/    double slowdown_mean, slowdown_max
+/      Mean and largest slowdown: a process's turnaround time over the
+/      time its burst takes on the fastest cores (at least 1)
+/
+/  Relationships:
+/    - contained in SimResult
+/---------------------------------------------------------*/
+typedef struct {
+    int mode;
+    long long backfilled;
+    long long fragmentation_time;
+    double slowdown_mean;
+    double slowdown_max;
+} GangUsage;
+
+/*---------- STRUCTURE: Core -------------------------------
+/  Structure Description:
+/    One core during a multi-core run. A process's progress is only
+/    worked out when it leaves the core or its time slice is set
+/    again, and the part of a unit of work left over is carried in
+/    the process, so that a slow core's fractions of a time unit are
+/    not lost at every event or every time slice. A process
+/    with several threads runs on several cores at once; the first of
+/    them, its lead core, holds it.
+/
+/  Fields:
+/    double speed
+/      The core's speed factor
+/    int cls
+/      The core's class, an index into the CoreSet
+/    int has_running
+/      1 if a process is on the core
+/    int lead
+/      The lead core of that process, or -1
+/    Process running
+/      The process, its remaining_time as of since (lead core only)
+/    int width
+/      The number of cores it runs on (lead core only)
+/    double rate
+/      The units of its burst it does per time unit: the speed of the 
+/      slowest of its cores, shared between its threads if it has 
+/      fewer cores than threads (lead core only)
+/    long long since
+/      Time at which it was put on the core
+/    long long until
+/      Time at which it will complete, or its time slice end (RR)
+/    int last_index
+/      Index of the process on the core, or -1 once it leaves; set 
+/      ahead for a process that carries on on the core after its time
+/      slice, or moves up to it, so that it is not dispatched again
+/
+/  Relationships:
+/    - an array of them is held by the streaming simulator
+/---------------------------------------------------------*/
+typedef struct {
+    double speed;
+    int cls;
+    int has_running;
+    int lead;
+    Process running;
+    int width;
+    double rate;
+    long long since;
+    long long until;
+    int last_index;
+} Core;
+
+void init_core_set(CoreSet *set);
+int parse_core_set(const char *spec, CoreSet *set);
+int placement_policy(const char *name);
+const char *placement_name(int placement);
+int gang_mode(const char *name);
+const char *gang_mode_name(int mode);
+void cores_init(const CoreSet *set, Core cores[]);
+int core_pick(const CoreSet *set, const Core cores[], int previous);
+int core_promote(const CoreSet *set, const Core cores[], int *to);
+long long core_time(long long work, double carried, double speed);
+long long core_work(long long time, double carried, double speed);
+double core_energy(const CoreUsage *usage);
+
+#endif
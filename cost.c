@@ -0,0 +1,151 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   cost.c
+/
+/  File Description:
+/    This file implements the scheduler-decision cost model. The
+/    simulators treat choosing the next process as free; with a model
+/    set, each choice is charged the time a scheduler keeping its
+/    ready queue in the given structure would take, which grows with
+/    the queue:
+/
+/      list    base + per * n           (scan every ready process)
+/      heap    base + per * log2(n + 1) (sift down from the root)
+/      tree    base + per * 2 log2(n + 1)
+/                                        (remove the leftmost node,
+/                                         insert the preempted one)
+/      bitmap  base + per                (find the first set bit, pop
+/                                         that priority's queue)
+/
+/    The cost of a decision is in time units and usually a fraction
+/    of one; the simulator carries the fractions over, so that the
+/    time it charges adds up to the model's total.
+/
+/  Citations:
+/  - Molnar, "Design of the O(1) scheduler" (Linux 2.6, sched-design.txt)
+/  - Linux kernel documentation, "CFS Scheduler" (scheduler/sched-design-CFS.rst)
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include "cost.h"
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: init_decision_cost ------------------
+/  Function Description:
+/    Turns the cost model off, with the default constants should one
+/    be chosen later.
+/
+/  Caller Input:
+/    DecisionCost *cost: the model to initialize
+/
+/  Caller Output:
+/    N/A - No return value
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void init_decision_cost(DecisionCost *cost) {
+    cost->model = COST_NONE;
+    cost->base = COST_DEFAULT_BASE;
+    cost->per = COST_DEFAULT_PER;
+}
+
+/*---------- FUNCTION: parse_decision_cost -----------------
+/  Function Description:
+/    Reads a cost model as given with --decision-cost:
+/    "model[,base[,per]]", where model is list, heap, tree or bitmap.
+/
+/  Caller Input:
+/    const char *spec: the model
+/    DecisionCost *cost: filled in
+/
+/  Caller Output:
+/    0 on success, 1 if the model is not recognized or a constant is
+/    not a non-negative number
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - constants not given keep their defaults
+/---------------------------------------------------------*/
+int parse_decision_cost(const char *spec, DecisionCost *cost) {
+    static const char *names[] = {"list", "heap", "tree", "bitmap"};
+    char copy[64];
+    char *field;
+    char *end;
+
+    init_decision_cost(cost);
+    snprintf(copy, sizeof(copy), "%s", spec);
+
+    field = strtok(copy, ",");
+    if (field == NULL) return 1;
+    for (int m = 0; m < 4; m++) {
+        if (strcasecmp(field, names[m]) == 0) cost->model = COST_LIST + m;
+    }
+    if (cost->model == COST_NONE) return 1;
+
+    field = strtok(NULL, ",");
+    if (field != NULL) {
+        cost->base = strtod(field, &end);
+        if (*end != '\0' || cost->base < 0) return 1;
+        field = strtok(NULL, ",");
+    }
+    if (field != NULL) {
+        cost->per = strtod(field, &end);
+        if (*end != '\0' || cost->per < 0) return 1;
+        field = strtok(NULL, ",");
+    }
+    return field != NULL;
+}
+
+/*---------- FUNCTION: decision_cost -----------------------
+/  Function Description:
+/    Gives the time one scheduling decision takes under a model.
+/
+/  Caller Input:
+/    const DecisionCost *cost: the model
+/    long long ready: the number of processes the decision is made
+/      between (the ready queue, including any process that was just
+/      preempted)
+/
+/  Caller Output:
+/    The decision's cost in time units, 0 if the model is off
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+double decision_cost(const DecisionCost *cost, long long ready) {
+    switch (cost->model) {
+        case COST_LIST: return cost->base + cost->per * ready;
+        case COST_HEAP: return cost->base + cost->per * log2((double)ready + 1);
+        case COST_TREE: return cost->base + cost->per * 2 * log2((double)ready + 1);
+        case COST_BITMAP: return cost->base + cost->per;
+        default: return 0;
+    }
+}
+
+/*---------- FUNCTION: decision_model_name -----------------
+/  Function Description:
+/    Gives the name of a cost model, as used with --decision-cost.
+/
+/  Caller Input:
+/    int model: COST_*
+/
+/  Caller Output:
+/    The name, or "none"
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+const char *decision_model_name(int model) {
+    switch (model) {
+        case COST_LIST: return "list";
+        case COST_HEAP: return "heap";
+        case COST_TREE: return "tree";
+        case COST_BITMAP: return "bitmap";
+        default: return "none";
+    }
+}
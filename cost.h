@@ -0,0 +1,56 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   cost.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef COST_H
+#define COST_H
+
+#define COST_NONE 0
+#define COST_LIST 1
+#define COST_HEAP 2
+#define COST_TREE 3
+#define COST_BITMAP 4
+
+#define COST_DEFAULT_BASE 0.05
+#define COST_DEFAULT_PER 0.005
+
+/*---------- STRUCTURE: DecisionCost -----------------------
+/  Structure Description:
+/    A model of what the scheduler itself costs: the CPU time taken
+/    by each decision of which process to run next, as a function of
+/    the number of processes it chooses between and of the data
+/    structure its ready queue is kept in.
+/
+/  Fields:
+/    int model
+/      COST_NONE (decisions are free), COST_LIST (a scan of an
+/      unordered list), COST_HEAP (a binary heap), COST_TREE (a
+/      balanced search tree) or COST_BITMAP (an array of per-priority
+/      queues found with a bitmap)
+/    double base
+/      Time units every decision costs
+/    double per
+/      Time units per step of the data structure: per process for a
+/      list, per level for a heap or tree
+/
+/  Relationships:
+/    - contained in SimContext
+/---------------------------------------------------------*/
+typedef struct {
+    int model;
+    double base;
+    double per;
+} DecisionCost;
+
+void init_decision_cost(DecisionCost *cost);
+int parse_decision_cost(const char *spec, DecisionCost *cost);
+double decision_cost(const DecisionCost *cost, long long ready);
+const char *decision_model_name(int model);
+
+#endif
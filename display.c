@@ -13,368 +13,1012 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <unistd.h>
 #include "process.h"
 #include "scheduling.h"
 #include "globals.h"
 #include "circular_queue.h"
 #include "ansi_esc_seqs.h"
-#include "options.h"
+#include "simulator.h"
 #include "compare.h"
+#include "timeline.h"
+#include "arena.h"
+#include "ensemble.h"
+#include "sweep.h"
+#include "histogram.h"
+#include "report.h"
+#include "import.h"
+#include "display.h"
+
+void display_percentile_table(FILE *out, LatencyHistograms *latency);
+void display_switches(FILE *out, SwitchCounts *switches);
+void display_core_classes(FILE *out, SimResult *result);
+void display_groups(FILE *out, const GroupTree *groups, long long end_time);
+void display_percentile_row(FILE *out, const char *name, Histogram *hist);
+int compare_gantt_row(const void *a, const void *b);
+void display_gantt_release(Timeline *timeline, int *row_of, int *row_first, int *row_next, int *row_block,
+                           int *active, Segment **by_row, char *cells, char *line);
 
 /*---------- FUNCTION: display_metrics --------------------------------
 /  Function Description:
-/    Calculates and displays scheduling metrics for a set of processes,
-/    including average waiting time, turnaround time, response time, 
-/    CPU utilization, and throughput. Outputs detailed per-process 
-/    metrics and overall metrics to a file or standard output.
+/    Displays scheduling metrics for a set of processes, including 
+/    average waiting time, turnaround time, response time, CPU 
+/    utilization, and throughput. Outputs detailed per-process 
+/    metrics and overall metrics to the given stream.
 /  
 /  Caller Input:
+/    - FILE *out: The stream to write to.
 /    - Process processes[]: Array of processes with completed metrics
 /    - int num_processes: Total number of processes in the array.
-/    - int idle_time: Total idle time of the CPU during the simulation.
-/    - int current_time: Total time elapsed in the simulation (completion time).
+/    - SimResult *result: The run's summary metrics, as filled in by 
+/      calculate_results.
 /  
 /  Caller Output:
-/    N/A - No return value. Results are written to the provided file or 
-/          standard output.
+/    N/A - No return value. Results are written to out.
 /  
 /  Assumptions, Limitations, Known Bugs:
 /    -
 /
 ------------------------------------------------------------------------*/
-void display_metrics(Process processes[], int num_processes, int idle_time, int current_time) {
-    int total_waiting = 0;
-    int total_turnaround = 0;
-    int total_response = 0; 
-    int total_completion = current_time;
-
+void display_metrics(FILE *out, Process processes[], int num_processes, SimResult *result) {
     for (int i = 0; i < num_processes; i++) {
-        fprintf(stdout, "Metrics for P%s: Turnaround= %d, Waiting= %d, Response= %d\n",
+        fprintf(out, "Metrics for P%s: Turnaround= %lld, Waiting= %lld, Response= %lld\n",
                 processes[i].id,
                 processes[i].turnaround_time,
                 processes[i].waiting_time,
                 processes[i].response_time);
     }
 
-    for (int i = 0; i < num_processes; i++) {
-        total_waiting += processes[i].waiting_time;
-        total_turnaround += processes[i].turnaround_time;
-        total_response += processes[i].response_time;
-    }
-
-    float avg_waiting = (float)total_waiting / num_processes;
-    float avg_turnaround = (float)total_turnaround / num_processes;
-    float avg_response = (float)total_response / num_processes; 
-    float throughput = (float)num_processes / total_completion;
-    float cpu_utilization = (total_completion - idle_time) / (float)total_completion * 100;
-
-    fprintf(stdout, "\nMetrics Summary:\n");
-    fprintf(stdout, "Average Waiting Time: %.2f\n", avg_waiting);
-    fprintf(stdout, "Average Turnaround Time: %.2f\n", avg_turnaround);
-    fprintf(stdout, "Average Response Time: %.2f\n", avg_response);
-    fprintf(stdout, "Throughput: %.2f processes per time unit\n", throughput);
-    fprintf(stdout, "CPU Utilization: %.2f%%\n", cpu_utilization);
+    fprintf(out, "\nMetrics Summary:\n");
+    fprintf(out, "Average Waiting Time: %.2f\n", result->waiting.mean);
+    fprintf(out, "Average Turnaround Time: %.2f\n", result->turnaround.mean);
+    fprintf(out, "Average Response Time: %.2f\n", result->response.mean);
+    fprintf(out, "Throughput: %.2f processes per time unit\n", result->throughput);
+    fprintf(out, "CPU Utilization: %.2f%%\n", result->cpu_utilization);
 }
 
 
 /*---------- FUNCTION: display_metrics_table ---------------
 /  Function Description:
-/    Calculates and displays scheduling metrics for a set of processes,
-/    including average waiting time, turnaround time, response time, 
-/    CPU utilization, and throughput. Outputs detailed per-process 
-/    metrics and overall metrics to a file or standard output. Formats 
-/    the display as a table to assist with readability. 
+/    Displays scheduling metrics for a set of processes, including 
+/    average waiting time, turnaround time, response time, CPU 
+/    utilization, and throughput. Outputs detailed per-process 
+/    metrics and overall metrics to the given stream. Formats the 
+/    display as a table to assist with readability. Each process's 
+/    dispatches, preemptions and time slice expirations are given 
+/    with its metrics, and their totals with the summary. 
 /  
 /  Caller Input:
+/    - FILE *out: The stream to write to.
 /    - Process processes[]: Array of processes with completed metrics
 /    - int num_processes: Total number of processes in the array.
-/    - int idle_time: Total idle time of the CPU during the simulation.
-/    - int current_time: Total time elapsed in the simulation (completion time).
+/    - SimResult *result: The run's summary metrics, including the 
+/      latency distributions used to report the p50/p90/p99/p99.9 
+/      tail latencies.
 /  
 /  Caller Output:
-/    N/A - No return value. Results are written to the provided file or 
-/          standard output.
+/    N/A - No return value. Results are written to out.
 /  
 /  Assumptions, Limitations, Known Bugs:
-/    -
+/    - percentiles are read from the histograms, so above 128 time units 
+/      they are accurate to within 1.6%
 /---------------------------------------------------------*/
-void display_metrics_table(Process processes[], int num_processes, int idle_time, int current_time) {
-    int total_waiting = 0;
-    int total_turnaround = 0;
-    int total_response = 0; 
-    int total_completion = current_time;
+void display_metrics_table(FILE *out, Process processes[], int num_processes, SimResult *result) {
     char pid[11];
 
     qsort(processes, num_processes, sizeof(Process), compare_pid); 
 
-    fprintf(stdout, "Table of Metrics Values:");
-    fprintf(stdout, "\n+-------+-------+-------+-------+\n");
-    fprintf(stdout, "|  PID  | Turn. | Wait. | Resp. |");
-    fprintf(stdout, "\n+-------+-------+-------+-------+\n");
+    fprintf(out, "Table of Metrics Values:");
+    fprintf(out, "\n+-------+-------+-------+-------+-------+-------+-------+\n");
+    fprintf(out, "|  PID  | Turn. | Wait. | Resp. | Disp. | Pre.  | Exp.  |");
+    fprintf(out, "\n+-------+-------+-------+-------+-------+-------+-------+\n");
     for (int i = 0; i < num_processes; i++) {
         sprintf(pid, "P%s", processes[i].id);
-        fprintf(stdout, "|  %3s  |   %2d  |   %2d  |   %2d  |\n",
+        fprintf(out, "|  %3s  |   %2lld  |   %2lld  |   %2lld  |   %2d  |   %2d  |   %2d  |\n",
                 pid,
                 processes[i].turnaround_time,
                 processes[i].waiting_time,
-                processes[i].response_time);
-        fprintf(stdout, "+-------+-------+-------+-------+\n");
+                processes[i].response_time,
+                processes[i].dispatches,
+                processes[i].preemptions,
+                processes[i].expirations);
+        fprintf(out, "+-------+-------+-------+-------+-------+-------+-------+\n");
     }
 
-    for (int i = 0; i < num_processes; i++) {
-        total_waiting += processes[i].waiting_time;
-        total_turnaround += processes[i].turnaround_time;
-        total_response += processes[i].response_time;
-    }
-
-    float avg_waiting = (float)total_waiting / num_processes;
-    float avg_turnaround = (float)total_turnaround / num_processes;
-    float avg_response = (float)total_response / num_processes; 
-    float throughput = (float)num_processes / total_completion;
-    float cpu_utilization = (total_completion - idle_time) / (float)total_completion * 100;
-
-    fprintf(stdout, "\nMetrics Summary:\n");
-    fprintf(stdout, "Average Waiting Time:\n\t%.2f\n", avg_waiting);
-    fprintf(stdout, "Average Turnaround Time:\n\t%.2f\n", avg_turnaround);
-    fprintf(stdout, "Average Response Time:\n\t%.2f\n", avg_response);
-    fprintf(stdout, "Throughput:\n\t%.2f processes per time unit\n", throughput);
-    fprintf(stdout, "CPU Utilization:\n\t%.2f%%\n", cpu_utilization);
+    fprintf(out, "\nMetrics Summary:\n");
+    fprintf(out, "Average Waiting Time:\n\t%.2f\n", result->waiting.mean);
+    fprintf(out, "Average Turnaround Time:\n\t%.2f\n", result->turnaround.mean);
+    fprintf(out, "Average Response Time:\n\t%.2f\n", result->response.mean);
+    fprintf(out, "Throughput:\n\t%.2f processes per time unit\n", result->throughput);
+    fprintf(out, "CPU Utilization:\n\t%.2f%%\n", result->cpu_utilization);
+    display_switches(out, &result->switches);
+
+    display_percentile_table(out, &result->latency);
+}
+
+/*---------- FUNCTION: display_switches --------------------
+/  Function Description:
+/    Prints the number of dispatches of a run, and how they ended.
+/  
+/  Caller Input:
+/    - FILE *out: The stream to write to.
+/    - SwitchCounts *switches: The run's totals.
+/  
+/  Caller Output:
+/    N/A - No return value. The line is written to out.
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void display_switches(FILE *out, SwitchCounts *switches) {
+    fprintf(out, "Dispatches:\n\t%lld (%lld completed, %lld preempted, %lld time slices expired)\n",
+            switches->dispatches,
+            switches->completions,
+            switches->preemptions,
+            switches->expirations);
+}
+
+/*---------- FUNCTION: display_core_classes ----------------
+/  Function Description:
+/    Prints the migrations of a multi-core run, with a gang mode its
+/    backfills, fragmentation (core time left idle while processes 
+/    waited) and slowdown, and then a table of its core classes:
+/    each one's speed and cores, their busy time and utilization,
+/    dispatches, the processes that first ran on them and their mean
+/    response time, the processes that completed on them and their
+/    mean turnaround time, and the energy they used.
+/  
+/  Caller Input:
+/    - FILE *out: The stream to write to.
+/    - SimResult *result: The run's summary metrics, with its classes.
+/  
+/  Caller Output:
+/    N/A - No return value. The table is written to out.
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    - energy is in time units of a busy speed-1 core (see cores.c)
+/---------------------------------------------------------*/
+void display_core_classes(FILE *out, SimResult *result) {
+    fprintf(out, "Migrations:\n\t%lld\n", result->switches.migrations);
+    if (result->gang.mode != GANG_NONE) {
+        double capacity = 0;
+
+        for (int cls = 0; cls < result->num_classes; cls++) {
+            capacity += (double)result->classes[cls].cores * result->current_time;
+        }
+        fprintf(out, "Gang Scheduling (%s):\n\t%lld backfilled, %lld core time fragmented (%.2f%% of the cores)\n",
+                gang_mode_name(result->gang.mode), result->gang.backfilled, result->gang.fragmentation_time,
+                capacity > 0 ? result->gang.fragmentation_time * 100.0 / capacity : 0.0);
+        fprintf(out, "Average Slowdown:\n\t%.2f (max %.2f)\n", result->gang.slowdown_mean, result->gang.slowdown_max);
+    }
+    fprintf(out, "Core Classes:\n");
+    fprintf(out, "+--------+-------+--------------+---------+------------+------------+------------+------------+------------+--------------+\n");
+    fprintf(out, "| %6s | %5s | %12s | %7s | %10s | %10s | %10s | %10s | %10s | %12s |\n",
+            "Speed", "Cores", "Busy", "Util.", "Disp.", "Started", "Avg. Resp.", "Completed", "Avg. Turn.", "Energy");
+    fprintf(out, "+--------+-------+--------------+---------+------------+------------+------------+------------+------------+--------------+\n");
+    for (int cls = 0; cls < result->num_classes; cls++) {
+        CoreUsage *usage = &result->classes[cls];
+        double capacity = (double)usage->cores * result->current_time;
+
+        fprintf(out, "| %6.2f | %5d | %12lld | %6.2f%% | %10lld | %10lld | %10.2f | %10lld | %10.2f | %12.0f |\n",
+                usage->speed,
+                usage->cores,
+                usage->busy_time,
+                capacity > 0 ? usage->busy_time * 100.0 / capacity : 0.0,
+                usage->dispatches,
+                usage->started,
+                usage->started > 0 ? (double)usage->response_sum / usage->started : 0.0,
+                usage->completed,
+                usage->completed > 0 ? (double)usage->turnaround_sum / usage->completed : 0.0,
+                core_energy(usage));
+    }
+    fprintf(out, "+--------+-------+--------------+---------+------------+------------+------------+------------+------------+--------------+\n");
+}
+
+/*---------- FUNCTION: display_groups ----------------------
+/  Function Description:
+/    Prints a table of the groups of a run, each one indented below 
+/    its parent: its shares and quota, the share of the CPU it is 
+/    entitled to, the CPU time it used and its share of the run, the
+/    time it was throttled and in how many periods, and the processes
+/    that completed in it with their mean waiting and turnaround 
+/    times. A group's figures include those of the groups below it.
+/  
+/  Caller Input:
+/    - FILE *out: The stream to write to.
+/    - const GroupTree *groups: The run's groups.
+/    - long long end_time: The time the run ended.
+/  
+/  Caller Output:
+/    N/A - No return value. The table is written to out.
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    - names too long for the column are cut short
+/---------------------------------------------------------*/
+void display_groups(FILE *out, const GroupTree *groups, long long end_time) {
+    fprintf(out, "Groups:\n");
+    fprintf(out, "+------------------------+---------+-------------------+----------+--------------+----------+--------------+-----------+------------+------------+------------+\n");
+    fprintf(out, "| %-22s | %7s | %17s | %8s | %12s | %8s | %12s | %9s | %10s | %10s | %10s |\n",
+            "Group", "Shares", "Quota / Period", "Entitled", "Used", "Share", "Throttled", "Throttles",
+            "Completed", "Avg. Wait.", "Avg. Turn.");
+    fprintf(out, "+------------------------+---------+-------------------+----------+--------------+----------+--------------+-----------+------------+------------+------------+\n");
+    for (int g = 0; g < groups->num_groups; g++) {
+        const Group *group = &groups->group[g];
+        char name[23];
+        char quota[48] = "max";
+
+        snprintf(name, sizeof(name), "%*s%s", 2 * group->depth, "", group->name);
+        if (group->quota > 0) {
+            snprintf(quota, sizeof(quota), "%lld / %lld", group->quota, group->period);
+        }
+        fprintf(out, "| %-22s | %7lld | %17s | %7.2f%% | %12lld | %7.2f%% | %12lld | %9lld | %10lld | %10.2f | %10.2f |\n",
+                name,
+                group->shares,
+                quota,
+                group->entitlement * 100,
+                group->usage,
+                end_time > 0 ? group->usage * 100.0 / end_time : 0.0,
+                group->throttled_time,
+                group->throttles,
+                group->completed,
+                group->completed > 0 ? (double)group->waiting_sum / group->completed : 0.0,
+                group->completed > 0 ? (double)group->turnaround_sum / group->completed : 0.0);
+    }
+    fprintf(out, "+------------------------+---------+-------------------+----------+--------------+----------+--------------+-----------+------------+------------+------------+\n");
+}
+
+/*---------- FUNCTION: display_percentile_table ------------
+/  Function Description:
+/    Prints the latency percentiles table, one row per metric.
+/  
+/  Caller Input:
+/    - FILE *out: The stream to write to.
+/    - LatencyHistograms *latency: The distributions of the metrics.
+/  
+/  Caller Output:
+/    N/A - No return value. The table is written to out.
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void display_percentile_table(FILE *out, LatencyHistograms *latency) {
+    fprintf(out, "\nLatency Percentiles:");
+    fprintf(out, "\n+------------+--------+--------+--------+--------+\n");
+    fprintf(out, "|   Metric   |   p50  |   p90  |   p99  |  p99.9 |");
+    fprintf(out, "\n+------------+--------+--------+--------+--------+\n");
+    display_percentile_row(out, "Turnaround", &latency->turnaround);
+    display_percentile_row(out, "Waiting", &latency->waiting);
+    display_percentile_row(out, "Response", &latency->response);
+}
+
+/*---------- FUNCTION: display_percentile_row --------------
+/  Function Description:
+/    Prints one row of the latency percentiles table.
+/  
+/  Caller Input:
+/    - FILE *out: The stream to write to.
+/    - const char *name: The name of the metric.
+/    - Histogram *hist: The metric's distribution.
+/  
+/  Caller Output:
+/    N/A - No return value. The row is written to out.
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void display_percentile_row(FILE *out, const char *name, Histogram *hist) {
+    fprintf(out, "| %-10s | %6lld | %6lld | %6lld | %6lld |\n",
+            name,
+            hist_percentile(hist, 50.0),
+            hist_percentile(hist, 90.0),
+            hist_percentile(hist, 99.0),
+            hist_percentile(hist, 99.9));
+    fprintf(out, "+------------+--------+--------+--------+--------+\n");
 }
 
 
 /*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
 /  Functions Overview:
-/    These functions generate a Gantt chart representation of process scheduling,
-/    visually displaying the start and completion times of each process in a 
-/    time-ordered format.
+/    These functions print the output of the streaming simulator, which 
+/    writes each process's metrics as soon as it completes rather than 
+/    once the whole run is over.
 /  
 /  Functions and Their Purpose:
-/    - display_chart: Generates a Gantt chart with color-coded output using ANSI 
-/      escape codes, intended for terminal display.
-/    - display_chart_file: Generates a plain-text Gantt chart without ANSI codes, 
-/      suitable for writing to output files.
-/    - display_preemptive_chart: Generates a Gantt chart for preemptive scheduling 
-/      scenarios, where specific time slices need to be tracked.
+/    - display_stream_header: Prints the title and the table heading.
+/    - display_stream_row: Prints the metrics of one completed process,
+/      with its dispatches, preemptions and time slice expirations.
+/    - display_stream_summary: Closes the table and prints the summary 
+/      metrics, including their min, max and standard deviation, the 
+/      total dispatches, and the latency percentiles. If scheduling 
+/      decisions or cache refills were charged for, their time is 
+/      given as a share of the CPU's busy time. A multi-core run adds
+/      its migrations and a table of its core classes, and a run in 
+/      groups a table of its groups.
 /  
 /  Input Parameters:
-/    - Process processes[]: Array of processes to display in the chart. 
-/    - int num_processes: The number of processes in the array.
-/    - FILE *fp: A file pointer where the Gantt chart is written.
+/    - FILE *out: the stream to write to
+/    - const char *title: the algorithm's full name
+/    - Process *process: a completed process
+/    - long long completed: the number of processes that completed
+/    - int peak_active: the most processes held in memory at once
+/    - SimResult *result: the run's summary metrics
+/    - const GroupTree *groups: the run's groups, or NULL
 /  
 /  Output:
-/    - display_chart and display_chart_file write formatted Gantt chart output 
-/      to the correct output based on file pointer
-/    - display_preemptive_chart outputs the Gantt chart to the console, formatted 
-/       for preemptive scheduling.
+/    - N/A - output is written to out
 /  
 /  Assumptions, Limitations, Known Bugs:
-/    - No known bugs at this time.
-/  
+/    - rows are in completion order, not PID order
 /------------------------------------------------------------------------*/
-void display_chart(Process processes[], int num_processes) {
-   
-    int max_time = 0;
-    int current_time = 0;
+void display_stream_header(FILE *out, const char *title) {
+    fprintf(out, "~~~~~~~~~~\n\n");
+    fprintf(out, "\nStreaming Simulation for %s\n\n", title);
+    fprintf(out, "+-----------+------------+------------+------------+------------+------------+------------+--------+--------+--------+\n");
+    fprintf(out, "| %-9s | %10s | %10s | %10s | %10s | %10s | %10s | %6s | %6s | %6s |", 
+            "PID", "Arrival", "Burst", "Completion", "Turn.", "Wait.", "Resp.", "Disp.", "Pre.", "Exp.");
+    fprintf(out, "\n+-----------+------------+------------+------------+------------+------------+------------+--------+--------+--------+\n");
+}
 
-    for (int i = 0; i < num_processes; i++) {
-        if (processes[i].completion_time > max_time) {
-            max_time = processes[i].completion_time;
-        }
-    }
+void display_stream_row(FILE *out, Process *process) {
+    char pid[11];
 
-    fprintf(stdout, "\nGantt Chart:\n");
-    fprintf(stdout, ANSI_BOLD ANSI_BLUE "--------------------------------------------" ANSI_RESET "\n");
+    sprintf(pid, "P%s", process->id);
+    fprintf(out, "| %-9s | %10lld | %10lld | %10lld | %10lld | %10lld | %10lld | %6d | %6d | %6d |\n",
+            pid,
+            process->arrival_time,
+            process->burst_time,
+            process->completion_time,
+            process->turnaround_time,
+            process->waiting_time,
+            process->response_time,
+            process->dispatches,
+            process->preemptions,
+            process->expirations);
+}
 
-    for (int start = 0; start <= max_time; start += MAX_WIDTH) {
+void display_stream_summary(FILE *out, long long completed, int peak_active, SimResult *result,
+                            const GroupTree *groups) {
+    MetricSummary *summaries[] = {&result->waiting, &result->turnaround, &result->response};
+    const char *names[] = {"Waiting", "Turnaround", "Response"};
 
-        int end = (start + MAX_WIDTH - 1 < max_time) ? start + MAX_WIDTH - 1 : max_time;
+    fprintf(out, "+-----------+------------+------------+------------+------------+------------+------------+--------+--------+--------+\n");
+    fprintf(out, "\nSimulation complete.");
+    fprintf(out, "\n\n~~~~~~~~~~\n\n");
 
-        
-        fprintf(stdout, ANSI_BOLD ANSI_BLUE "Time: " ANSI_RESET);
-        for (int t = start; t <= end; t++) {
-            fprintf(stdout, ANSI_BOLD ANSI_BLUE "%-4d" ANSI_RESET, t);  
-        }
-        fprintf(stdout, "\n");
-
-        
-        for (int i = 0; i < num_processes; i++) {
-            const char* color;
-            switch (i % 5) {
-                case 0: color = ANSI_RED; break;
-                case 1: color = ANSI_GREEN; break;
-                case 2: color = ANSI_YELLOW; break;
-                case 3: color = ANSI_BLUE; break;
-                case 4: color = ANSI_MAGENTA; break;
-            }
-            fprintf(stdout, "%sP%-2s| " ANSI_RESET, color, processes[i].id);  
+    fprintf(out, "Metrics Summary:\n");
+    fprintf(out, "Processes Completed:\n\t%lld\n", completed);
+    fprintf(out, "Peak Active Processes:\n\t%d\n", peak_active);
+    for (int m = 0; m < 3; m++) {
+        fprintf(out, "Average %s Time:\n\t%.2f (min %lld, max %lld, std. dev. %.2f)\n",
+                names[m],
+                summaries[m]->mean,
+                summaries[m]->min,
+                summaries[m]->max,
+                sqrt(summaries[m]->variance));
+    }
+    fprintf(out, "Throughput:\n\t%.2f processes per time unit\n", result->throughput);
+    fprintf(out, "CPU Utilization:\n\t%.2f%%\n", result->cpu_utilization);
+    display_switches(out, &result->switches);
+    if (result->num_classes > 0) {
+        display_core_classes(out, result);
+    }
+    if (result->decisions > 0) {
+        long long busy = result->current_time - result->idle_time;
+        fprintf(out, "Scheduler Overhead:\n\t%lld time units over %lld decisions (%.2f%% of busy CPU time)\n",
+                result->overhead_time, result->decisions,
+                busy > 0 ? result->overhead_time * 100.0 / busy : 0.0);
+    }
+    if (result->refill_time > 0) {
+        long long busy = result->current_time - result->idle_time;
+        fprintf(out, "Cache Refill:\n\t%lld time units (%.2f%% of busy CPU time)\n",
+                result->refill_time,
+                busy > 0 ? result->refill_time * 100.0 / busy : 0.0);
+    }
+    if (groups != NULL) {
+        display_groups(out, groups, result->current_time);
+    }
 
-            for (int j = start; j <= end; j++) {
-                if (j >= processes[i].start_time && j <= processes[i].completion_time) {
-                    
-                    fprintf(stdout, "%s### " ANSI_RESET, color); 
-                    
-                } else {
-                    fprintf(stdout, "    "); 
-                }
-                current_time++;
-            }
-            fprintf(stdout, "\n");
-        }
+    display_percentile_table(out, &result->latency);
+    fprintf(out, "\n~~~~~~~~~~\n");
+}
+
+/*---------- FUNCTION: display_import_summary -------------
+/  Function Description:
+/    Prints how the kernel itself scheduled the jobs of an imported
+/    trace, in the form of the metrics summary, so that the simulated
+/    run above it can be compared with what really happened.
+/
+/  Caller Input:
+/    - FILE *out: The stream to write to.
+/    - ImportSummary *summary: The trace's summary, once it has been
+/      read to the end.
+/
+/  Caller Output:
+/    N/A - No return value. The summary is written to out.
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the kernel ran the jobs on every CPU of the traced machine, and
+/      the simulator runs them on one, so with more than one CPU the
+/      simulated times are expected to be longer
+/---------------------------------------------------------*/
+void display_import_summary(FILE *out, ImportSummary *summary) {
+    double jobs = summary->jobs > 0 ? (double)summary->jobs : 1.0;
 
-        fprintf(stdout, ANSI_BOLD ANSI_BLUE "--------------------------------------------" ANSI_RESET "\n");
+    fprintf(out, "\nKernel Schedule (as traced):\n");
+    fprintf(out, "Trace:\n\t%lld events over %lld time units on %d CPU%s\n",
+            summary->events, summary->span, summary->cpus, summary->cpus == 1 ? "" : "s");
+    fprintf(out, "Jobs:\n\t%lld", summary->jobs);
+    if (summary->split > 0) {
+        fprintf(out, " (%lld split at the reorder window)", summary->split);
     }
+    fprintf(out, "\n");
+    fprintf(out, "Average Waiting Time:\n\t%.2f\n", summary->waiting_sum / jobs);
+    fprintf(out, "Average Turnaround Time:\n\t%.2f\n", summary->turnaround_sum / jobs);
+    fprintf(out, "Average Response Time:\n\t%.2f\n", summary->response_sum / jobs);
+    fprintf(out, "\n~~~~~~~~~~\n");
 }
 
-void display_chart_file(Process processes[], int num_processes) {
-   
-    int max_time = 0;
-    int current_time = 0;
+/*---------- FUNCTION: display_sort_summary ---------------
+/  Function Description:
+/    Prints what sorting the input by arrival time (--sort) took.
+/
+/  Caller Input:
+/    - FILE *out: The stream to write to.
+/    - ExtsortSummary *summary: The sort's summary.
+/
+/  Caller Output:
+/    N/A - No return value. The summary is written to out.
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void display_sort_summary(FILE *out, ExtsortSummary *summary) {
+    fprintf(out, "\nInput Sort:\n");
+    fprintf(out, "Processes:\n\t%lld", summary->records);
+    if (summary->sorted) {
+        fprintf(out, " (already in arrival order)");
+    }
+    fprintf(out, "\n");
+    if (summary->runs > 0) {
+        fprintf(out, "Runs Spilled:\n\t%lld (%lld bytes written, %d merge%s before the last)\n",
+                summary->runs, summary->spilled, summary->passes, summary->passes == 1 ? "" : "s");
+    }
+    fprintf(out, "\n~~~~~~~~~~\n");
+}
 
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions write a run's results as a JSON or CSV report
+/    (--format), for programs to read instead of the tables above.
+/
+/  Functions and Their Purpose:
+/    - display_report: Writes the "processes" section, one record per
+/      process in PID order, then the summary. Used after a full run.
+/    - display_report_process: Writes the record of one process into
+/      the current section: its ID, arrival, burst, priority, start,
+/      completion, turnaround, waiting and response times, and its 
+/      dispatches, preemptions and time slice expirations. The priority 
+/      is null when the algorithm did not read one.
+/    - display_report_summary: Writes the "summary" section: the
+/      algorithm and time quantum (0 unless RR), the number of
+/      processes, the end time, idle time, throughput and CPU
+/      utilization, then the mean, min, max, standard deviation and
+/      p50/p90/p99/p99.9 of the waiting, turnaround and response
+/      times, and the run's dispatches and how they ended. A streamed
+/      run also reports its peak active processes, and, if scheduling
+/      decisions were charged for, their number and the CPU time they
+/      took, and if cache refills were, the CPU time they took. A
+/      multi-core run reports its migrations (and with a gang mode, 
+/      its backfills, fragmentation time and slowdown), then a 
+/      "cores" section with one record per class of cores, as 
+/      display_core_classes prints them (utilization as a percentage).
+/    - display_report_groups: Writes the "groups" section of a run in
+/      groups, one record per group in tree order, as display_groups
+/      prints them (entitlement and usage share as percentages; the
+/      parent is null for the root, and the quota and period for a
+/      group without a limit).
+/
+/  Input Parameters:
+/    - ReportWriter *report: the report, already begun
+/    - Process processes[], int num_processes: the completed processes
+/    - Process *process: a completed process
+/    - const char *algorithm: the algorithm's short name
+/    - int time_quantum: the RR time quantum
+/    - long long completed: the number of processes that completed
+/    - int peak_active: the most processes held at once, or -1 if
+/      the whole workload was held
+/    - SimResult *result: the run's summary metrics
+/    - const GroupTree *groups: the run's groups
+/    - long long end_time: the time the run ended
+/
+/  Output:
+/    - N/A - output is written to the report
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - display_report re-sorts processes, as display_metrics_table does
+/    - percentiles are read from the histograms, so above 128 time units
+/      they are accurate to within 1.6%
+/------------------------------------------------------------------------*/
+void display_report(ReportWriter *report, Process processes[], int num_processes,
+                    const char *algorithm, int time_quantum, SimResult *result) {
+    qsort(processes, num_processes, sizeof(Process), compare_pid);
+
+    report_section(report, "processes", REPORT_PROCESS_COLUMNS, 1);
     for (int i = 0; i < num_processes; i++) {
-        if (processes[i].completion_time > max_time) {
-            max_time = processes[i].completion_time;
-        }
+        display_report_process(report, &processes[i]);
     }
+    display_report_summary(report, algorithm, time_quantum, num_processes, -1, result);
+}
 
-    fprintf(stdout, "\nGantt Chart:\n");
-    fprintf(stdout, "--------------------------------------------\n");
-
-    for (int start = 0; start <= max_time; start += MAX_WIDTH) {
+void display_report_process(ReportWriter *report, Process *process) {
+    report_record(report);
+    report_string(report, "id", process->id);
+    report_int(report, "arrival", process->arrival_time);
+    report_int(report, "burst", process->burst_time);
+    if (process->priority < 0) {
+        report_string(report, "priority", NULL);
+    } else {
+        report_int(report, "priority", process->priority);
+    }
+    report_int(report, "start", process->start_time);
+    report_int(report, "completion", process->completion_time);
+    report_int(report, "turnaround", process->turnaround_time);
+    report_int(report, "waiting", process->waiting_time);
+    report_int(report, "response", process->response_time);
+    report_int(report, "dispatches", process->dispatches);
+    report_int(report, "preemptions", process->preemptions);
+    report_int(report, "expirations", process->expirations);
+}
 
-        int end = (start + MAX_WIDTH - 1 < max_time) ? start + MAX_WIDTH - 1 : max_time;
+void display_report_summary(ReportWriter *report, const char *algorithm, int time_quantum,
+                            long long completed, int peak_active, SimResult *result) {
+    MetricSummary *summaries[] = {&result->waiting, &result->turnaround, &result->response};
+    Histogram *histograms[] = {&result->latency.waiting, &result->latency.turnaround, &result->latency.response};
+    char columns[1024];
+    static const char *names[3][8] = {
+        {"waiting_mean", "waiting_min", "waiting_max", "waiting_stddev",
+         "waiting_p50", "waiting_p90", "waiting_p99", "waiting_p999"},
+        {"turnaround_mean", "turnaround_min", "turnaround_max", "turnaround_stddev",
+         "turnaround_p50", "turnaround_p90", "turnaround_p99", "turnaround_p999"},
+        {"response_mean", "response_min", "response_max", "response_stddev",
+         "response_p50", "response_p90", "response_p99", "response_p999"}
+    };
 
-        
-        fprintf(stdout, "Time: ");
-        for (int t = start; t <= end; t++) {
-            fprintf(stdout, "%-4d", t);  
+    snprintf(columns, sizeof(columns), "%s%s%s%s%s%s", REPORT_SUMMARY_COLUMNS,
+             peak_active >= 0 ? ",peak_active" : "",
+             peak_active >= 0 && result->decisions > 0 ? ",decisions,overhead_time" : "",
+             peak_active >= 0 && result->refill_time > 0 ? ",refill_time" : "",
+             result->num_classes > 0 ? ",migrations" : "",
+             result->gang.mode != GANG_NONE ? ",backfilled,fragmentation_time,slowdown_mean,slowdown_max" : "");
+    report_section(report, "summary", columns, 0);
+    report_record(report);
+    report_string(report, "algorithm", algorithm);
+    report_int(report, "time_quantum", strcmp(algorithm, "RR") == 0 ? time_quantum : 0);
+    report_int(report, "processes", completed);
+    report_int(report, "end_time", result->current_time);
+    report_int(report, "idle_time", result->idle_time);
+    report_double(report, "throughput", result->throughput);
+    report_double(report, "cpu_utilization", result->cpu_utilization);
+    for (int m = 0; m < 3; m++) {
+        report_double(report, names[m][0], summaries[m]->mean);
+        report_int(report, names[m][1], summaries[m]->min);
+        report_int(report, names[m][2], summaries[m]->max);
+        report_double(report, names[m][3], sqrt(summaries[m]->variance));
+        report_int(report, names[m][4], hist_percentile(histograms[m], 50));
+        report_int(report, names[m][5], hist_percentile(histograms[m], 90));
+        report_int(report, names[m][6], hist_percentile(histograms[m], 99));
+        report_int(report, names[m][7], hist_percentile(histograms[m], 99.9));
+    }
+    report_int(report, "dispatches", result->switches.dispatches);
+    report_int(report, "completions", result->switches.completions);
+    report_int(report, "preemptions", result->switches.preemptions);
+    report_int(report, "expirations", result->switches.expirations);
+    if (peak_active >= 0) {
+        report_int(report, "peak_active", peak_active);
+        if (result->decisions > 0) {
+            report_int(report, "decisions", result->decisions);
+            report_int(report, "overhead_time", result->overhead_time);
         }
-        fprintf(stdout, "\n");
-
-        
-        for (int i = 0; i < num_processes; i++) {
-            fprintf(stdout, "P%-2s| ", processes[i].id);  
-
-            for (int j = start; j <= end; j++) {
-                if (j >= processes[i].start_time && j <= processes[i].completion_time) {
-                    
-                    fprintf(stdout, "### "); 
-                    
-                } else {
-                    fprintf(stdout, "    "); 
-                }
-                current_time++;
-            }
-            fprintf(stdout, "\n");
+        if (result->refill_time > 0) {
+            report_int(report, "refill_time", result->refill_time);
         }
+    }
+    if (result->num_classes == 0) return;
+
+    report_int(report, "migrations", result->switches.migrations);
+    if (result->gang.mode != GANG_NONE) {
+        report_int(report, "backfilled", result->gang.backfilled);
+        report_int(report, "fragmentation_time", result->gang.fragmentation_time);
+        report_double(report, "slowdown_mean", result->gang.slowdown_mean);
+        report_double(report, "slowdown_max", result->gang.slowdown_max);
+    }
+    report_section(report, "cores", REPORT_CORE_COLUMNS, 1);
+    for (int cls = 0; cls < result->num_classes; cls++) {
+        CoreUsage *usage = &result->classes[cls];
+        double capacity = (double)usage->cores * result->current_time;
 
-        fprintf(stdout, "--------------------------------------------\n");
+        report_record(report);
+        report_double(report, "speed", usage->speed);
+        report_int(report, "cores", usage->cores);
+        report_int(report, "busy_time", usage->busy_time);
+        report_double(report, "utilization", capacity > 0 ? usage->busy_time * 100.0 / capacity : 0.0);
+        report_int(report, "dispatches", usage->dispatches);
+        report_int(report, "started", usage->started);
+        report_double(report, "response_mean",
+                      usage->started > 0 ? (double)usage->response_sum / usage->started : 0.0);
+        report_int(report, "completed", usage->completed);
+        report_double(report, "turnaround_mean",
+                      usage->completed > 0 ? (double)usage->turnaround_sum / usage->completed : 0.0);
+        report_double(report, "energy", core_energy(usage));
     }
 }
 
-void display_preemptive_chart(Process processes[], int num_processes) {
-    int max_time = 0;
-    int current_time = 0;
-    int flag = 0;
+void display_report_groups(ReportWriter *report, const GroupTree *groups, long long end_time) {
+    report_section(report, "groups", REPORT_GROUP_COLUMNS, 1);
+    for (int g = 0; g < groups->num_groups; g++) {
+        const Group *group = &groups->group[g];
 
-    
-    for (int i = 0; i < num_processes; i++) {
-        if (processes[i].completion_time > max_time) {
-            max_time = processes[i].completion_time;
+        report_record(report);
+        report_string(report, "group", group->name);
+        report_string(report, "parent", group->parent >= 0 ? groups->group[group->parent].name : NULL);
+        report_int(report, "shares", group->shares);
+        if (group->quota > 0) {
+            report_int(report, "quota", group->quota);
+            report_int(report, "period", group->period);
+        } else {
+            report_string(report, "quota", NULL);
+            report_string(report, "period", NULL);
         }
+        report_double(report, "entitlement", group->entitlement * 100);
+        report_int(report, "usage", group->usage);
+        report_double(report, "usage_share", end_time > 0 ? group->usage * 100.0 / end_time : 0.0);
+        report_int(report, "throttled_time", group->throttled_time);
+        report_int(report, "throttles", group->throttles);
+        report_int(report, "completed", group->completed);
+        report_double(report, "waiting_mean",
+                      group->completed > 0 ? (double)group->waiting_sum / group->completed : 0.0);
+        report_double(report, "turnaround_mean",
+                      group->completed > 0 ? (double)group->turnaround_sum / group->completed : 0.0);
     }
+}
 
-    fprintf(stdout, "\nGantt Chart:\n");
-    fprintf(stdout, ANSI_BOLD ANSI_BLUE "--------------------------------------------" ANSI_RESET "\n");
-
-    
-    for (int start = 0; start <= max_time; start += MAX_WIDTH) {
-        int end = (start + MAX_WIDTH - 1 < max_time) ? start + MAX_WIDTH - 1 : max_time;
+/*---------- FUNCTION: display_ensemble -------------------
+/  Function Description:
+/    Prints the results of a Monte Carlo ensemble: a line describing
+/    the generated workloads, then for each algorithm a table giving
+/    every metric's mean, standard deviation and 95% confidence
+/    interval across the replications, and the latency percentiles
+/    of every process of every replication, pooled.
+/
+/  Caller Input:
+/    - FILE *out: The stream to write to.
+/    - EnsembleSpec *spec: The ensemble that was run.
+/    - EnsembleResult results[]: One result per algorithm of the spec.
+/
+/  Caller Output:
+/    N/A - No return value. The tables are written to out.
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the number of threads is not printed, as it does not affect
+/      the results
+/---------------------------------------------------------*/
+void display_ensemble(FILE *out, EnsembleSpec *spec, EnsembleResult results[]) {
+    fprintf(out, "\nEnsemble of %d Replications (seed %llu)\n", spec->replications, spec->seed);
+    fprintf(out, "Workload: %d processes, mean arrival gap %.2f, mean burst %.2f, priorities 1-%d\n",
+            spec->num_processes, spec->mean_gap, spec->mean_burst, spec->max_priority);
 
-        fprintf(stdout, ANSI_BOLD ANSI_BLUE "Time: " ANSI_RESET);
-        for (int t = start; t <= end; t++) {
-            fprintf(stdout, ANSI_BOLD ANSI_BLUE "%-4d" ANSI_RESET, t);  
+    for (int a = 0; a < spec->num_algorithms; a++) {
+        fprintf(out, "\n%s", results[a].algorithm);
+        if (strcmp(results[a].algorithm, "RR") == 0) {
+            fprintf(out, " (time quantum %d)", spec->time_quantum);
         }
-        fprintf(stdout, "\n");
-
-        
-        for (int i = 0; i < num_processes; i++) {
-            const char* color;
-            switch (i % 5) {
-                case 0: color = ANSI_RED; break;
-                case 1: color = ANSI_GREEN; break;
-                case 2: color = ANSI_YELLOW; break;
-                case 3: color = ANSI_BLUE; break;
-                case 4: color = ANSI_MAGENTA; break;
-            }
-            fprintf(stdout, "%sP%-2s| " ANSI_RESET, color, processes[i].id);  
+        fprintf(out, ":\n+-------------------------+------------+------------+------------+------------+\n");
+        fprintf(out, "| %-23s | %10s | %10s | %10s | %10s |",
+                "Metric", "Mean", "Std. Dev.", "95% Low", "95% High");
+        fprintf(out, "\n+-------------------------+------------+------------+------------+------------+\n");
+        for (int m = 0; m < ENSEMBLE_METRICS; m++) {
+            Estimate *estimate = &results[a].metrics[m];
+            fprintf(out, "| %-23s | %10.2f | %10.2f | %10.2f | %10.2f |\n",
+                    ensemble_metric_name(m),
+                    estimate->mean,
+                    estimate->stddev,
+                    estimate->low,
+                    estimate->high);
+        }
+        fprintf(out, "+-------------------------+------------+------------+------------+------------+\n");
 
-            
-            for (int t = start; t <= end; t++) {
-                if (processes[i].running_time[t] == 1) {  
-                    fprintf(stdout, "%s### " ANSI_RESET, color); 
-                } else {
-                    if(!flag){
+        fprintf(out, "\n%s Pooled Latency Percentiles:", results[a].algorithm);
+        fprintf(out, "\n+------------+--------+--------+--------+--------+\n");
+        fprintf(out, "|   Metric   |   p50  |   p90  |   p99  |  p99.9 |");
+        fprintf(out, "\n+------------+--------+--------+--------+--------+\n");
+        display_percentile_row(out, "Turnaround", &results[a].latency.turnaround);
+        display_percentile_row(out, "Waiting", &results[a].latency.waiting);
+        display_percentile_row(out, "Response", &results[a].latency.response);
+    }
+}
+
+/*---------- FUNCTION: display_sweep ----------------------
+/  Function Description:
+/    Prints the merged results of a sweep as one table, with a row
+/    per cell of the grid giving the mean and the half-width of the
+/    95% confidence interval of the main metrics, and the p99 of the
+/    waiting times of every process of the cell's seeds, pooled.
+/
+/  Caller Input:
+/    - FILE *out: The stream to write to.
+/    - SweepSpec *spec: The sweep that was run.
+/    - SweepCell cells[]: The cells, as filled in by run_sweep.
+/    - int num_cells: The number of cells.
+/    - int restarts: The number of shards that had to be rerun.
+/
+/  Caller Output:
+/    N/A - No return value. The table is written to out.
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the quantum column is blank for algorithms other than RR
+/---------------------------------------------------------*/
+void display_sweep(FILE *out, SweepSpec *spec, SweepCell cells[], int num_cells, int restarts) {
+    /* waiting, turnaround, response and utilization */
+    const int columns[] = {0, 1, 2, 4};
 
-                    }
+    fprintf(out, "\nSweep of %d Cells x %d Seeds (seed %llu)\n",
+            num_cells, spec->base.replications, spec->base.seed);
+    fprintf(out, "Workload: %d processes, mean burst %.2f, priorities 1-%d\n",
+            spec->base.num_processes, spec->base.mean_burst, spec->base.max_priority);
+    if (restarts > 0) {
+        fprintf(out, "Shards rerun after a worker failed: %d\n", restarts);
+    }
 
-                    fprintf(stdout, "    ");  
-                }
-                current_time++;
-            }
-            fprintf(stdout, "\n");
-        }
+    fprintf(out, "\n+------+---------+---------+---------------------+---------------------+---------------------+---------------------+---------------------+\n");
+    fprintf(out, "| %-4s | %7s | %7s | %19s | %19s | %19s | %19s | %19s |",
+            "Alg.", "Quantum", "Gap", "Avg. Wait.", "Avg. Turn.", "Avg. Resp.", "CPU Util. (%)", "Pooled Wait. p99");
+    fprintf(out, "\n+------+---------+---------+---------------------+---------------------+---------------------+---------------------+---------------------+\n");
+    for (int c = 0; c < num_cells; c++) {
+        char quantum[16] = "";
 
-        fprintf(stdout, ANSI_BOLD ANSI_BLUE "--------------------------------------------" ANSI_RESET "\n");
+        if (cells[c].time_quantum > 0) {
+            snprintf(quantum, sizeof(quantum), "%d", cells[c].time_quantum);
+        }
+        fprintf(out, "| %-4s | %7s | %7.2f |", cells[c].algorithm, quantum, cells[c].mean_gap);
+        for (int k = 0; k < 4; k++) {
+            Estimate *estimate = &cells[c].metrics[columns[k]];
+            fprintf(out, " %8.2f +/- %6.2f |", estimate->mean, estimate->high - estimate->mean);
+        }
+        fprintf(out, " %19lld |\n", hist_percentile(&cells[c].latency.waiting, 99.0));
     }
+    fprintf(out, "+------+---------+---------+---------------------+---------------------+---------------------+---------------------+---------------------+\n");
 }
 
 
-void display_preemptive_chart_file(Process processes[], int num_processes) {
-    int max_time = 0;
-    int current_time = 0;
-    int flag = 0;
+/*---------- FUNCTION: display_gantt ----------------------
+/  Function Description:
+/    Draws a Gantt chart of the simulation from the run segments the
+/    simulator recorded in its Timeline. The chart is printed in blocks
+/    of MAX_WIDTH columns, with a row for each process that runs in the
+/    block. Each row is built from its segments a span at a time, and
+/    the rows of a block are found from the segments that fall in it,
+/    so the work done grows with the number of segments and columns
+/    rather than processes x time.
+/
+/  Caller Input:
+/    - FILE *out: the stream to write to
+/    - Process processes[]: processes to chart, one row each, in order
+/    - int num_processes: the number of processes in the array
+/    - Timeline *timeline: run segments recorded by the simulator
+/    - int colour: 1 to colour-code the chart with ANSI escape sequences
+/      (for the terminal), 0 for plain text (for output files)
+/
+/  Caller Output:
+/    N/A - No return value. The chart is written to out.
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - a process's cells are filled from the time it is dispatched up to
+/      and including the time it stops running, as in the event table
+/    - if the chart would be wider than MAX_CHART_COLUMNS, each column
+/      covers several time units and is filled if the process ran
+/      during any of them
+/    - blocks in which no process runs are collapsed into a single
+/      "Idle" line
+/    - assumes a single CPU, so segments do not overlap and are in
+/      time order
+/    - draws nothing if its scratch space cannot be allocated
+/---------------------------------------------------------*/
+void display_gantt(FILE *out, Process processes[], int num_processes, Timeline *timeline, int colour) {
+    static const char *row_colours[] = {ANSI_RED, ANSI_GREEN, ANSI_YELLOW, ANSI_BLUE, ANSI_MAGENTA};
+    const char *rule_colour = colour ? ANSI_BOLD ANSI_BLUE : "";
+    const char *reset = colour ? ANSI_RESET : "";
+    long long max_time = 0;
+    long long scale = 1;
+    int columns, width, line_size;
+    int next_segment = 0;
+    long long idle_from = -1;
 
-    
     for (int i = 0; i < num_processes; i++) {
         if (processes[i].completion_time > max_time) {
             max_time = processes[i].completion_time;
         }
     }
 
-    fprintf(stdout, "\nGantt Chart:\n");
-    fprintf(stdout, "--------------------------------------------\n");
+    if (max_time + 1 > MAX_CHART_COLUMNS) {
+        scale = (max_time + MAX_CHART_COLUMNS) / MAX_CHART_COLUMNS;
+    }
+    columns = (int)((max_time + scale) / scale);
+    /* downsampled labels get wide quickly, so widen the cells to fit them */
+    width = 4;
+    if (scale > 1 && snprintf(NULL, 0, "%lld", (columns - 1) * scale) + 1 > width) {
+        width = snprintf(NULL, 0, "%lld", (columns - 1) * scale) + 1;
+    }
+    line_size = 64 + MAX_WIDTH * (width + 2 * sizeof(ANSI_BOLD ANSI_BLUE));
+
+    /* scratch space comes from the run's arena along with the timeline */
+    int *row_of = arena_alloc(timeline->arena, num_processes * sizeof(int));
+    int *row_first = arena_alloc(timeline->arena, (num_processes + 1) * sizeof(int));
+    int *row_next = arena_alloc(timeline->arena, (num_processes + 1) * sizeof(int));
+    int *row_block = arena_alloc(timeline->arena, num_processes * sizeof(int));
+    int *active = arena_alloc(timeline->arena, num_processes * sizeof(int));
+    Segment **by_row = arena_alloc(timeline->arena, (timeline->count + 1) * sizeof(Segment *));
+    char *cells = arena_alloc(timeline->arena, MAX_WIDTH * width);
+    char *line = arena_alloc(timeline->arena, line_size);
+    char filled[MAX_WIDTH];
+
+    if (row_of == NULL || row_first == NULL || row_next == NULL || row_block == NULL ||
+        active == NULL || by_row == NULL || cells == NULL || line == NULL) {
+        display_gantt_release(timeline, row_of, row_first, row_next, row_block, active, by_row, cells, line);
+        return;
+    }
+    memset(row_first, 0, (num_processes + 1) * sizeof(int));
+    for (int r = 0; r < num_processes; r++) {
+        row_block[r] = -1;
+    }
+
+    /* a run of filled cells is copied out of this in one go */
+    for (int c = 0; c < MAX_WIDTH; c++) {
+        memset(cells + c * width, '#', width - 1);
+        cells[c * width + width - 1] = ' ';
+    }
+
+    /* group the segments by chart row, keeping each row in time order */
+    for (int r = 0; r < num_processes; r++) {
+        row_of[processes[r].index] = r;
+    }
+    for (int s = 0; s < timeline->count; s++) {
+        row_first[row_of[timeline->segments[s].proc] + 1]++;
+    }
+    for (int r = 0; r < num_processes; r++) {
+        row_first[r + 1] += row_first[r];
+    }
+    memcpy(row_next, row_first, (num_processes + 1) * sizeof(int));
+    for (int s = 0; s < timeline->count; s++) {
+        by_row[row_next[row_of[timeline->segments[s].proc]]++] = &timeline->segments[s];
+    }
+    memcpy(row_next, row_first, (num_processes + 1) * sizeof(int));
+
+    fprintf(out, "\nGantt Chart:\n");
+    fprintf(out, "%s--------------------------------------------%s\n", rule_colour, reset);
 
-    
-    for (int start = 0; start <= max_time; start += MAX_WIDTH) {
-        int end = (start + MAX_WIDTH - 1 < max_time) ? start + MAX_WIDTH - 1 : max_time;
+    for (int first = 0; first < columns; first += MAX_WIDTH) {
+        int last = (first + MAX_WIDTH - 1 < columns - 1) ? first + MAX_WIDTH - 1 : columns - 1;
+        long long t_first = first * scale;
+        long long t_last = last * scale + scale - 1;
+        int num_active = 0;
+        int len;
 
-        fprintf(stdout, "Time: ");
-        for (int t = start; t <= end; t++) {
-            fprintf(stdout, "%-4d", t);  
+        /* skip blocks where nothing runs, then report them as one line */
+        while (next_segment < timeline->count && timeline->segments[next_segment].end < t_first) {
+            next_segment++;
+        }
+        if (next_segment == timeline->count || timeline->segments[next_segment].start > t_last) {
+            if (idle_from < 0) idle_from = t_first;
+            continue;
+        }
+        if (idle_from >= 0) {
+            fprintf(out, "%sIdle: %lld - %lld%s\n", rule_colour, idle_from, t_first - 1, reset);
+            fprintf(out, "%s--------------------------------------------%s\n", rule_colour, reset);
+            idle_from = -1;
         }
-        fprintf(stdout, "\n");
 
-        
-        for (int i = 0; i < num_processes; i++) {
-            fprintf(stdout, "P%-2s| ", processes[i].id);  
+        len = sprintf(line, "%sTime: ", rule_colour);
+        for (int c = first; c <= last; c++) {
+            len += sprintf(line + len, "%-*lld", width, c * scale);
+        }
+        len += sprintf(line + len, "%s\n", reset);
+        fwrite(line, 1, len, out);
 
-            
-            for (int t = start; t <= end; t++) {
-                if (processes[i].running_time[t] == 1) {  
-                    fprintf(stdout, "### "); 
-                } else {
-                    if(!flag){
+        /* only the processes with a segment in the block get a row */
+        for (int s = next_segment; s < timeline->count && timeline->segments[s].start <= t_last; s++) {
+            int r = row_of[timeline->segments[s].proc];
+
+            if (row_block[r] != first) {
+                row_block[r] = first;
+                active[num_active++] = r;
+            }
+        }
+        qsort(active, num_active, sizeof(int), compare_gantt_row);
 
-                    }
+        for (int k = 0; k < num_active; k++) {
+            int r = active[k];
+            const char *row_colour = colour ? row_colours[r % 5] : "";
 
-                    fprintf(stdout, "    ");  
+            memset(filled, 0, sizeof(filled));
+            while (row_next[r] < row_first[r + 1] && by_row[row_next[r]]->end < t_first) {
+                row_next[r]++;
+            }
+            for (int s = row_next[r]; s < row_first[r + 1] && by_row[s]->start <= t_last; s++) {
+                long long from = by_row[s]->start / scale;
+                long long to = by_row[s]->end / scale;
+                if (from < first) from = first;
+                if (to > last) to = last;
+                memset(filled + from - first, 1, to - from + 1);
+            }
+
+            len = sprintf(line, "%sP%-2s| %s", row_colour, processes[r].id, reset);
+            for (int c = 0; c <= last - first; ) {
+                int run = c;
+                while (run <= last - first && filled[run] == filled[c]) run++;
+
+                if (filled[c]) {
+                    len += sprintf(line + len, "%s", row_colour);
+                    memcpy(line + len, cells, (run - c) * width);
+                    len += (run - c) * width;
+                    len += sprintf(line + len, "%s", reset);
+                } else {
+                    memset(line + len, ' ', (run - c) * width);
+                    len += (run - c) * width;
                 }
-                current_time++;
+                c = run;
             }
-            fprintf(stdout, "\n");
+            line[len++] = '\n';
+            fwrite(line, 1, len, out);
         }
 
-        fprintf(stdout, "--------------------------------------------\n");
+        fprintf(out, "%s--------------------------------------------%s\n", rule_colour, reset);
     }
-}
\ No newline at end of file
+
+    display_gantt_release(timeline, row_of, row_first, row_next, row_block, active, by_row, cells, line);
+}
+
+/*---------- FUNCTION: compare_gantt_row ------------------
+/  Function Description:
+/    Orders the rows of a Gantt chart block, so that processes keep the
+/    order they are charted in.
+/
+/  Caller Input:
+/    - const void *a, *b: pointers to the row numbers
+/
+/  Caller Output:
+/    Negative, zero or positive, as qsort expects
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+int compare_gantt_row(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+/*---------- FUNCTION: display_gantt_release --------------
+/  Function Description:
+/    Hands the scratch space of a Gantt chart back to the arena.
+/
+/  Caller Input:
+/    - Timeline *timeline: the timeline whose arena it came from
+/    - the remaining arguments: the scratch buffers, any of which
+/      may be NULL
+/
+/  Caller Output:
+/    N/A - No return value.
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void display_gantt_release(Timeline *timeline, int *row_of, int *row_first, int *row_next, int *row_block,
+                           int *active, Segment **by_row, char *cells, char *line) {
+    arena_release(timeline->arena, row_of);
+    arena_release(timeline->arena, row_first);
+    arena_release(timeline->arena, row_next);
+    arena_release(timeline->arena, row_block);
+    arena_release(timeline->arena, active);
+    arena_release(timeline->arena, by_row);
+    arena_release(timeline->arena, cells);
+    arena_release(timeline->arena, line);
+}
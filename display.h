@@ -10,11 +10,46 @@
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
-void display_metrics(Process processes[], int num_processes, int idle_time, int current_time);
-void display_metrics_table(Process processes[], int num_processes, int idle_time, int current_time);
-void display_chart(Process processes[], int num_processes);
-void display_chart_file(Process processes[], int num_processes);
-void display_preemptive_chart(Process processes[], int num_processes);
-void display_preemptive_chart_file(Process processes[], int num_processes);
+#include <stdio.h>
+#include "process.h"
+#include "timeline.h"
+#include "histogram.h"
+#include "simulator.h"
+#include "ensemble.h"
+#include "sweep.h"
+#include "report.h"
+#include "import.h"
+#include "extsort.h"
+
+#define REPORT_EVENT_COLUMNS "time,event,process,ready"
+#define REPORT_PROCESS_COLUMNS "id,arrival,burst,priority,start,completion,turnaround,waiting,response," \
+    "dispatches,preemptions,expirations"
+#define REPORT_SUMMARY_COLUMNS "algorithm,time_quantum,processes,end_time,idle_time,throughput,cpu_utilization," \
+    "waiting_mean,waiting_min,waiting_max,waiting_stddev,waiting_p50,waiting_p90,waiting_p99,waiting_p999," \
+    "turnaround_mean,turnaround_min,turnaround_max,turnaround_stddev,turnaround_p50,turnaround_p90,turnaround_p99,turnaround_p999," \
+    "response_mean,response_min,response_max,response_stddev,response_p50,response_p90,response_p99,response_p999," \
+    "dispatches,completions,preemptions,expirations"
+#define REPORT_CORE_COLUMNS "speed,cores,busy_time,utilization,dispatches,started,response_mean," \
+    "completed,turnaround_mean,energy"
+#define REPORT_GROUP_COLUMNS "group,parent,shares,quota,period,entitlement,usage,usage_share," \
+    "throttled_time,throttles,completed,waiting_mean,turnaround_mean"
+
+void display_metrics(FILE *out, Process processes[], int num_processes, SimResult *result);
+void display_metrics_table(FILE *out, Process processes[], int num_processes, SimResult *result);
+void display_stream_header(FILE *out, const char *title);
+void display_stream_row(FILE *out, Process *process);
+void display_stream_summary(FILE *out, long long completed, int peak_active, SimResult *result,
+                            const GroupTree *groups);
+void display_ensemble(FILE *out, EnsembleSpec *spec, EnsembleResult results[]);
+void display_sweep(FILE *out, SweepSpec *spec, SweepCell cells[], int num_cells, int restarts);
+void display_import_summary(FILE *out, ImportSummary *summary);
+void display_sort_summary(FILE *out, ExtsortSummary *summary);
+void display_report(ReportWriter *report, Process processes[], int num_processes,
+                    const char *algorithm, int time_quantum, SimResult *result);
+void display_report_process(ReportWriter *report, Process *process);
+void display_report_summary(ReportWriter *report, const char *algorithm, int time_quantum,
+                            long long completed, int peak_active, SimResult *result);
+void display_report_groups(ReportWriter *report, const GroupTree *groups, long long end_time);
+void display_gantt(FILE *out, Process processes[], int num_processes, Timeline *timeline, int colour);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,677 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   ensemble.c
+/
+/  File Description:
+/    This file implements the Monte Carlo ensemble runner. A single
+/    run on a single workload says little when arrivals are random,
+/    so an ensemble generates many independent workloads from the
+/    same distributions, runs each through the selected algorithms,
+/    and reports the mean of every metric with a 95% confidence
+/    interval.
+/
+/    Replications are spread across a pool of worker threads. Each
+/    worker starts with an equal share of them in its own deque and
+/    takes work from the back of it; a worker that runs out steals
+/    from the front of another's, so a few slow replications do not
+/    leave the other threads idle. Every replication draws from its
+/    own random stream, derived from the seed and its number, and
+/    writes its metrics to its own slot. The slots are summarized in
+/    replication order once all threads are done, so the results are
+/    identical whatever the number of threads.
+/
+/    Each workload is run through every algorithm, so the algorithms
+/    are compared on the same workloads.
+/
+/    Besides the per-run estimates, each worker merges the latency
+/    histograms of its runs, one set per algorithm, and the workers'
+/    sets are merged once they are done. A tail percentile of the
+/    merged set is taken over every process of every replication,
+/    which the mean of each run's percentile is not. Merging only
+/    adds counts, so it too is the same whatever the number of
+/    threads.
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "process.h"
+#include "globals.h"
+#include "histogram.h"
+#include "simulator.h"
+#include "arena.h"
+#include "ensemble.h"
+
+/*---------- STRUCTURE: WorkDeque --------------------------
+/  Structure Description:
+/    One worker's share of the replications. The owner takes from
+/    the tail and thieves take from the head.
+/
+/  Fields:
+/    int *tasks
+/      Replication numbers
+/    int head, tail
+/      The deque holds tasks[head] up to tasks[tail - 1]
+/    pthread_mutex_t lock
+/      Guards head and tail
+/
+/  Relationships:
+/    - one per worker in an EnsemblePool
+/---------------------------------------------------------*/
+typedef struct {
+    int *tasks;
+    int head;
+    int tail;
+    pthread_mutex_t lock;
+} WorkDeque;
+
+/*---------- STRUCTURE: EnsemblePool -----------------------
+/  Structure Description:
+/    State shared by the worker threads of one ensemble.
+/
+/  Fields:
+/    EnsembleSpec *spec
+/      The ensemble being run
+/    WorkDeque *deques
+/      One deque per worker
+/    int num_workers
+/      Number of worker threads
+/    double *samples
+/      Metrics of each replication, indexed by replication, then
+/      algorithm, then metric
+/    LatencyHistograms *latency
+/      The merged latency histograms of each worker's runs, indexed
+/      by worker, then algorithm
+/
+/  Relationships:
+/    - contains one WorkDeque per worker
+/---------------------------------------------------------*/
+typedef struct {
+    EnsembleSpec *spec;
+    WorkDeque *deques;
+    int num_workers;
+    double *samples;
+    LatencyHistograms *latency;
+} EnsemblePool;
+
+/*---------- STRUCTURE: Worker -----------------------------
+/  Structure Description:
+/    The argument handed to each worker thread.
+/
+/  Fields:
+/    EnsemblePool *pool
+/      The pool the worker belongs to
+/    int id
+/      Index of the worker's own deque
+/    int failed
+/      Set by the worker if one of its runs failed
+/
+/  Relationships:
+/    - points to an EnsemblePool
+/---------------------------------------------------------*/
+typedef struct {
+    EnsemblePool *pool;
+    int id;
+    int failed;
+} Worker;
+
+void *ensemble_worker(void *arg);
+int ensemble_take(EnsemblePool *pool, int id);
+int run_replication(EnsemblePool *pool, int replication, LatencyHistograms *latency);
+void summarize_samples(EnsembleSpec *spec, double *samples, EnsembleResult results[]);
+void pool_latency(EnsemblePool *pool, EnsembleResult results[]);
+double t_critical(int df);
+unsigned long long splitmix64(unsigned long long *state);
+unsigned long long rng_next(Rng *rng);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: init_ensemble_spec ------------------
+/  Function Description:
+/    Sets a spec to its defaults: 100 replications on one thread per
+/    CPU, seed 1, MAX_PROCESSES processes arriving every 4 time units
+/    on average with a mean burst of 5, priorities 1 to 5, FCFS only,
+/    and a time quantum of 1.
+/
+/  Caller Input:
+/    EnsembleSpec *spec: the spec to initialize
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void init_ensemble_spec(EnsembleSpec *spec) {
+    memset(spec, 0, sizeof(EnsembleSpec));
+    spec->replications = 100;
+    spec->threads = 0;
+    spec->seed = 1;
+    spec->num_processes = MAX_PROCESSES;
+    spec->mean_gap = 4.0;
+    spec->mean_burst = 5.0;
+    spec->max_priority = 5;
+    spec->num_algorithms = 1;
+    strcpy(spec->algorithms[0], "FCFS");
+    spec->time_quantum = 1;
+}
+
+/*---------- FUNCTION: run_ensemble ------------------------
+/  Function Description:
+/    Runs the ensemble described by spec and fills in one result per
+/    algorithm, in the order the algorithms appear in the spec.
+/
+/  Caller Input:
+/    EnsembleSpec *spec: the ensemble to run
+/    EnsembleResult results[]: room for spec->num_algorithms results
+/
+/  Caller Output:
+/    0 on success, 1 on failure
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - errors are printed to stderr
+/    - needs at least 2 replications for a confidence interval
+/    - the runs are silent; no trace or time series is written
+/    - if fewer worker threads start than asked for, the ones that did
+/      run every replication
+/---------------------------------------------------------*/
+int run_ensemble(EnsembleSpec *spec, EnsembleResult results[]) {
+    EnsemblePool pool;
+    pthread_t *threads;
+    Worker *workers;
+    int num_workers = spec->threads;
+    int num_started = 0;
+    int per_worker;
+    int failed = 0;
+
+    if (spec->replications < 2) {
+        fprintf(stderr, "Error: an ensemble needs at least 2 replications.\n");
+        return 1;
+    }
+    if (spec->num_processes < 1 || spec->num_processes > ENSEMBLE_MAX_PROCESSES) {
+        fprintf(stderr, "Error: invalid number of processes.\n");
+        return 1;
+    }
+    if (spec->num_algorithms < 1 || spec->num_algorithms > ENSEMBLE_MAX_ALGORITHMS) {
+        fprintf(stderr, "Error: invalid number of algorithms.\n");
+        return 1;
+    }
+    if (spec->mean_gap < 0 || spec->mean_burst < 1 || spec->max_priority < 1) {
+        fprintf(stderr, "Error: invalid workload parameters.\n");
+        return 1;
+    }
+
+    if (num_workers < 1) {
+        num_workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_workers < 1) num_workers = 1;
+    }
+    if (num_workers > spec->replications) num_workers = spec->replications;
+
+    pool.spec = spec;
+    pool.num_workers = num_workers;
+    pool.samples = malloc((size_t)spec->replications * spec->num_algorithms * ENSEMBLE_METRICS * sizeof(double));
+    pool.latency = malloc((size_t)num_workers * spec->num_algorithms * sizeof(LatencyHistograms));
+    pool.deques = malloc(num_workers * sizeof(WorkDeque));
+    threads = malloc(num_workers * sizeof(pthread_t));
+    workers = malloc(num_workers * sizeof(Worker));
+    if (pool.samples == NULL || pool.latency == NULL || pool.deques == NULL || threads == NULL || workers == NULL) {
+        fprintf(stderr, "Error: out of memory starting the ensemble.\n");
+        free(pool.samples);
+        free(pool.latency);
+        free(pool.deques);
+        free(threads);
+        free(workers);
+        return 1;
+    }
+    for (int l = 0; l < num_workers * spec->num_algorithms; l++) {
+        init_latency(&pool.latency[l]);
+    }
+
+    /* deal the replications out in contiguous runs, one per worker */
+    per_worker = (spec->replications + num_workers - 1) / num_workers;
+    for (int w = 0; w < num_workers; w++) {
+        WorkDeque *deque = &pool.deques[w];
+        int first = w * per_worker;
+        int last = first + per_worker < spec->replications ? first + per_worker : spec->replications;
+
+        deque->tasks = malloc((per_worker > 0 ? per_worker : 1) * sizeof(int));
+        if (deque->tasks == NULL) {
+            fprintf(stderr, "Error: out of memory starting the ensemble.\n");
+            while (--w >= 0) {
+                pthread_mutex_destroy(&pool.deques[w].lock);
+                free(pool.deques[w].tasks);
+            }
+            free(pool.deques);
+            free(pool.samples);
+            free(pool.latency);
+            free(threads);
+            free(workers);
+            return 1;
+        }
+        deque->head = 0;
+        deque->tail = 0;
+        for (int r = first; r < last; r++) {
+            deque->tasks[deque->tail++] = r;
+        }
+        pthread_mutex_init(&deque->lock, NULL);
+    }
+
+    for (int w = 0; w < num_workers; w++) {
+        workers[w].pool = &pool;
+        workers[w].id = w;
+        workers[w].failed = 0;
+        if (pthread_create(&threads[w], NULL, ensemble_worker, &workers[w]) != 0) break;
+        num_started++;
+    }
+    /* the workers steal from every deque, so those that started do all of the work */
+    if (num_started == 0) {
+        fprintf(stderr, "Error: could not start worker thread.\n");
+        failed = 1;
+    }
+    for (int w = 0; w < num_started; w++) {
+        pthread_join(threads[w], NULL);
+        failed |= workers[w].failed;
+    }
+
+    if (!failed) {
+        summarize_samples(spec, pool.samples, results);
+        pool_latency(&pool, results);
+    }
+
+    for (int w = 0; w < num_workers; w++) {
+        pthread_mutex_destroy(&pool.deques[w].lock);
+        free(pool.deques[w].tasks);
+    }
+    free(pool.deques);
+    free(pool.samples);
+    free(pool.latency);
+    free(threads);
+    free(workers);
+
+    return failed;
+}
+
+/*---------- FUNCTION: ensemble_metric_name ----------------
+/  Function Description:
+/    Returns the display name of one of the ensemble's metrics.
+/
+/  Caller Input:
+/    int metric: 0 to ENSEMBLE_METRICS - 1
+/
+/  Caller Output:
+/    The name, or NULL if metric is out of range
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+const char *ensemble_metric_name(int metric) {
+    static const char *names[ENSEMBLE_METRICS] = {
+        "Average Waiting Time", "Average Turnaround Time", "Average Response Time",
+        "Throughput", "CPU Utilization (%)",
+        "Turnaround p50", "Turnaround p90", "Turnaround p99", "Turnaround p99.9",
+        "Waiting p50", "Waiting p90", "Waiting p99", "Waiting p99.9",
+        "Response p50", "Response p90", "Response p99", "Response p99.9"
+    };
+
+    if (metric < 0 || metric >= ENSEMBLE_METRICS) return NULL;
+    return names[metric];
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions generate random workloads.
+/
+/  Functions and Their Purpose:
+/    - rng_seed: Seeds a generator for one stream of a seed. Streams
+/      of the same seed are statistically independent, so each
+/      replication uses its number as its stream.
+/    - rng_uniform: Returns a number uniformly distributed in [0, 1).
+/    - generate_workload: Fills processes with spec->num_processes
+/      processes named 1, 2, ... whose arrival gaps and burst times
+/      are exponentially distributed with the spec's means, and whose
+/      priorities are uniform from 1 to spec->max_priority. The first
+/      process arrives at time 0.
+/
+/  Input Parameters:
+/    - Rng *rng: the generator
+/    - unsigned long long seed, stream: what to seed it from
+/    - EnsembleSpec *spec: the workload's parameters
+/    - Process processes[]: room for spec->num_processes processes
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - times are rounded up to whole units, so the mean burst is about
+/      half a unit more than requested
+/    - generates at most ENSEMBLE_MAX_PROCESSES processes, whose 
+/      numbers fit in an ID
+/------------------------------------------------------------------------*/
+void rng_seed(Rng *rng, unsigned long long seed, unsigned long long stream) {
+    unsigned long long state = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&state);
+    }
+}
+
+double rng_uniform(Rng *rng) {
+    /* the top 53 bits fill a double's mantissa exactly */
+    return (rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void generate_workload(Rng *rng, EnsembleSpec *spec, Process processes[]) {
+    double arrival = 0;
+
+    for (int i = 0; i < spec->num_processes && i < ENSEMBLE_MAX_PROCESSES; i++) {
+        long long burst;
+
+        if (i > 0) {
+            arrival += -spec->mean_gap * log(1.0 - rng_uniform(rng));
+        }
+        burst = (long long)ceil(-spec->mean_burst * log(1.0 - rng_uniform(rng)));
+
+        snprintf(processes[i].id, sizeof(processes[i].id), "%d", i + 1);
+        processes[i].arrival_time = (long long)arrival;
+        processes[i].burst_time = burst > 0 ? burst : 1;
+        processes[i].priority = 1 + (int)(rng_uniform(rng) * spec->max_priority);
+        reset_process(&processes[i], i);
+    }
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions turn runs into estimates. They are also used by
+/    the sweep executor, which gathers its samples from other
+/    processes.
+/
+/  Functions and Their Purpose:
+/    - ensemble_record: Copies a run's metrics into a sample of
+/      ENSEMBLE_METRICS values, in the order given by
+/      ensemble_metric_name.
+/    - ensemble_estimate: Estimates one metric from count samples
+/      found stride values apart, visiting them in order. The
+/      interval is the mean plus or minus t * s / sqrt(count), from
+/      Student's t distribution with count - 1 degrees of freedom.
+/
+/  Input Parameters:
+/    - double *sample: where to store the run's metrics
+/    - SimResult *result: a finished run
+/    - const double *samples: the first sample of the metric
+/    - int count: the number of samples (at least 2)
+/    - size_t stride: the distance between samples
+/    - Estimate *estimate: the estimate to fill in
+/
+/  Output:
+/    - N/A - the sample or estimate is filled in
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the interval assumes the replication means are roughly normal,
+/      which holds for a few dozen replications or more
+/------------------------------------------------------------------------*/
+void ensemble_record(double *sample, SimResult *result) {
+    const Histogram *hists[3] = {&result->latency.turnaround, &result->latency.waiting, &result->latency.response};
+    const double percentiles[4] = {50.0, 90.0, 99.0, 99.9};
+    int m = 0;
+
+    sample[m++] = result->waiting.mean;
+    sample[m++] = result->turnaround.mean;
+    sample[m++] = result->response.mean;
+    sample[m++] = result->throughput;
+    sample[m++] = result->cpu_utilization;
+    for (int h = 0; h < 3; h++) {
+        for (int p = 0; p < 4; p++) {
+            sample[m++] = (double)hist_percentile(hists[h], percentiles[p]);
+        }
+    }
+}
+
+void ensemble_estimate(const double *samples, int count, size_t stride, Estimate *estimate) {
+    double sum = 0;
+    double squares = 0;
+    double half_width;
+
+    for (int r = 0; r < count; r++) {
+        sum += samples[r * stride];
+    }
+    estimate->mean = sum / count;
+    for (int r = 0; r < count; r++) {
+        double d = samples[r * stride] - estimate->mean;
+        squares += d * d;
+    }
+
+    estimate->stddev = count > 1 ? sqrt(squares / (count - 1)) : 0;
+    half_width = t_critical(count - 1) * estimate->stddev / sqrt((double)count);
+    estimate->low = estimate->mean - half_width;
+    estimate->high = estimate->mean + half_width;
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions make up the thread pool.
+/
+/  Functions and Their Purpose:
+/    - ensemble_worker: A worker thread's body. Runs replications until
+/      there are none left in any deque, then frees its arena.
+/    - ensemble_take: Takes the next replication for worker id: the
+/      last of its own, or else the first of another worker's,
+/      trying them in turn. Returns -1 when every deque is empty.
+/
+/  Input Parameters:
+/    - void *arg: the thread's Worker
+/    - EnsemblePool *pool: the pool
+/    - int id: the worker's index
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - no work is added once the threads start, so a worker that finds
+/      every deque empty can exit
+/------------------------------------------------------------------------*/
+void *ensemble_worker(void *arg) {
+    Worker *worker = (Worker *)arg;
+    EnsemblePool *pool = worker->pool;
+    LatencyHistograms *latency = pool->latency + (size_t)worker->id * pool->spec->num_algorithms;
+    int replication;
+
+    while ((replication = ensemble_take(pool, worker->id)) >= 0) {
+        if (run_replication(pool, replication, latency) != 0) {
+            worker->failed = 1;
+        }
+    }
+
+    thread_arena_free();
+    return NULL;
+}
+
+int ensemble_take(EnsemblePool *pool, int id) {
+    WorkDeque *own = &pool->deques[id];
+    int task = -1;
+
+    pthread_mutex_lock(&own->lock);
+    if (own->tail > own->head) {
+        task = own->tasks[--own->tail];
+    }
+    pthread_mutex_unlock(&own->lock);
+
+    for (int v = 1; task < 0 && v < pool->num_workers; v++) {
+        WorkDeque *victim = &pool->deques[(id + v) % pool->num_workers];
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->tail > victim->head) {
+            task = victim->tasks[victim->head++];
+        }
+        pthread_mutex_unlock(&victim->lock);
+    }
+
+    return task;
+}
+
+/*---------- FUNCTION: run_replication ---------------------
+/  Function Description:
+/    Generates one replication's workload and runs it through each
+/    of the spec's algorithms, storing their metrics in the
+/    replication's slots of the samples array and merging their
+/    latency histograms into the worker's.
+/
+/  Caller Input:
+/    EnsemblePool *pool: the pool
+/    int replication: the replication's number
+/    LatencyHistograms *latency: the worker's histograms, one per
+/      algorithm
+/
+/  Caller Output:
+/    0 on success, 1 if a run failed or memory ran out
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the runs use the calling thread's arena
+/    - the workload and its working copy are allocated for each 
+/      replication, as they may be too large for the stack
+/---------------------------------------------------------*/
+int run_replication(EnsemblePool *pool, int replication, LatencyHistograms *latency) {
+    EnsembleSpec *spec = pool->spec;
+    Process *workload = malloc(2 * (size_t)spec->num_processes * sizeof(Process));
+    Process *processes = workload + spec->num_processes;
+    SimContext ctx;
+    Rng rng;
+    int status = 0;
+
+    if (workload == NULL) {
+        fprintf(stderr, "Error: out of memory.\n");
+        return 1;
+    }
+    rng_seed(&rng, spec->seed, (unsigned long long)replication);
+    generate_workload(&rng, spec, workload);
+
+    init_sim_context(&ctx);
+    ctx.processes = processes;
+    ctx.num_processes = spec->num_processes;
+    ctx.time_quantum = spec->time_quantum;
+
+    for (int a = 0; a < spec->num_algorithms; a++) {
+        /* each run sorts and updates the processes, so start from a copy */
+        memcpy(processes, workload, spec->num_processes * sizeof(Process));
+        strcpy(ctx.algorithm, spec->algorithms[a]);
+        if (sim_run(&ctx) != 0) {
+            status = 1;
+            break;
+        }
+        ensemble_record(pool->samples + ((size_t)replication * spec->num_algorithms + a) * ENSEMBLE_METRICS,
+                        &ctx.result);
+        merge_latency(&latency[a], &ctx.result.latency);
+    }
+    free(workload);
+    return status;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    Helpers for the estimates.
+/
+/  Functions and Their Purpose:
+/    - summarize_samples: Computes each algorithm's estimates from
+/      the samples of an ensemble.
+/    - pool_latency: Merges every worker's latency histograms into
+/      the result of each algorithm, in worker order.
+/    - t_critical: The two-sided 95% critical value of Student's t.
+/      Exact values are tabulated up to 30 degrees of freedom; above
+/      that a series expansion about the normal value is used, which
+/      is accurate to the printed precision.
+/
+/  Input Parameters:
+/    - EnsembleSpec *spec: the ensemble
+/    - double *samples: every replication's metrics
+/    - EnsemblePool *pool: the pool, its workers finished
+/    - EnsembleResult results[]: one per algorithm, to fill in
+/    - int df: degrees of freedom
+/
+/  Output:
+/    - t_critical returns the critical value
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+void summarize_samples(EnsembleSpec *spec, double *samples, EnsembleResult results[]) {
+    size_t stride = (size_t)spec->num_algorithms * ENSEMBLE_METRICS;
+
+    for (int a = 0; a < spec->num_algorithms; a++) {
+        strcpy(results[a].algorithm, spec->algorithms[a]);
+
+        for (int m = 0; m < ENSEMBLE_METRICS; m++) {
+            ensemble_estimate(samples + (size_t)a * ENSEMBLE_METRICS + m, spec->replications, stride,
+                              &results[a].metrics[m]);
+        }
+    }
+}
+
+void pool_latency(EnsemblePool *pool, EnsembleResult results[]) {
+    int num_algorithms = pool->spec->num_algorithms;
+
+    for (int a = 0; a < num_algorithms; a++) {
+        init_latency(&results[a].latency);
+        for (int w = 0; w < pool->num_workers; w++) {
+            merge_latency(&results[a].latency, &pool->latency[(size_t)w * num_algorithms + a]);
+        }
+    }
+}
+
+double t_critical(int df) {
+    static const double table[31] = {
+        0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+        2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093,
+        2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045,
+        2.042
+    };
+    const double z = 1.959964;
+
+    if (df < 1) return 0;
+    if (df <= 30) return table[df];
+    return z + (z * z * z + z) / (4.0 * df)
+             + (5 * pow(z, 5) + 16 * z * z * z + 3 * z) / (96.0 * df * df);
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    The random number generators.
+/
+/  Functions and Their Purpose:
+/    - splitmix64: Advances a SplitMix64 state and returns its output.
+/      Used only to spread a seed over the xoshiro state.
+/    - rng_next: Returns the next 64-bit output of xoshiro256**.
+/
+/  Input Parameters:
+/    - unsigned long long *state: the SplitMix64 state
+/    - Rng *rng: the xoshiro256** generator
+/
+/  Output:
+/    - 64 random bits
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+unsigned long long splitmix64(unsigned long long *state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+unsigned long long rng_next(Rng *rng) {
+    unsigned long long *s = rng->s;
+    unsigned long long result = ((s[1] * 5) << 7 | (s[1] * 5) >> 57) * 9;
+    unsigned long long t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+    return result;
+}
@@ -0,0 +1,140 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   ensemble.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <stddef.h>
+#include "process.h"
+#include "histogram.h"
+#include "simulator.h"
+
+#define ENSEMBLE_MAX_ALGORITHMS 6
+#define ENSEMBLE_MAX_PROCESSES 1000000
+#define ENSEMBLE_METRICS 17
+
+/*---------- STRUCTURE: EnsembleSpec -----------------------
+/  Structure Description:
+/    Describes a Monte Carlo ensemble: how workloads are generated,
+/    how many are run, on how many threads, and through which
+/    algorithms.
+/
+/  Fields:
+/    int replications
+/      Number of independent workloads to generate and run
+/    int threads
+/      Worker threads to spread them across, or 0 for one per CPU
+/    unsigned long long seed
+/      Seed from which every replication's random stream is derived
+/    int num_processes
+/      Processes in each generated workload (at most 
+/      ENSEMBLE_MAX_PROCESSES, so that their numbers fit in an ID)
+/    double mean_gap
+/      Mean time between arrivals (exponentially distributed)
+/    double mean_burst
+/      Mean burst time (exponentially distributed, at least 1)
+/    int max_priority
+/      Priorities are drawn uniformly from 1 to max_priority
+/    int num_algorithms
+/      Number of entries in algorithms
+/    char algorithms[][8]
+/      The algorithms each workload is run through
+/    int time_quantum
+/      Time slice used by RR
+/
+/  Relationships:
+/    - read by run_ensemble
+/---------------------------------------------------------*/
+typedef struct {
+    int replications;
+    int threads;
+    unsigned long long seed;
+    int num_processes;
+    double mean_gap;
+    double mean_burst;
+    int max_priority;
+    int num_algorithms;
+    char algorithms[ENSEMBLE_MAX_ALGORITHMS][8];
+    int time_quantum;
+} EnsembleSpec;
+
+/*---------- STRUCTURE: Estimate ---------------------------
+/  Structure Description:
+/    The estimate of one metric across the replications of an
+/    ensemble.
+/
+/  Fields:
+/    double mean
+/      Sample mean over the replications
+/    double stddev
+/      Sample standard deviation over the replications
+/    double low, high
+/      Bounds of the 95% confidence interval for the mean
+/
+/  Relationships:
+/    - contained in EnsembleResult
+/---------------------------------------------------------*/
+typedef struct {
+    double mean;
+    double stddev;
+    double low;
+    double high;
+} Estimate;
+
+/*---------- STRUCTURE: EnsembleResult ---------------------
+/  Structure Description:
+/    The estimates of every metric for one algorithm. The metrics
+/    are those of the metrics summary and the latency percentiles
+/    table, in the order given by ensemble_metric_name.
+/
+/  Fields:
+/    char algorithm[8]
+/      The algorithm the estimates are for
+/    Estimate metrics[ENSEMBLE_METRICS]
+/      One estimate per metric
+/    LatencyHistograms latency
+/      The latency histograms of every run, merged
+/
+/  Relationships:
+/    - filled in by run_ensemble, one per algorithm of the spec
+/---------------------------------------------------------*/
+typedef struct {
+    char algorithm[8];
+    Estimate metrics[ENSEMBLE_METRICS];
+    LatencyHistograms latency;
+} EnsembleResult;
+
+/*---------- STRUCTURE: Rng --------------------------------
+/  Structure Description:
+/    State of a xoshiro256** pseudo-random generator. Each
+/    replication seeds its own, so the numbers it draws do not
+/    depend on which thread runs it or in what order.
+/
+/  Fields:
+/    unsigned long long s[4]
+/      Generator state
+/
+/  Relationships:
+/    - used by generate_workload
+/---------------------------------------------------------*/
+typedef struct {
+    unsigned long long s[4];
+} Rng;
+
+void init_ensemble_spec(EnsembleSpec *spec);
+int run_ensemble(EnsembleSpec *spec, EnsembleResult results[]);
+const char *ensemble_metric_name(int metric);
+void rng_seed(Rng *rng, unsigned long long seed, unsigned long long stream);
+double rng_uniform(Rng *rng);
+void generate_workload(Rng *rng, EnsembleSpec *spec, Process processes[]);
+void ensemble_record(double *sample, SimResult *result);
+void ensemble_estimate(const double *samples, int count, size_t stride, Estimate *estimate);
+
+#endif
@@ -0,0 +1,670 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   extsort.c
+/
+/  File Description:
+/    This file implements an external merge sort of a workload by
+/    arrival time, for the streaming simulator, which needs its input
+/    in arrival order. The sorted workload is read through an ordinary
+/    FILE, in the same "id arrival burst [priority]" format, so the
+/    simulator reads it as it would the original.
+/
+/    The input is read into a buffer of a fixed size. Each time the
+/    buffer fills it is sorted and written to a temporary file as a
+/    run; runs are merged sixteen at a time into longer runs as they
+/    pile up, and the last runs are merged as the sorted workload is
+/    read. Memory therefore stays within the buffer however long the
+/    input is, and the temporary files take about as much disk as the
+/    input itself.
+/
+/    Sorted input is found without sorting it: a regular file is
+/    checked in one pass and then read as it is, and a buffer that is
+/    already in order, and follows on from the run before it, is added
+/    to that run rather than starting a new one.
+/
+/  Citations:
+/  - Knuth, The Art of Computer Programming, Vol. 3, section 5.4,
+/    "External Sorting"
+/---------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "extsort.h"
+
+/*---------- STRUCTURE: ExtsortRecord ----------------------
+/  Structure Description:
+/    One process of the workload, as held in the buffer and written
+/    to the runs.
+/
+/  Fields:
+/    long long arrival, burst
+/      The process's arrival and burst times
+/    long long seq
+/      Position of the process in the input, to keep processes that
+/      arrive together in input order
+/    int priority
+/      The process's priority, or -1 if it was not read
+/    char id[12]
+/      The process's ID
+/
+/  Relationships:
+/    - held in Sorter's buffer, the runs and ExtsortMerge
+/---------------------------------------------------------*/
+typedef struct {
+    long long arrival;
+    long long burst;
+    long long seq;
+    int priority;
+    char id[12];
+} ExtsortRecord;
+
+/*---------- STRUCTURE: ExtsortRun -------------------------
+/  Structure Description:
+/    A sorted run in a temporary file.
+/
+/  Fields:
+/    FILE *fp
+/      The temporary file
+/    int level
+/      0 for a run written from the buffer, or one more than the
+/      level of the runs merged to make it
+/    ExtsortRecord last
+/      The run's last record
+/
+/  Relationships:
+/    - held in Sorter's stack of runs
+/---------------------------------------------------------*/
+typedef struct {
+    FILE *fp;
+    int level;
+    ExtsortRecord last;
+} ExtsortRun;
+
+/*---------- STRUCTURE: ExtsortMerge -----------------------
+/  Structure Description:
+/    A k-way merge of runs.
+/
+/  Fields:
+/    FILE *inputs[]
+/      The runs being merged
+/    ExtsortRecord heads[]
+/      The next record of each run
+/    int heap[], int size
+/      Runs with records left, a min-heap by their next record
+/
+/  Relationships:
+/    - reads ExtsortRuns
+/---------------------------------------------------------*/
+typedef struct {
+    FILE *inputs[EXTSORT_MAX_RUNS];
+    ExtsortRecord heads[EXTSORT_MAX_RUNS];
+    int heap[EXTSORT_MAX_RUNS];
+    int size;
+} ExtsortMerge;
+
+/*---------- STRUCTURE: Sorter -----------------------------
+/  Structure Description:
+/    The state of one sort, behind the FILE it is read through.
+/
+/  Fields:
+/    FILE *in
+/      The unsorted workload
+/    int with_priority
+/      1 to read and write a priority for each process
+/    ExtsortSummary *summary
+/      Filled in as the input is sorted
+/    ExtsortRecord *buffer, size_t capacity, count, next
+/      The buffer, its size, the records in it, and (if no run was
+/      written) the next one to be read out
+/    int buffer_sorted
+/      1 while the records in the buffer are in order
+/    ExtsortRun runs[], int num_runs
+/      The runs written so far, as a stack; levels never increase
+/      towards the top
+/    ExtsortMerge merge
+/      The final merge of the runs
+/    char pending[], int pending_len, pending_pos
+/      The workload line being written out
+/
+/  Relationships:
+/    - contains ExtsortRecords, ExtsortRuns and an ExtsortMerge
+/---------------------------------------------------------*/
+typedef struct {
+    FILE *in;
+    int with_priority;
+    ExtsortSummary *summary;
+    ExtsortRecord *buffer;
+    size_t capacity;
+    size_t count;
+    size_t next;
+    int buffer_sorted;
+    ExtsortRun runs[EXTSORT_MAX_RUNS];
+    int num_runs;
+    ExtsortMerge merge;
+    char pending[80];
+    int pending_len;
+    int pending_pos;
+} Sorter;
+
+ssize_t extsort_read(void *cookie, char *buf, size_t size);
+int extsort_close(void *cookie);
+int extsort_in_order(FILE *in, int with_priority, ExtsortSummary *summary);
+int extsort_record(FILE *in, int with_priority, ExtsortRecord *record);
+int extsort_fill(Sorter *sorter);
+int extsort_spill(Sorter *sorter);
+int extsort_collapse(Sorter *sorter);
+int extsort_new_run(Sorter *sorter, int level);
+int extsort_write(Sorter *sorter, ExtsortRun *run, const ExtsortRecord *records, size_t count);
+FILE *extsort_tmpfile();
+void merge_start(ExtsortMerge *merge, ExtsortRun runs[], int k);
+int merge_next(ExtsortMerge *merge, ExtsortRecord *record);
+void merge_sift_down(ExtsortMerge *merge, int i);
+int record_before(const ExtsortRecord *a, const ExtsortRecord *b);
+int compare_record(const void *a, const void *b);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: extsort_open ------------------------
+/  Function Description:
+/    Sorts a workload by arrival time, returning a stream that reads
+/    as the sorted workload. The input is read to its end and the runs
+/    written before this returns; the final merge happens as the
+/    stream is read.
+/
+/  Caller Input:
+/    FILE *in: the workload, one "id arrival burst [priority]" per
+/      line, in any order
+/    int with_priority: 1 to read and write each process's priority
+/    size_t memory: bytes of buffer to sort in
+/    ExtsortSummary *summary: filled in
+/
+/  Caller Output:
+/    The stream, or NULL if the input is malformed, a temporary file
+/    could not be written or memory runs out. If the input was
+/    already sorted and is a regular file, the stream is in itself,
+/    wound back to where it was; otherwise closing the stream closes
+/    in too, unless in is stdin.
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - uses the GNU fopencookie extension
+/    - processes that arrive together keep their input order
+/    - temporary files are made in $TMPDIR (or /tmp) and removed as
+/      soon as they are made, so nothing is left behind
+/    - a workload of more than EXTSORT_FAN_IN ^ (EXTSORT_MAX_RUNS /
+/      (EXTSORT_FAN_IN - 1)) buffers is an error
+/---------------------------------------------------------*/
+FILE *extsort_open(FILE *in, int with_priority, size_t memory, ExtsortSummary *summary) {
+    cookie_io_functions_t io = {extsort_read, NULL, NULL, extsort_close};
+    Sorter *sorter;
+    FILE *stream;
+
+    memset(summary, 0, sizeof(ExtsortSummary));
+    if (extsort_in_order(in, with_priority, summary)) {
+        return in;
+    }
+
+    sorter = calloc(1, sizeof(Sorter));
+    if (sorter == NULL) {
+        fprintf(stderr, "Error: out of memory sorting the input.\n");
+        return NULL;
+    }
+    sorter->in = in;
+    sorter->with_priority = with_priority;
+    sorter->summary = summary;
+    sorter->capacity = memory / sizeof(ExtsortRecord);
+    if (sorter->capacity < 1) sorter->capacity = 1;
+    sorter->buffer = malloc(sorter->capacity * sizeof(ExtsortRecord));
+    if (sorter->buffer == NULL) {
+        fprintf(stderr, "Error: out of memory sorting the input.\n");
+        free(sorter);
+        return NULL;
+    }
+
+    if (extsort_fill(sorter) != 0) {
+        for (int r = 0; r < sorter->num_runs; r++) fclose(sorter->runs[r].fp);
+        free(sorter->buffer);
+        free(sorter);
+        return NULL;
+    }
+    if (sorter->num_runs > 0) {
+        merge_start(&sorter->merge, sorter->runs, sorter->num_runs);
+    }
+
+    stream = fopencookie(sorter, "r", io);
+    if (stream == NULL) {
+        for (int r = 0; r < sorter->num_runs; r++) fclose(sorter->runs[r].fp);
+        free(sorter->buffer);
+        free(sorter);
+    }
+    return stream;
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions are the stream behind extsort_open.
+/
+/  Functions and Their Purpose:
+/    - extsort_read: Fills buf with workload lines, taking each record
+/      from the buffer if nothing was written to disk, or from the
+/      final merge otherwise.
+/    - extsort_close: Closes the runs and the input, and frees the
+/      sorter.
+/
+/  Input Parameters:
+/    - void *cookie: the Sorter
+/    - char *buf, size_t size: where to put the workload
+/
+/  Output:
+/    - extsort_read: bytes read, or 0 at the end
+/    - extsort_close: 0
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+ssize_t extsort_read(void *cookie, char *buf, size_t size) {
+    Sorter *sorter = cookie;
+    size_t copied = 0;
+
+    while (copied < size) {
+        ExtsortRecord record;
+        size_t chunk;
+
+        if (sorter->pending_pos < sorter->pending_len) {
+            chunk = sorter->pending_len - sorter->pending_pos;
+            if (chunk > size - copied) chunk = size - copied;
+            memcpy(buf + copied, sorter->pending + sorter->pending_pos, chunk);
+            sorter->pending_pos += chunk;
+            copied += chunk;
+            continue;
+        }
+
+        if (sorter->num_runs == 0) {
+            if (sorter->next == sorter->count) break;
+            record = sorter->buffer[sorter->next++];
+        } else if (merge_next(&sorter->merge, &record) != 1) {
+            break;
+        }
+
+        if (sorter->with_priority) {
+            sorter->pending_len = snprintf(sorter->pending, sizeof(sorter->pending), "%s %lld %lld %d\n",
+                                           record.id, record.arrival, record.burst, record.priority);
+        } else {
+            sorter->pending_len = snprintf(sorter->pending, sizeof(sorter->pending), "%s %lld %lld\n",
+                                           record.id, record.arrival, record.burst);
+        }
+        sorter->pending_pos = 0;
+    }
+    return copied;
+}
+
+int extsort_close(void *cookie) {
+    Sorter *sorter = cookie;
+
+    for (int r = 0; r < sorter->num_runs; r++) {
+        fclose(sorter->runs[r].fp);
+    }
+    if (sorter->in != stdin) fclose(sorter->in);
+    free(sorter->buffer);
+    free(sorter);
+    return 0;
+}
+
+/*---------- FUNCTION: extsort_in_order --------------------
+/  Function Description:
+/    Checks whether a workload in a regular file is already sorted by
+/    arrival time, reading it through once and then winding it back.
+/
+/  Caller Input:
+/    FILE *in: the workload
+/    int with_priority: 1 if each line has a priority
+/    ExtsortSummary *summary: filled in if the workload is sorted
+/
+/  Caller Output:
+/    1 if the workload is sorted, 0 if it is not or in is not a
+/    regular file
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the check stops at a malformed line and counts what came before
+/      it as sorted, so the line is reported where it is read next
+/---------------------------------------------------------*/
+int extsort_in_order(FILE *in, int with_priority, ExtsortSummary *summary) {
+    struct stat info;
+    ExtsortRecord record;
+    long long previous = 0;
+    long long records = 0;
+    int disordered = 0;
+    off_t start;
+
+    if (fstat(fileno(in), &info) != 0 || !S_ISREG(info.st_mode)) return 0;
+    start = ftello(in);
+    if (start < 0) return 0;
+
+    while (extsort_record(in, with_priority, &record) == 1) {
+        if (records > 0 && record.arrival < previous) {
+            disordered = 1;
+            break;
+        }
+        previous = record.arrival;
+        records++;
+    }
+    clearerr(in);
+    fseeko(in, start, SEEK_SET);
+    if (disordered) return 0;
+
+    summary->records = records;
+    summary->sorted = 1;
+    return 1;
+}
+
+/*---------- FUNCTION: extsort_record ----------------------
+/  Function Description:
+/    Reads the next process of a workload, as the streaming simulator
+/    does.
+/
+/  Caller Input:
+/    FILE *in: the workload
+/    int with_priority: 1 if each line has a priority
+/    ExtsortRecord *record: filled in, apart from its seq
+/
+/  Caller Output:
+/    1 for a process, 0 at the end, -1 if the process is malformed
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+int extsort_record(FILE *in, int with_priority, ExtsortRecord *record) {
+    int vals_read;
+
+    record->priority = -1;
+    if (with_priority) {
+        vals_read = fscanf(in, "%9s %lld %lld %d", record->id, &record->arrival, &record->burst, &record->priority);
+    } else {
+        vals_read = fscanf(in, "%9s %lld %lld", record->id, &record->arrival, &record->burst);
+    }
+
+    if (vals_read == EOF) return 0;
+    if (vals_read < 3 || record->arrival < 0 || record->burst < 0) return -1;
+    return 1;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions read the input and write the runs.
+/
+/  Functions and Their Purpose:
+/    - extsort_fill: Reads the whole input, spilling the buffer each
+/      time it fills. If anything was spilled the rest of the buffer
+/      is too; otherwise it is sorted and kept.
+/    - extsort_spill: Sorts the buffer, unless it is in order, and
+/      writes it to the top run if it follows on from it, or to a new
+/      run otherwise.
+/    - extsort_collapse: Merges the top EXTSORT_FAN_IN runs into one
+/      while they share a level, so that each record is merged a
+/      number of times that grows with the log of the input's size.
+/    - extsort_new_run: Pushes an empty run onto the stack.
+/    - extsort_write: Appends records to a run.
+/    - extsort_tmpfile: Makes an unnamed temporary file.
+/
+/  Input Parameters:
+/    - Sorter *sorter: the sort
+/    - int level: the new run's level
+/    - ExtsortRun *run: the run to write to
+/    - const ExtsortRecord *records, size_t count: the records
+/
+/  Output:
+/    - extsort_tmpfile: the file, or NULL on failure
+/    - the rest: 0 on success, 1 on failure
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - errors are printed to stderr
+/------------------------------------------------------------------------*/
+int extsort_fill(Sorter *sorter) {
+    ExtsortRecord record;
+    long long seq = 0;
+    int status;
+
+    sorter->buffer_sorted = 1;
+    sorter->summary->sorted = 1;
+    while ((status = extsort_record(sorter->in, sorter->with_priority, &record)) == 1) {
+        if (sorter->count == sorter->capacity && extsort_spill(sorter) != 0) {
+            return 1;
+        }
+        if (sorter->count > 0 && record.arrival < sorter->buffer[sorter->count - 1].arrival) {
+            sorter->buffer_sorted = 0;
+        }
+        record.seq = seq++;
+        sorter->buffer[sorter->count++] = record;
+    }
+    if (status < 0) {
+        fprintf(stderr, "Error: malformed process on line %lld.\n", seq + 1);
+        return 1;
+    }
+    sorter->summary->records = seq;
+
+    if (sorter->num_runs > 0) {
+        return sorter->count > 0 ? extsort_spill(sorter) : 0;
+    }
+    if (!sorter->buffer_sorted) {
+        qsort(sorter->buffer, sorter->count, sizeof(ExtsortRecord), compare_record);
+        sorter->summary->sorted = 0;
+    }
+    return 0;
+}
+
+int extsort_spill(Sorter *sorter) {
+    ExtsortRun *top = sorter->num_runs > 0 ? &sorter->runs[sorter->num_runs - 1] : NULL;
+
+    if (!sorter->buffer_sorted) {
+        qsort(sorter->buffer, sorter->count, sizeof(ExtsortRecord), compare_record);
+        sorter->summary->sorted = 0;
+    }
+    if (top == NULL || sorter->buffer[0].arrival < top->last.arrival) {
+        if (top != NULL) sorter->summary->sorted = 0;
+        if (extsort_new_run(sorter, 0) != 0) {
+            return 1;
+        }
+        top = &sorter->runs[sorter->num_runs - 1];
+        sorter->summary->runs++;
+    }
+    if (extsort_write(sorter, top, sorter->buffer, sorter->count) != 0) {
+        return 1;
+    }
+    sorter->count = 0;
+    sorter->buffer_sorted = 1;
+    return extsort_collapse(sorter);
+}
+
+int extsort_collapse(Sorter *sorter) {
+    while (sorter->num_runs >= EXTSORT_FAN_IN) {
+        int first = sorter->num_runs - EXTSORT_FAN_IN;
+        int level = sorter->runs[first].level;
+        ExtsortRun merged;
+        ExtsortRecord record;
+
+        if (sorter->runs[sorter->num_runs - 1].level != level) break;
+
+        merged.fp = extsort_tmpfile();
+        merged.level = level + 1;
+        if (merged.fp == NULL) {
+            return 1;
+        }
+        merge_start(&sorter->merge, &sorter->runs[first], EXTSORT_FAN_IN);
+        while (merge_next(&sorter->merge, &record) == 1) {
+            if (extsort_write(sorter, &merged, &record, 1) != 0) {
+                fclose(merged.fp);
+                return 1;
+            }
+        }
+        for (int r = first; r < sorter->num_runs; r++) {
+            fclose(sorter->runs[r].fp);
+        }
+        sorter->runs[first] = merged;
+        sorter->num_runs = first + 1;
+        sorter->summary->passes++;
+    }
+    return 0;
+}
+
+int extsort_new_run(Sorter *sorter, int level) {
+    ExtsortRun *run;
+
+    if (sorter->num_runs == EXTSORT_MAX_RUNS) {
+        fprintf(stderr, "Error: the input is too large to sort.\n");
+        return 1;
+    }
+    run = &sorter->runs[sorter->num_runs];
+    run->fp = extsort_tmpfile();
+    run->level = level;
+    if (run->fp == NULL) {
+        return 1;
+    }
+    sorter->num_runs++;
+    return 0;
+}
+
+int extsort_write(Sorter *sorter, ExtsortRun *run, const ExtsortRecord *records, size_t count) {
+    if (fwrite(records, sizeof(ExtsortRecord), count, run->fp) != count) {
+        fprintf(stderr, "Error: could not write a temporary file while sorting the input.\n");
+        return 1;
+    }
+    run->last = records[count - 1];
+    sorter->summary->spilled += count * sizeof(ExtsortRecord);
+    return 0;
+}
+
+FILE *extsort_tmpfile() {
+    const char *dir = getenv("TMPDIR");
+    char path[4096];
+    FILE *fp;
+    int fd;
+
+    if (dir == NULL || dir[0] == '\0') dir = "/tmp";
+    snprintf(path, sizeof(path), "%s/sim-sort-XXXXXX", dir);
+    fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "Error: could not make a temporary file in %s while sorting the input.\n", dir);
+        return NULL;
+    }
+    unlink(path);
+
+    fp = fdopen(fd, "w+b");
+    if (fp == NULL) {
+        close(fd);
+        fprintf(stderr, "Error: could not make a temporary file in %s while sorting the input.\n", dir);
+    }
+    return fp;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions merge runs, keeping a heap of the runs by their
+/    next record so that each record costs O(log k) to merge.
+/
+/  Functions and Their Purpose:
+/    - merge_start: Winds each run back to its start and reads its
+/      first record.
+/    - merge_next: Takes the smallest next record, and reads the one
+/      after it from the same run.
+/    - merge_sift_down: Restores the heap below position i.
+/
+/  Input Parameters:
+/    - ExtsortMerge *merge: the merge
+/    - ExtsortRun runs[], int k: the runs to merge
+/    - ExtsortRecord *record: filled in with the next record
+/    - int i: a heap position
+/
+/  Output:
+/    - merge_next: 1 for a record, 0 once every run is used up
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - a run that cannot be read is treated as ending there
+/------------------------------------------------------------------------*/
+void merge_start(ExtsortMerge *merge, ExtsortRun runs[], int k) {
+    merge->size = 0;
+    for (int r = 0; r < k; r++) {
+        merge->inputs[r] = runs[r].fp;
+        fflush(runs[r].fp);
+        rewind(runs[r].fp);
+        if (fread(&merge->heads[r], sizeof(ExtsortRecord), 1, runs[r].fp) == 1) {
+            merge->heap[merge->size++] = r;
+        }
+    }
+    for (int i = merge->size / 2 - 1; i >= 0; i--) {
+        merge_sift_down(merge, i);
+    }
+}
+
+int merge_next(ExtsortMerge *merge, ExtsortRecord *record) {
+    int r;
+
+    if (merge->size == 0) return 0;
+    r = merge->heap[0];
+    *record = merge->heads[r];
+    if (fread(&merge->heads[r], sizeof(ExtsortRecord), 1, merge->inputs[r]) != 1) {
+        merge->heap[0] = merge->heap[--merge->size];
+    }
+    merge_sift_down(merge, 0);
+    return 1;
+}
+
+void merge_sift_down(ExtsortMerge *merge, int i) {
+    while (1) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        int swap;
+
+        if (left < merge->size &&
+            record_before(&merge->heads[merge->heap[left]], &merge->heads[merge->heap[smallest]])) {
+            smallest = left;
+        }
+        if (right < merge->size &&
+            record_before(&merge->heads[merge->heap[right]], &merge->heads[merge->heap[smallest]])) {
+            smallest = right;
+        }
+        if (smallest == i) return;
+
+        swap = merge->heap[i];
+        merge->heap[i] = merge->heap[smallest];
+        merge->heap[smallest] = swap;
+        i = smallest;
+    }
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions order records by arrival time, then by their
+/    position in the input.
+/
+/  Functions and Their Purpose:
+/    - record_before: 1 if a comes before b.
+/    - compare_record: The same order, for qsort.
+/
+/  Input Parameters:
+/    - a, b: the records
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+int record_before(const ExtsortRecord *a, const ExtsortRecord *b) {
+    if (a->arrival != b->arrival) return a->arrival < b->arrival;
+    return a->seq < b->seq;
+}
+
+int compare_record(const void *a, const void *b) {
+    const ExtsortRecord *x = a;
+    const ExtsortRecord *y = b;
+
+    if (x->arrival != y->arrival) return x->arrival < y->arrival ? -1 : 1;
+    return x->seq < y->seq ? -1 : (x->seq > y->seq);
+}
@@ -0,0 +1,53 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   extsort.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef EXTSORT_H
+#define EXTSORT_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define EXTSORT_DEFAULT_MEMORY (64 * 1024 * 1024)
+#define EXTSORT_FAN_IN 16
+#define EXTSORT_MAX_RUNS 128
+
+/*---------- STRUCTURE: ExtsortSummary ---------------------
+/  Structure Description:
+/    What sorting a workload by arrival time took.
+/
+/  Fields:
+/    long long records
+/      Processes read
+/    int sorted
+/      1 if the input was already in arrival order, so that nothing
+/      had to be sorted
+/    long long runs
+/      Sorted runs written to temporary files (0 if the workload fit
+/      in memory, or was already sorted)
+/    int passes
+/      Times the runs were merged into longer ones before the final
+/      merge
+/    long long spilled
+/      Bytes written to temporary files, merges included
+/
+/  Relationships:
+/    - filled in by extsort_open
+/---------------------------------------------------------*/
+typedef struct {
+    long long records;
+    int sorted;
+    long long runs;
+    int passes;
+    long long spilled;
+} ExtsortSummary;
+
+FILE *extsort_open(FILE *in, int with_priority, size_t memory, ExtsortSummary *summary);
+
+#endif
@@ -11,6 +11,6 @@
 
 #define MAX_PROCESSES 20
 #define MAX_WIDTH 10
-#define MAX_RUNTIME 999
+#define MAX_CHART_COLUMNS 2000
 
 #endif
\ No newline at end of file
@@ -0,0 +1,460 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   groups.c
+/
+/  File Description:
+/    This file implements hierarchical group scheduling, after the
+/    cpu controller of Linux control groups. Processes belong to the
+/    groups at the bottom of a tree. Whenever the CPU is handed out,
+/    the tree is walked down from the root, and at each level the
+/    group with the least virtual runtime is taken, among those with
+/    work to do that are not throttled:
+/
+/      vruntime = CPU time used * GROUP_DEFAULT_SHARES / shares
+/
+/    so that over time, groups that are all busy share their parent's
+/    CPU time in proportion to their shares. A group that had nothing
+/    to run is brought up to the least virtual runtime of the groups
+/    beside it when it has again, rather than catching up all at once
+/    on the time it was away.
+/
+/    A group may also have a bandwidth limit, as cpu.max sets: a quota
+/    of CPU time in each period. Once its processes, and those of the
+/    groups below it, have used the quota, the group is throttled, and
+/    none of them runs again until the next period starts.
+/
+/    The tree is kept in preorder, so that a group's subtree is the
+/    range of indices that follows it, and a process holds the index
+/    of its group; the scheduler never compares names.
+/
+/  Citations:
+/  - Waldspurger and Weihl, "Stride Scheduling: Deterministic
+/    Proportional-Share Resource Management", MIT/LCS/TM-528, 1995
+/  - Turner, Rao and Rao, "CPU Bandwidth Control for CFS", Linux
+/    Symposium, 2010
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "groups.h"
+
+void group_order(GroupTree *tree, const Group listed[], int count, int from, int parent);
+void group_throttle(Group *group, long long now);
+long long group_used(const Group *group, long long now);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: init_group_tree ---------------------
+/  Function Description:
+/    Sets up no groups, so that runs schedule processes on their own.
+/
+/  Caller Input:
+/    GroupTree *tree: the tree to initialize
+/
+/  Caller Output:
+/    N/A - No return value
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void init_group_tree(GroupTree *tree) {
+    tree->num_groups = 0;
+    tree->slice = GROUP_DEFAULT_SLICE;
+}
+
+/*---------- FUNCTION: parse_group_tree --------------------
+/  Function Description:
+/    Reads the groups as given with --groups, one per line:
+/
+/      name parent shares [quota period]
+/
+/    The parent is "/" (the root) or a group on an earlier line, and
+/    the quota may be "max" for no limit, as with cpu.max. Blank lines
+/    and lines starting with # are skipped. The tree is stored in
+/    preorder, the groups in each parent in the order they were given,
+/    and each group's entitlement is worked out.
+/
+/  Caller Input:
+/    FILE *in: the group file
+/    GroupTree *tree: filled in; its slice is left as it was
+/
+/  Caller Output:
+/    0 on success, 1 on a malformed line, a name given twice or an
+/    unknown parent, or more than MAX_GROUPS groups
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - errors are printed to stderr
+/    - lines longer than 255 characters are split
+/---------------------------------------------------------*/
+int parse_group_tree(FILE *in, GroupTree *tree) {
+    Group listed[MAX_GROUPS];
+    char line[256];
+    int count = 1;
+    int line_number = 0;
+
+    memset(&listed[0], 0, sizeof(Group));
+    strcpy(listed[0].name, "/");
+    listed[0].parent = -1;
+    listed[0].shares = GROUP_DEFAULT_SHARES;
+
+    while (fgets(line, sizeof(line), in) != NULL) {
+        char name[64], parent[64], quota[32], extra[2];
+        long long shares, period = 0;
+        int vals_read;
+        int p;
+
+        line_number++;
+        if (line[strspn(line, " \t\r\n")] == '\0' || line[strspn(line, " \t")] == '#') continue;
+
+        vals_read = sscanf(line, "%63s %63s %lld %31s %lld %1s", name, parent, &shares, quota, &period, extra);
+        if (vals_read == 4 && strcmp(quota, "max") == 0) vals_read = 3;
+        if ((vals_read != 3 && vals_read != 5) || strlen(name) >= GROUP_NAME_LENGTH ||
+            strcmp(name, "/") == 0 || shares < 1 || shares > 1000000) {
+            fprintf(stderr, "Error: malformed group on line %d of the group file.\n", line_number);
+            return 1;
+        }
+        for (p = 0; p < count && strcmp(listed[p].name, parent) != 0; p++);
+        if (p == count) {
+            fprintf(stderr, "Error: group %s on line %d of the group file is in %s, which is not "
+                    "given above it.\n", name, line_number, parent);
+            return 1;
+        }
+        for (int g = 0; g < count; g++) {
+            if (strcmp(listed[g].name, name) == 0) {
+                fprintf(stderr, "Error: group %s is given twice in the group file.\n", name);
+                return 1;
+            }
+        }
+        if (count == MAX_GROUPS) {
+            fprintf(stderr, "Error: the group file has more than %d groups.\n", MAX_GROUPS - 1);
+            return 1;
+        }
+
+        memset(&listed[count], 0, sizeof(Group));
+        strcpy(listed[count].name, name);
+        listed[count].parent = p;
+        listed[count].shares = shares;
+        if (vals_read == 5 && strcmp(quota, "max") != 0) {
+            char *end;
+
+            listed[count].quota = strtoll(quota, &end, 10);
+            listed[count].period = period;
+            if (*end != '\0' || listed[count].quota < 1 || period < 1) {
+                fprintf(stderr, "Error: malformed group on line %d of the group file.\n", line_number);
+                return 1;
+            }
+        }
+        count++;
+    }
+
+    tree->num_groups = 0;
+    group_order(tree, listed, count, 0, -1);
+
+    for (int g = 0; g < tree->num_groups; g++) {
+        Group *group = &tree->group[g];
+        int j = g;
+
+        group->entitlement = 1;
+        if (group->parent >= 0) {
+            Group *parent = &tree->group[group->parent];
+            long long total = 0;
+
+            group->depth = parent->depth + 1;
+            for (int s = group->parent + 1; s < group->parent + parent->size; s += tree->group[s].size) {
+                total += tree->group[s].shares;
+            }
+            group->entitlement = parent->entitlement * group->shares / total;
+        }
+        if (group->quota > 0 && (double)group->quota / group->period < group->entitlement) {
+            group->entitlement = (double)group->quota / group->period;
+        }
+
+        /* by name, for group_find */
+        for (; j > 0 && strcmp(tree->group[tree->by_name[j - 1]].name, group->name) > 0; j--) {
+            tree->by_name[j] = tree->by_name[j - 1];
+        }
+        tree->by_name[j] = g;
+    }
+    return 0;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions find groups in the tree.
+/
+/  Functions and Their Purpose:
+/    - group_find: The index of the named group, or -1 if there is
+/      none, by binary search of the names.
+/    - group_contains: 1 if group inner is group outer or below it.
+/
+/  Input Parameters:
+/    - const GroupTree *tree: the groups
+/    - const char *name: a group's name
+/    - int outer, inner: group indices (inner may be -1)
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+int group_find(const GroupTree *tree, const char *name) {
+    int low = 0;
+    int high = tree->num_groups - 1;
+
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        int order = strcmp(tree->group[tree->by_name[mid]].name, name);
+
+        if (order == 0) return tree->by_name[mid];
+        if (order < 0) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return -1;
+}
+
+int group_contains(const GroupTree *tree, int outer, int inner) {
+    return inner >= outer && inner < outer + tree->group[outer].size;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions follow the groups through a run.
+/
+/  Functions and Their Purpose:
+/    - groups_reset: Clears what the groups did, for a new run.
+/    - group_join: Counts a process joining the ready processes of
+/      group g, in g and the groups above it. A group that had no work
+/      is brought up to its parent's min_vruntime.
+/    - group_leave: Counts a process leaving them to run.
+/    - group_arrive: Notes a process arriving in group g at now: if g,
+/      or a group above it, has used its quota, it is throttled from
+/      now to the end of its period.
+/    - group_pick: The group at the bottom of the tree whose process
+/      should run at now: at each level, the group with the least
+/      vruntime (then the lowest index) that has ready processes, or
+/      holds group running, and is not throttled. -1 if there is none.
+/    - group_budget: The time a process of group g can run from now
+/      before a group above it uses its quota or reaches the end of
+/      its period, or LLONG_MAX if none of them has a quota.
+/    - group_refill: The earliest end of a period of a throttled group
+/      with ready processes, or LLONG_MAX if there is none.
+/    - group_charge: Charges ran time units of CPU, ending at now, to
+/      group g and the groups above it. A group that has used its
+/      quota is throttled to the end of its period if it still has
+/      work: ready processes, or more of the one that ran.
+/    - group_complete: Adds a completed process's waiting and
+/      turnaround times to group g and the groups above it.
+/
+/  Input Parameters:
+/    - GroupTree *tree: the groups
+/    - int g: a group at the bottom of the tree
+/    - int running: the group of the running process, or -1
+/    - long long now: the simulated time
+/    - long long ran: CPU time used
+/    - int more: 1 if the process that ran has not completed
+/    - long long waiting, turnaround: the process's times
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the time charged must fall in one period of each group with a
+/      quota, which running no longer than group_budget ensures
+/------------------------------------------------------------------------*/
+void groups_reset(GroupTree *tree) {
+    for (int g = 0; g < tree->num_groups; g++) {
+        Group *group = &tree->group[g];
+
+        group->waiting = 0;
+        group->vruntime = 0;
+        group->min_vruntime = 0;
+        group->usage = 0;
+        group->period_start = 0;
+        group->period_used = 0;
+        group->throttled_in = -1;
+        group->throttled_time = 0;
+        group->throttles = 0;
+        group->completed = 0;
+        group->waiting_sum = 0;
+        group->turnaround_sum = 0;
+    }
+}
+
+void group_join(GroupTree *tree, int g) {
+    for (; g >= 0; g = tree->group[g].parent) {
+        Group *group = &tree->group[g];
+
+        if (group->waiting++ == 0 && group->parent >= 0 &&
+            group->vruntime < tree->group[group->parent].min_vruntime) {
+            group->vruntime = tree->group[group->parent].min_vruntime;
+        }
+    }
+}
+
+void group_leave(GroupTree *tree, int g) {
+    for (; g >= 0; g = tree->group[g].parent) {
+        tree->group[g].waiting--;
+    }
+}
+
+void group_arrive(GroupTree *tree, int g, long long now) {
+    for (; g >= 0; g = tree->group[g].parent) {
+        Group *group = &tree->group[g];
+
+        if (group->quota > 0 && group_used(group, now) >= group->quota) {
+            group_throttle(group, now);
+        }
+    }
+}
+
+int group_pick(GroupTree *tree, int running, long long now) {
+    int g = 0;
+
+    while (tree->group[g].size > 1) {
+        Group *parent = &tree->group[g];
+        int best = -1;
+
+        for (int c = g + 1; c < g + parent->size; c += tree->group[c].size) {
+            Group *child = &tree->group[c];
+
+            if (child->waiting == 0 && !group_contains(tree, c, running)) continue;
+            if (child->quota > 0 && group_used(child, now) >= child->quota) continue;
+            if (best == -1 || child->vruntime < tree->group[best].vruntime) best = c;
+        }
+        if (best == -1) return -1;
+        if (tree->group[best].vruntime > parent->min_vruntime) parent->min_vruntime = tree->group[best].vruntime;
+        g = best;
+    }
+    return g;
+}
+
+long long group_budget(const GroupTree *tree, int g, long long now) {
+    long long budget = LLONG_MAX;
+
+    for (; g >= 0; g = tree->group[g].parent) {
+        const Group *group = &tree->group[g];
+        long long left;
+        long long end;
+
+        if (group->quota == 0) continue;
+        left = group->quota - group_used(group, now);
+        end = now - now % group->period + group->period;
+        if (left < budget) budget = left;
+        if (end - now < budget) budget = end - now;
+    }
+    return budget;
+}
+
+long long group_refill(const GroupTree *tree, long long now) {
+    long long refill = LLONG_MAX;
+
+    for (int g = 0; g < tree->num_groups; g++) {
+        const Group *group = &tree->group[g];
+
+        if (group->quota > 0 && group->waiting > 0 && group_used(group, now) >= group->quota &&
+            group->period_start + group->period < refill) {
+            refill = group->period_start + group->period;
+        }
+    }
+    return refill;
+}
+
+void group_charge(GroupTree *tree, int g, long long ran, long long now, int more) {
+    for (; g >= 0; g = tree->group[g].parent) {
+        Group *group = &tree->group[g];
+
+        group->usage += ran;
+        group->vruntime += (double)ran * GROUP_DEFAULT_SHARES / group->shares;
+        if (group->quota == 0) continue;
+
+        if (now - ran >= group->period_start + group->period) {
+            group->period_start = now - ran - (now - ran) % group->period;
+            group->period_used = 0;
+        }
+        group->period_used += ran;
+        if (group->period_used >= group->quota && (more || group->waiting > 0)) {
+            group_throttle(group, now);
+        }
+    }
+}
+
+void group_complete(GroupTree *tree, int g, long long waiting, long long turnaround) {
+    for (; g >= 0; g = tree->group[g].parent) {
+        tree->group[g].completed++;
+        tree->group[g].waiting_sum += waiting;
+        tree->group[g].turnaround_sum += turnaround;
+    }
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION: group_order -------------------------
+/  Function Description:
+/    Copies group from of the groups as listed, then the groups in
+/    it, to the end of the tree, so that the tree is in preorder, and
+/    sets each one's parent and size.
+/
+/  Caller Input:
+/    GroupTree *tree: the tree being built
+/    const Group listed[]: the groups in the order they were given,
+/      each one's parent an index into listed
+/    int count: number of groups listed
+/    int from: the group to copy
+/    int parent: its parent's index in the tree, or -1
+/
+/  Caller Output:
+/    N/A - No return value
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - recurses once per level of the tree
+/---------------------------------------------------------*/
+void group_order(GroupTree *tree, const Group listed[], int count, int from, int parent) {
+    int g = tree->num_groups++;
+
+    tree->group[g] = listed[from];
+    tree->group[g].parent = parent;
+    for (int c = from + 1; c < count; c++) {
+        if (listed[c].parent == from) group_order(tree, listed, count, c, g);
+    }
+    tree->group[g].size = tree->num_groups - g;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions follow a group's quota.
+/
+/  Functions and Their Purpose:
+/    - group_throttle: Counts the group as throttled from now to the
+/      end of its current period, unless it already is or the period
+/      ends now.
+/    - group_used: The CPU time the group has used in the period that
+/      now falls in.
+/
+/  Input Parameters:
+/    - Group *group: a group with a quota
+/    - long long now: the simulated time
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - group_throttle assumes the group's period has been brought up
+/      to now
+/------------------------------------------------------------------------*/
+void group_throttle(Group *group, long long now) {
+    if (group->throttled_in == group->period_start || now >= group->period_start + group->period) return;
+    group->throttled_in = group->period_start;
+    group->throttled_time += group->period_start + group->period - now;
+    group->throttles++;
+}
+
+long long group_used(const Group *group, long long now) {
+    if (now >= group->period_start + group->period) return 0;
+    return group->period_used;
+}
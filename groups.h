@@ -0,0 +1,139 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   groups.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef GROUPS_H
+#define GROUPS_H
+
+#include <stdio.h>
+
+#define MAX_GROUPS 128
+#define GROUP_NAME_LENGTH 32
+#define GROUP_DEFAULT_SHARES 1024
+#define GROUP_DEFAULT_SLICE 10
+
+/*---------- STRUCTURE: Group ------------------------------
+/  Structure Description:
+/    One group of a GroupTree: its place in the tree, its CPU shares
+/    and bandwidth limit, and what it did over the current run. A
+/    group's usage includes that of the groups below it.
+/
+/  Fields:
+/    char name[GROUP_NAME_LENGTH]
+/      The group's name, "/" for the root
+/    int parent
+/      Index of the group it is in, or -1 for the root
+/    int depth
+/      Number of groups above it
+/    int size
+/      Number of groups in its subtree, itself included; as the tree
+/      is stored in preorder, they are the next size groups
+/    long long shares
+/      Its weight against the other groups in its parent
+/    long long quota, period
+/      It may use at most quota time units of CPU in each period
+/      (periods start at multiples of period); quota is 0 for no limit
+/    double entitlement
+/      The share of the CPU it is guaranteed when every group is busy:
+/      its parent's, split by the shares of the groups in the parent,
+/      and at most quota / period
+/    int waiting
+/      Ready processes in its subtree, not counting one running
+/    double vruntime
+/      Its usage weighted by its shares, which decides which group in
+/      its parent runs next
+/    double min_vruntime
+/      The vruntime of the group below it picked last, which a group
+/      that had nothing to run is brought up to when it has again
+/    long long usage
+/      CPU time its processes used
+/    long long period_start, period_used
+/      The start of its current period, and the CPU time used in it
+/    long long throttled_in
+/      The start of the period in which it was last throttled, or -1
+/    long long throttled_time, throttles
+/      Time it was kept off the CPU by its quota with work to do, and
+/      the number of periods in which that happened
+/    long long completed, waiting_sum, turnaround_sum
+/      Processes completed in its subtree, and the total of their
+/      waiting and turnaround times
+/
+/  Relationships:
+/    - contained in a GroupTree
+/---------------------------------------------------------*/
+typedef struct {
+    char name[GROUP_NAME_LENGTH];
+    int parent;
+    int depth;
+    int size;
+    long long shares;
+    long long quota;
+    long long period;
+    double entitlement;
+    int waiting;
+    double vruntime;
+    double min_vruntime;
+    long long usage;
+    long long period_start;
+    long long period_used;
+    long long throttled_in;
+    long long throttled_time;
+    long long throttles;
+    long long completed;
+    long long waiting_sum;
+    long long turnaround_sum;
+} Group;
+
+/*---------- STRUCTURE: GroupTree --------------------------
+/  Structure Description:
+/    The groups processes are scheduled in, as given with --groups,
+/    like the cpu controller's control groups: at each level the
+/    group that has used the least CPU for its shares runs, unless
+/    its quota is used up, and within the group at the bottom the
+/    algorithm picks the process. Groups are found by their index,
+/    and a group's subtree is a range of indices, so no names are
+/    compared once the workload has been read.
+/
+/  Fields:
+/    int num_groups
+/      Number of groups, the root included, or 0 for no groups
+/    long long slice
+/      How long a process runs before its group is weighed against
+/      the others again (its time slice, for RR)
+/    Group group[MAX_GROUPS]
+/      The groups in preorder, the root first
+/    int by_name[MAX_GROUPS]
+/      Their indices, ordered by name, for group_find
+/
+/  Relationships:
+/    - contained in SimContext
+/    - contains an array of Groups
+/---------------------------------------------------------*/
+typedef struct {
+    int num_groups;
+    long long slice;
+    Group group[MAX_GROUPS];
+    int by_name[MAX_GROUPS];
+} GroupTree;
+
+void init_group_tree(GroupTree *tree);
+int parse_group_tree(FILE *in, GroupTree *tree);
+int group_find(const GroupTree *tree, const char *name);
+int group_contains(const GroupTree *tree, int outer, int inner);
+void groups_reset(GroupTree *tree);
+void group_join(GroupTree *tree, int g);
+void group_leave(GroupTree *tree, int g);
+void group_arrive(GroupTree *tree, int g, long long now);
+int group_pick(GroupTree *tree, int running, long long now);
+long long group_budget(const GroupTree *tree, int g, long long now);
+long long group_refill(const GroupTree *tree, long long now);
+void group_charge(GroupTree *tree, int g, long long ran, long long now, int more);
+void group_complete(GroupTree *tree, int g, long long waiting, long long turnaround);
+
+#endif
@@ -0,0 +1,170 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   histogram.c
+/
+/  File Description:
+/    This file implements a log-bucketed histogram used to report
+/    tail percentiles of the per-process metrics. Each bucket index
+/    is made of a value's exponent (the position of its highest set
+/    bit) and the HIST_SUB_BITS bits below it, like HdrHistogram.
+/
+/  Citations:
+/  - HdrHistogram: http://hdrhistogram.org/
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "process.h"
+#include "histogram.h"
+
+int hist_bucket(long long value);
+long long hist_bucket_high(int bucket);
+
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions build up and query a Histogram.
+/
+/  Functions and Their Purpose:
+/    - init_histogram: Empties the histogram.
+/    - hist_record: Adds one value. Negative values are counted as 0.
+/    - hist_merge: Adds the contents of src into dest, as if every
+/      value recorded in src had been recorded in dest.
+/    - hist_percentile: Returns the value at the given percentile
+/      (0-100), i.e. the smallest value that at least that share of
+/      the recorded values are less than or equal to. Returns 0 if
+/      the histogram is empty.
+/
+/  Input Parameters:
+/    - Histogram *hist / *dest / *src: the histograms to operate on
+/    - long long value: the value to record
+/    - double percentile: the percentile to look up, 0-100
+/
+/  Output:
+/    - hist_percentile returns the highest value that shares the
+/      matching bucket, clamped to the recorded min and max
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - values larger than 2^HIST_SUB_BITS are only accurate to within
+/      the bucket's width (under 1.6% of the value)
+/------------------------------------------------------------------------*/
+void init_histogram(Histogram *hist) {
+    memset(hist->counts, 0, sizeof(hist->counts));
+    hist->count = 0;
+    hist->min = 0;
+    hist->max = 0;
+}
+
+void hist_record(Histogram *hist, long long value) {
+    if (value < 0) value = 0;
+
+    hist->counts[hist_bucket(value)]++;
+    if (hist->count == 0 || value < hist->min) hist->min = value;
+    if (hist->count == 0 || value > hist->max) hist->max = value;
+    hist->count++;
+}
+
+void hist_merge(Histogram *dest, const Histogram *src) {
+    if (src->count == 0) return;
+
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        dest->counts[i] += src->counts[i];
+    }
+    if (dest->count == 0 || src->min < dest->min) dest->min = src->min;
+    if (dest->count == 0 || src->max > dest->max) dest->max = src->max;
+    dest->count += src->count;
+}
+
+long long hist_percentile(const Histogram *hist, double percentile) {
+    unsigned long long rank;
+    unsigned long long seen = 0;
+    double target;
+    int last = hist_bucket(hist->max);
+
+    if (hist->count == 0) return 0;
+
+    /* nearest-rank: the ceiling of percentile% of the count */
+    target = percentile / 100.0 * hist->count;
+    rank = (unsigned long long)target;
+    if (rank < target) rank++;
+    if (rank < 1) rank = 1;
+    if (rank > hist->count) rank = hist->count;
+
+    for (int i = hist_bucket(hist->min); i <= last; i++) {
+        seen += hist->counts[i];
+        if (seen >= rank) {
+            long long value = hist_bucket_high(i);
+            if (value < hist->min) value = hist->min;
+            return (value > hist->max) ? hist->max : value;
+        }
+    }
+    return hist->max;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions manage the three latency histograms of a run.
+/
+/  Functions and Their Purpose:
+/    - init_latency: Empties all three histograms.
+/    - record_latency: Records the turnaround, waiting and response
+/      time of a process that has just completed.
+/    - merge_latency: Merges each histogram of src into dest.
+/
+/  Input Parameters:
+/    - LatencyHistograms *latency / *dest / *src: the histograms
+/    - const Process *process: a completed process
+/
+/  Output:
+/    - N/A - the histograms are modified directly
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - assumes the process's metrics have already been calculated
+/------------------------------------------------------------------------*/
+void init_latency(LatencyHistograms *latency) {
+    init_histogram(&latency->turnaround);
+    init_histogram(&latency->waiting);
+    init_histogram(&latency->response);
+}
+
+void record_latency(LatencyHistograms *latency, const Process *process) {
+    hist_record(&latency->turnaround, process->turnaround_time);
+    hist_record(&latency->waiting, process->waiting_time);
+    hist_record(&latency->response, process->response_time);
+}
+
+void merge_latency(LatencyHistograms *dest, const LatencyHistograms *src) {
+    hist_merge(&dest->turnaround, &src->turnaround);
+    hist_merge(&dest->waiting, &src->waiting);
+    hist_merge(&dest->response, &src->response);
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+
+int hist_bucket(long long value) {
+    unsigned long long v = (unsigned long long)value;
+    int exponent;
+    int shift;
+
+    if (v < HIST_SUB_COUNT) return (int)v;
+
+    exponent = 63 - __builtin_clzll(v);
+    shift = exponent - HIST_SUB_BITS + 1;
+    return HIST_SUB_COUNT + (exponent - HIST_SUB_BITS) * (HIST_SUB_COUNT / 2)
+           + (int)(v >> shift) - HIST_SUB_COUNT / 2;
+}
+
+long long hist_bucket_high(int bucket) {
+    int offset, exponent, shift;
+    unsigned long long mantissa;
+
+    if (bucket < HIST_SUB_COUNT) return bucket;
+
+    offset = bucket - HIST_SUB_COUNT;
+    exponent = HIST_SUB_BITS + offset / (HIST_SUB_COUNT / 2);
+    mantissa = HIST_SUB_COUNT / 2 + offset % (HIST_SUB_COUNT / 2);
+    shift = exponent - HIST_SUB_BITS + 1;
+    return (long long)(((mantissa + 1) << shift) - 1);
+}
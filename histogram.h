@@ -0,0 +1,79 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   histogram.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include "process.h"
+
+/* values below 2^HIST_SUB_BITS get their own bucket; larger values are
+   kept to HIST_SUB_BITS significant bits (under 1.6% relative error) */
+#define HIST_SUB_BITS 7
+#define HIST_SUB_COUNT (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS (HIST_SUB_COUNT + (64 - HIST_SUB_BITS) * (HIST_SUB_COUNT / 2))
+
+/*---------- STRUCTURE: Histogram --------------------------
+/  Structure Description:
+/    A log-bucketed (HDR-style) histogram of non-negative values.
+/    Buckets are exact for small values and grow with the value's
+/    magnitude above that, so the size is fixed no matter how many
+/    values are recorded. Two histograms can be merged by adding
+/    their buckets.
+/
+/  Fields:
+/    unsigned long long counts[HIST_BUCKETS]
+/      Number of recorded values that fell in each bucket
+/    unsigned long long count
+/      Total number of recorded values
+/    long long min
+/      Smallest recorded value
+/    long long max
+/      Largest recorded value
+/
+/  Relationships:
+/    - LatencyHistograms contains one per latency metric
+/---------------------------------------------------------*/
+typedef struct {
+    unsigned long long counts[HIST_BUCKETS];
+    unsigned long long count;
+    long long min;
+    long long max;
+} Histogram;
+
+/*---------- STRUCTURE: LatencyHistograms ------------------
+/  Structure Description:
+/    The distributions of the per-process metrics of one run, filled
+/    in as each process completes.
+/
+/  Fields:
+/    Histogram turnaround
+/    Histogram waiting
+/    Histogram response
+/
+/  Relationships:
+/    - contains three Histogram structs
+/    - read by display_metrics_table to report tail percentiles
+/---------------------------------------------------------*/
+typedef struct {
+    Histogram turnaround;
+    Histogram waiting;
+    Histogram response;
+} LatencyHistograms;
+
+void init_histogram(Histogram *hist);
+void hist_record(Histogram *hist, long long value);
+void hist_merge(Histogram *dest, const Histogram *src);
+long long hist_percentile(const Histogram *hist, double percentile);
+
+void init_latency(LatencyHistograms *latency);
+void record_latency(LatencyHistograms *latency, const Process *process);
+void merge_latency(LatencyHistograms *dest, const LatencyHistograms *src);
+
+#endif
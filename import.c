@@ -0,0 +1,851 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   import.c
+/
+/  File Description:
+/    This file implements an importer for Linux scheduler traces, as
+/    printed by "perf sched script" or read from ftrace's trace file
+/    with the sched_switch and sched_wakeup events enabled. It turns
+/    the trace into the simulator's "id arrival burst [priority]"
+/    workload format, read through an ordinary FILE, so anything that
+/    reads a workload can read a kernel trace instead.
+/
+/    A job is one stretch of a task being runnable: it arrives when
+/    the task is woken (or first seen running), its burst is the CPU
+/    time the task gets until it switches out in a sleeping state,
+/    and its priority is the kernel's (lower is more important, as in
+/    the simulator). Times are in microseconds from the first event.
+/
+/    The trace is read a line at a time and memory stays bounded
+/    however long it is: only runnable tasks are held, in a hash
+/    table, and finished jobs wait in a heap until no job still open
+/    could arrive before them, so that they come out in arrival
+/    order. A task that stays runnable while the heap fills is cut
+/    into several jobs.
+/
+/  Citations:
+/  - perf-sched(1), Linux manual page
+/  - Linux kernel documentation, "Event Tracing" (trace/events.rst)
+/---------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <sys/types.h>
+#include "import.h"
+
+#define IMPORT_LINE_MAX 4096
+#define IMPORT_OPEN_CAPACITY (2 * IMPORT_MAX_TASKS)
+#define IMPORT_HEAP_CAPACITY (IMPORT_WINDOW + IMPORT_MAX_TASKS)
+
+/*---------- STRUCTURE: ImportTask -------------------------
+/  Structure Description:
+/    A task that is runnable, and the job it is part way through.
+/
+/  Fields:
+/    int pid
+/      The task's ID, or 0 for an empty slot of the table
+/    int priority
+/      The task's kernel priority when last seen
+/    int running
+/      1 if the task is on a CPU
+/    long long arrival
+/      Time the job arrived
+/    long long first_run
+/      Time the job first ran, or -1
+/    long long run_start
+/      Time the task last went onto a CPU
+/    long long burst
+/      CPU time the job has had, not counting the current run
+/    long long generation
+/      Identifies the job, so stale entries of the open queue can
+/      be told apart from it
+/
+/  Relationships:
+/    - held in Importer's hash table
+/---------------------------------------------------------*/
+typedef struct {
+    int pid;
+    int priority;
+    int running;
+    long long arrival;
+    long long first_run;
+    long long run_start;
+    long long burst;
+    long long generation;
+} ImportTask;
+
+/*---------- STRUCTURE: ImportJob --------------------------
+/  Structure Description:
+/    A finished job, waiting to be written in arrival order.
+/
+/  Fields:
+/    long long arrival, burst
+/      The job's arrival and burst times
+/    long long seq
+/      Order the job finished in, to break ties
+/    int priority
+/      The job's kernel priority
+/
+/  Relationships:
+/    - held in Importer's heap
+/---------------------------------------------------------*/
+typedef struct {
+    long long arrival;
+    long long burst;
+    long long seq;
+    int priority;
+} ImportJob;
+
+/*---------- STRUCTURE: ImportOpen -------------------------
+/  Structure Description:
+/    An entry of the queue of open jobs, oldest first.
+/
+/  Fields:
+/    int pid
+/      The job's task
+/    long long generation
+/      The job's generation; the entry is stale once its task has
+/      moved on to another job
+/
+/  Relationships:
+/    - held in Importer's open queue
+/---------------------------------------------------------*/
+typedef struct {
+    int pid;
+    long long generation;
+} ImportOpen;
+
+/*---------- STRUCTURE: Importer ---------------------------
+/  Structure Description:
+/    The state of one import, behind the FILE it is read through.
+/
+/  Fields:
+/    FILE *trace
+/      The kernel trace
+/    int with_priority
+/      1 to write each job's priority
+/    ImportSummary *summary
+/      Filled in as the trace is read
+/    ImportTask tasks[], int num_tasks
+/      Runnable tasks, by pid (open addressing, linear probing)
+/    ImportJob jobs[], int num_jobs
+/      Finished jobs, a min-heap by arrival
+/    ImportOpen open[], int open_head, open_count
+/      Ring of open jobs in the order they arrived
+/    long long generation, seq, written
+/      Counters for jobs opened, finished and written
+/    long long base, now
+/      Trace time of the first event, and time of the latest event
+/      relative to it
+/    int has_base, at_end, error
+/      Whether an event has been read, the trace is finished, and
+/      reading has failed
+/    char line[]
+/      The trace line being parsed
+/    char pending[], int pending_len, pending_pos
+/      The workload line being written out
+/
+/  Relationships:
+/    - contains ImportTasks, ImportJobs and ImportOpens
+/---------------------------------------------------------*/
+typedef struct {
+    FILE *trace;
+    int with_priority;
+    ImportSummary *summary;
+    ImportTask tasks[IMPORT_MAX_TASKS];
+    int num_tasks;
+    ImportJob jobs[IMPORT_HEAP_CAPACITY];
+    int num_jobs;
+    ImportOpen open[IMPORT_OPEN_CAPACITY];
+    int open_head;
+    int open_count;
+    long long generation;
+    long long seq;
+    long long written;
+    long long base;
+    long long now;
+    int has_base;
+    int at_end;
+    int error;
+    char line[IMPORT_LINE_MAX];
+    char pending[96];
+    int pending_len;
+    int pending_pos;
+} Importer;
+
+ssize_t import_read(void *cookie, char *buf, size_t size);
+int import_close(void *cookie);
+int import_next_job(Importer *imp, ImportJob *job);
+int import_line(Importer *imp, char *line);
+int import_wakeup(Importer *imp, int pid, int priority);
+int import_switch(Importer *imp, int prev_pid, int prev_runnable, int next_pid, int next_priority);
+int import_begin_job(Importer *imp, ImportTask *task, int pid, int priority);
+void import_end_job(Importer *imp, ImportTask *task);
+void import_split_oldest(Importer *imp);
+void import_finish(Importer *imp);
+long long import_watermark(Importer *imp);
+ImportTask *import_oldest(Importer *imp);
+void import_push_open(Importer *imp, ImportTask *task);
+void import_compact_open(Importer *imp);
+ImportTask *import_find(Importer *imp, int pid);
+ImportTask *import_insert(Importer *imp, int pid);
+void import_remove(Importer *imp, ImportTask *task);
+void import_push_job(Importer *imp, ImportJob *job);
+ImportJob import_pop_job(Importer *imp);
+int job_before(ImportJob *a, ImportJob *b);
+int parse_time(const char *line, const char *event, long long *time);
+int parse_cpu(const char *line, const char *event);
+int parse_field(const char *text, const char *key, char *value, size_t size);
+int parse_task(const char *text, int *pid, int *priority, char *state, size_t size);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: import_open -------------------------
+/  Function Description:
+/    Starts importing a kernel trace, returning a stream that reads
+/    as the reconstructed workload: one "id arrival burst [priority]"
+/    line per job, in arrival order, with jobs numbered from 1.
+/
+/  Caller Input:
+/    FILE *trace: the trace (perf sched script or ftrace text)
+/    int with_priority: 1 to include each job's priority
+/    ImportSummary *summary: cleared, then filled in as the stream is
+/      read; complete once the stream reaches its end
+/
+/  Caller Output:
+/    The stream, or NULL if it could not be created. Closing it
+/    closes trace too, unless trace is stdin.
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - uses the GNU fopencookie extension
+/    - events are expected in time order, as both tools print them;
+/      an event stamped earlier than the one before is taken to
+/      happen at the same time
+/    - a trace that starts while tasks are running cannot tell how
+/      long they had been running; their first runs are dropped
+/    - more than IMPORT_MAX_TASKS / 2 tasks runnable at once is an error
+/---------------------------------------------------------*/
+FILE *import_open(FILE *trace, int with_priority, ImportSummary *summary) {
+    cookie_io_functions_t io = {import_read, NULL, NULL, import_close};
+    Importer *imp = calloc(1, sizeof(Importer));
+    FILE *stream;
+
+    if (imp == NULL) {
+        fprintf(stderr, "Error: out of memory importing the kernel trace.\n");
+        return NULL;
+    }
+    memset(summary, 0, sizeof(ImportSummary));
+    imp->trace = trace;
+    imp->with_priority = with_priority;
+    imp->summary = summary;
+
+    stream = fopencookie(imp, "r", io);
+    if (stream == NULL) {
+        free(imp);
+    }
+    return stream;
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions are the stream behind import_open.
+/
+/  Functions and Their Purpose:
+/    - import_read: Fills buf with workload lines, formatting each job
+/      as it is needed.
+/    - import_close: Closes the trace and frees the importer.
+/    - import_next_job: Reads the trace until the next job in arrival
+/      order is known. A job can be written once no open job arrived
+/      before it (the watermark). If the heap is nearly full, the
+/      oldest open job is cut short instead of reading on.
+/
+/  Input Parameters:
+/    - void *cookie: the Importer
+/    - char *buf, size_t size: where to put the workload
+/    - Importer *imp: the importer
+/    - ImportJob *job: the job to fill in
+/
+/  Output:
+/    - import_read: bytes read, 0 at the end, or -1 on an error
+/    - import_close: 0
+/    - import_next_job: 1 for a job, 0 at the end, -1 on an error
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - lines longer than IMPORT_LINE_MAX are cut, and the rest ignored
+/------------------------------------------------------------------------*/
+ssize_t import_read(void *cookie, char *buf, size_t size) {
+    Importer *imp = cookie;
+    size_t copied = 0;
+
+    while (copied < size) {
+        ImportJob job;
+        size_t chunk;
+
+        if (imp->pending_pos < imp->pending_len) {
+            chunk = imp->pending_len - imp->pending_pos;
+            if (chunk > size - copied) chunk = size - copied;
+            memcpy(buf + copied, imp->pending + imp->pending_pos, chunk);
+            imp->pending_pos += chunk;
+            copied += chunk;
+            continue;
+        }
+        if (import_next_job(imp, &job) != 1) break;
+
+        imp->written++;
+        if (imp->with_priority) {
+            imp->pending_len = snprintf(imp->pending, sizeof(imp->pending), "%lld %lld %lld %d\n",
+                                        imp->written, job.arrival, job.burst, job.priority);
+        } else {
+            imp->pending_len = snprintf(imp->pending, sizeof(imp->pending), "%lld %lld %lld\n",
+                                        imp->written, job.arrival, job.burst);
+        }
+        imp->pending_pos = 0;
+    }
+
+    if (copied == 0 && imp->error) return -1;
+    return copied;
+}
+
+int import_close(void *cookie) {
+    Importer *imp = cookie;
+
+    if (imp->trace != stdin) fclose(imp->trace);
+    free(imp);
+    return 0;
+}
+
+int import_next_job(Importer *imp, ImportJob *job) {
+    while (!imp->error) {
+        if (imp->num_jobs > 0 && (imp->at_end || imp->jobs[0].arrival <= import_watermark(imp))) {
+            *job = import_pop_job(imp);
+            return 1;
+        }
+        if (imp->at_end) return 0;
+
+        /* a line opens at most two jobs and finishes at most one */
+        if (imp->open_count > IMPORT_OPEN_CAPACITY - 2) {
+            import_compact_open(imp);
+        }
+        if (imp->num_jobs >= IMPORT_WINDOW - 1) {
+            import_split_oldest(imp);
+            continue;
+        }
+
+        if (fgets(imp->line, sizeof(imp->line), imp->trace) == NULL) {
+            import_finish(imp);
+            imp->at_end = 1;
+            continue;
+        }
+        if (strchr(imp->line, '\n') == NULL) {
+            int c;
+            while ((c = fgetc(imp->trace)) != EOF && c != '\n');
+        }
+        imp->summary->lines++;
+        if (import_line(imp, imp->line) != 0) {
+            imp->error = 1;
+        }
+    }
+    return -1;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions apply the trace's events to the runnable tasks.
+/
+/  Functions and Their Purpose:
+/    - import_line: Parses one line. Lines that are not sched_switch,
+/      sched_wakeup or sched_wakeup_new events are skipped. Both the
+/      "key=value" form of the events and the shorter "comm:pid [prio]"
+/      form printed by perf are understood.
+/    - import_wakeup: Opens a job for a task that was not runnable.
+/    - import_switch: Charges the CPU time of the task switched out,
+/      ending its job if it went to sleep, and starts the task switched
+/      in, opening a job for it if it had none.
+/    - import_begin_job: Opens a job for a task, now.
+/    - import_end_job: Ends a task's job, now, recording its metrics
+/      under the kernel's schedule and queueing it to be written. Jobs
+/      that never ran are dropped, and bursts are at least 1.
+/    - import_split_oldest: Ends the oldest open job where it stands
+/      and opens another for its task, so finished jobs can be written.
+/    - import_finish: Ends every open job at the end of the trace.
+/
+/  Input Parameters:
+/    - Importer *imp: the importer
+/    - char *line: a line of the trace
+/    - int pid, prev_pid, next_pid: task IDs (0 is the idle task)
+/    - int priority, next_priority: kernel priorities
+/    - int prev_runnable: 1 if the task switched out was preempted
+/      rather than put to sleep
+/    - ImportTask *task: a runnable task
+/
+/  Output:
+/    - import_line, import_wakeup, import_switch, import_begin_job: 0 on
+/      success, 1 on failure
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - every CPU's idle task has pid 0, and is ignored
+/------------------------------------------------------------------------*/
+int import_line(Importer *imp, char *line) {
+    static const char *events[] = {"sched_switch:", "sched_wakeup_new:", "sched_wakeup:"};
+    const char *event = NULL;
+    const char *payload;
+    char state[16] = "";
+    long long time;
+    int kind = -1;
+    int cpu;
+
+    for (int e = 0; e < 3 && event == NULL; e++) {
+        event = strstr(line, events[e]);
+        kind = e;
+    }
+    if (event == NULL || line[0] == '#') return 0;
+    payload = event + strlen(events[kind]);
+
+    if (parse_time(line, event, &time) != 0) {
+        fprintf(stderr, "Error: no timestamp on line %lld of the kernel trace.\n", imp->summary->lines);
+        return 1;
+    }
+    if (!imp->has_base) {
+        imp->base = time;
+        imp->has_base = 1;
+    }
+    time -= imp->base;
+    if (time > imp->now) imp->now = time;
+    imp->summary->span = imp->now;
+    imp->summary->events++;
+
+    cpu = parse_cpu(line, event);
+    if (cpu + 1 > imp->summary->cpus) imp->summary->cpus = cpu + 1;
+
+    if (kind == 0) {
+        const char *arrow = strstr(payload, "==>");
+        int prev_pid, prev_priority, next_pid, next_priority;
+        char value[32];
+
+        if (arrow == NULL) {
+            fprintf(stderr, "Error: malformed sched_switch on line %lld of the kernel trace.\n",
+                    imp->summary->lines);
+            return 1;
+        }
+        if (parse_field(payload, "prev_pid=", value, sizeof(value)) == 0) {
+            prev_pid = atoi(value);
+            parse_field(payload, "prev_state=", state, sizeof(state));
+            next_pid = parse_field(arrow, "next_pid=", value, sizeof(value)) == 0 ? atoi(value) : 0;
+            next_priority = parse_field(arrow, "next_prio=", value, sizeof(value)) == 0 ? atoi(value) : 0;
+        } else if (parse_task(payload, &prev_pid, &prev_priority, state, sizeof(state)) != 0 ||
+                   parse_task(arrow + 3, &next_pid, &next_priority, NULL, 0) != 0) {
+            fprintf(stderr, "Error: malformed sched_switch on line %lld of the kernel trace.\n",
+                    imp->summary->lines);
+            return 1;
+        }
+        return import_switch(imp, prev_pid, state[0] == 'R', next_pid, next_priority);
+    } else {
+        int pid, priority;
+        char value[32];
+
+        if (parse_field(payload, "pid=", value, sizeof(value)) == 0) {
+            pid = atoi(value);
+            priority = parse_field(payload, "prio=", value, sizeof(value)) == 0 ? atoi(value) : 0;
+        } else if (parse_task(payload, &pid, &priority, NULL, 0) != 0) {
+            fprintf(stderr, "Error: malformed sched_wakeup on line %lld of the kernel trace.\n",
+                    imp->summary->lines);
+            return 1;
+        }
+        return import_wakeup(imp, pid, priority);
+    }
+}
+
+int import_wakeup(Importer *imp, int pid, int priority) {
+    if (pid == 0 || import_find(imp, pid) != NULL) return 0;
+    return import_begin_job(imp, NULL, pid, priority);
+}
+
+int import_switch(Importer *imp, int prev_pid, int prev_runnable, int next_pid, int next_priority) {
+    ImportTask *task;
+
+    if (prev_pid != 0 && (task = import_find(imp, prev_pid)) != NULL) {
+        if (task->running) {
+            task->burst += imp->now - task->run_start;
+            task->running = 0;
+        }
+        if (!prev_runnable) {
+            import_end_job(imp, task);
+            import_remove(imp, task);
+        }
+    }
+
+    if (next_pid != 0) {
+        task = import_find(imp, next_pid);
+        if (task == NULL) {
+            if (import_begin_job(imp, NULL, next_pid, next_priority) != 0) return 1;
+            task = import_find(imp, next_pid);
+        }
+        task->priority = next_priority;
+        task->running = 1;
+        task->run_start = imp->now;
+        if (task->first_run < 0) task->first_run = imp->now;
+    }
+    return 0;
+}
+
+int import_begin_job(Importer *imp, ImportTask *task, int pid, int priority) {
+    if (task == NULL) {
+        task = import_insert(imp, pid);
+        if (task == NULL) {
+            fprintf(stderr, "Error: more than %d tasks are runnable at once in the kernel trace.\n",
+                    IMPORT_MAX_TASKS / 2);
+            return 1;
+        }
+        task->priority = priority;
+        task->running = 0;
+    }
+    task->arrival = imp->now;
+    task->first_run = task->running ? imp->now : -1;
+    task->run_start = imp->now;
+    task->burst = 0;
+    task->generation = ++imp->generation;
+    import_push_open(imp, task);
+    return 0;
+}
+
+void import_end_job(Importer *imp, ImportTask *task) {
+    ImportSummary *summary = imp->summary;
+    ImportJob job;
+    long long turnaround;
+
+    if (task->running) {
+        task->burst += imp->now - task->run_start;
+        task->run_start = imp->now;
+    }
+    if (task->first_run < 0) return;
+
+    job.arrival = task->arrival;
+    job.burst = task->burst > 0 ? task->burst : 1;
+    job.priority = task->priority;
+    job.seq = imp->seq++;
+    import_push_job(imp, &job);
+
+    turnaround = imp->now - task->arrival;
+    summary->jobs++;
+    summary->turnaround_sum += turnaround;
+    summary->waiting_sum += turnaround > job.burst ? turnaround - job.burst : 0;
+    summary->response_sum += task->first_run - task->arrival;
+}
+
+void import_split_oldest(Importer *imp) {
+    ImportTask *task = import_oldest(imp);
+
+    if (task == NULL) return;
+    if (task->first_run >= 0) {
+        import_end_job(imp, task);
+        imp->summary->split++;
+    }
+    import_begin_job(imp, task, task->pid, task->priority);
+}
+
+void import_finish(Importer *imp) {
+    for (int i = 0; i < IMPORT_MAX_TASKS; i++) {
+        if (imp->tasks[i].pid != 0) {
+            import_end_job(imp, &imp->tasks[i]);
+        }
+    }
+    imp->open_count = 0;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions keep the open jobs in the order they arrived.
+/    Jobs are only appended; an entry goes stale when its task ends
+/    or restarts its job, and stale entries are skipped at the front
+/    and squeezed out when the ring fills.
+/
+/  Functions and Their Purpose:
+/    - import_watermark: Returns the arrival of the oldest open job,
+/      or LLONG_MAX if there is none.
+/    - import_oldest: Returns the task of the oldest open job, or NULL.
+/    - import_push_open: Appends a task's job.
+/    - import_compact_open: Removes the stale entries.
+/
+/  Input Parameters:
+/    - Importer *imp: the importer
+/    - ImportTask *task: the task whose job opened
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the ring holds twice as many entries as there can be tasks, so
+/      compacting it always frees room
+/------------------------------------------------------------------------*/
+long long import_watermark(Importer *imp) {
+    ImportTask *task = import_oldest(imp);
+    return task != NULL ? task->arrival : LLONG_MAX;
+}
+
+ImportTask *import_oldest(Importer *imp) {
+    while (imp->open_count > 0) {
+        ImportOpen *front = &imp->open[imp->open_head];
+        ImportTask *task = import_find(imp, front->pid);
+
+        if (task != NULL && task->generation == front->generation) return task;
+        imp->open_head = (imp->open_head + 1) % IMPORT_OPEN_CAPACITY;
+        imp->open_count--;
+    }
+    return NULL;
+}
+
+void import_push_open(Importer *imp, ImportTask *task) {
+    ImportOpen *entry = &imp->open[(imp->open_head + imp->open_count) % IMPORT_OPEN_CAPACITY];
+
+    entry->pid = task->pid;
+    entry->generation = task->generation;
+    imp->open_count++;
+}
+
+void import_compact_open(Importer *imp) {
+    int kept = 0;
+
+    for (int i = 0; i < imp->open_count; i++) {
+        ImportOpen entry = imp->open[(imp->open_head + i) % IMPORT_OPEN_CAPACITY];
+        ImportTask *task = import_find(imp, entry.pid);
+
+        if (task != NULL && task->generation == entry.generation) {
+            imp->open[(imp->open_head + kept) % IMPORT_OPEN_CAPACITY] = entry;
+            kept++;
+        }
+    }
+    imp->open_count = kept;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions manage the table of runnable tasks and the heap
+/    of finished jobs.
+/
+/  Functions and Their Purpose:
+/    - import_find: Returns the task with the given pid, or NULL.
+/    - import_insert: Adds a task, returning NULL if the table is more
+/      than half full.
+/    - import_remove: Removes a task, moving back the entries after it
+/      so that lookups never need tombstones.
+/    - import_push_job, import_pop_job: Add a finished job to the heap,
+/      and take the earliest one out.
+/    - job_before: Orders jobs by arrival, then by when they finished.
+/
+/  Input Parameters:
+/    - Importer *imp: the importer
+/    - int pid: a task ID
+/    - ImportTask *task: a task in the table
+/    - ImportJob *job, *a, *b: finished jobs
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - IMPORT_MAX_TASKS must be a power of two
+/------------------------------------------------------------------------*/
+ImportTask *import_find(Importer *imp, int pid) {
+    unsigned int slot = ((unsigned int)pid * 2654435761u) & (IMPORT_MAX_TASKS - 1);
+
+    while (imp->tasks[slot].pid != 0) {
+        if (imp->tasks[slot].pid == pid) return &imp->tasks[slot];
+        slot = (slot + 1) & (IMPORT_MAX_TASKS - 1);
+    }
+    return NULL;
+}
+
+ImportTask *import_insert(Importer *imp, int pid) {
+    unsigned int slot = ((unsigned int)pid * 2654435761u) & (IMPORT_MAX_TASKS - 1);
+
+    if (imp->num_tasks >= IMPORT_MAX_TASKS / 2) return NULL;
+    while (imp->tasks[slot].pid != 0) {
+        slot = (slot + 1) & (IMPORT_MAX_TASKS - 1);
+    }
+    memset(&imp->tasks[slot], 0, sizeof(ImportTask));
+    imp->tasks[slot].pid = pid;
+    imp->num_tasks++;
+    return &imp->tasks[slot];
+}
+
+void import_remove(Importer *imp, ImportTask *task) {
+    unsigned int hole = task - imp->tasks;
+    unsigned int slot = hole;
+
+    for (;;) {
+        unsigned int home;
+
+        slot = (slot + 1) & (IMPORT_MAX_TASKS - 1);
+        if (imp->tasks[slot].pid == 0) break;
+        home = ((unsigned int)imp->tasks[slot].pid * 2654435761u) & (IMPORT_MAX_TASKS - 1);
+        /* move the entry back unless its home lies cyclically in (hole, slot] */
+        if (((slot - home) & (IMPORT_MAX_TASKS - 1)) >= ((slot - hole) & (IMPORT_MAX_TASKS - 1))) {
+            imp->tasks[hole] = imp->tasks[slot];
+            hole = slot;
+        }
+    }
+    imp->tasks[hole].pid = 0;
+    imp->num_tasks--;
+}
+
+void import_push_job(Importer *imp, ImportJob *job) {
+    int child = imp->num_jobs++;
+
+    while (child > 0) {
+        int parent = (child - 1) / 2;
+        if (!job_before(job, &imp->jobs[parent])) break;
+        imp->jobs[child] = imp->jobs[parent];
+        child = parent;
+    }
+    imp->jobs[child] = *job;
+}
+
+ImportJob import_pop_job(Importer *imp) {
+    ImportJob top = imp->jobs[0];
+    ImportJob last = imp->jobs[--imp->num_jobs];
+    int parent = 0;
+
+    for (;;) {
+        int child = 2 * parent + 1;
+        if (child >= imp->num_jobs) break;
+        if (child + 1 < imp->num_jobs && job_before(&imp->jobs[child + 1], &imp->jobs[child])) child++;
+        if (!job_before(&imp->jobs[child], &last)) break;
+        imp->jobs[parent] = imp->jobs[child];
+        parent = child;
+    }
+    if (imp->num_jobs > 0) imp->jobs[parent] = last;
+    return top;
+}
+
+int job_before(ImportJob *a, ImportJob *b) {
+    if (a->arrival != b->arrival) return a->arrival < b->arrival;
+    return a->seq < b->seq;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions pick apart a line of the trace. Both tools start
+/    a line with the current task, the CPU in brackets and the
+/    timestamp in seconds followed by a colon; perf then prefixes the
+/    event name with "sched:".
+/
+/  Functions and Their Purpose:
+/    - parse_time: Reads the timestamp before the event name, in
+/      microseconds.
+/    - parse_cpu: Reads the CPU number from the first "[nnn]" before
+/      the event name, or returns 0 if there is none.
+/    - parse_field: Copies the value of "key=value" out of text, where
+/      key starts a word.
+/    - parse_task: Reads "comm:pid [prio] state" (state is optional,
+/      and only read if wanted), the form perf prints.
+/
+/  Input Parameters:
+/    - const char *line, *text: the line, or the part to search
+/    - const char *event: where the event name starts in the line
+/    - long long *time: where to put the timestamp
+/    - const char *key: the key, including its "="
+/    - char *value, *state, size_t size: where to put the value
+/    - int *pid, *priority: where to put the task's ID and priority
+/
+/  Output:
+/    - parse_cpu: the CPU; the others: 0 on success, 1 on failure
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - fractions of a microsecond are dropped
+/------------------------------------------------------------------------*/
+int parse_time(const char *line, const char *event, long long *time) {
+    const char *end = event;
+    const char *start;
+    long long seconds = 0, micros = 0;
+    int digits = 0;
+
+    if (end - line >= 6 && strncmp(end - 6, "sched:", 6) == 0) end -= 6;
+    while (end > line && end[-1] == ' ') end--;
+    if (end == line || end[-1] != ':') return 1;
+    end--;
+    start = end;
+    while (start > line && start[-1] != ' ') start--;
+    if (start == end) return 1;
+
+    for (const char *c = start; c < end; c++) {
+        if (*c == '.') {
+            digits = 1;
+        } else if (*c < '0' || *c > '9') {
+            return 1;
+        } else if (digits == 0) {
+            seconds = seconds * 10 + (*c - '0');
+        } else if (digits++ <= 6) {
+            micros = micros * 10 + (*c - '0');
+        }
+    }
+    for (; digits > 0 && digits <= 6; digits++) micros *= 10;
+
+    *time = seconds * 1000000 + micros;
+    return 0;
+}
+
+int parse_cpu(const char *line, const char *event) {
+    for (const char *c = line; c < event; c++) {
+        if (*c == '[' && c[1] >= '0' && c[1] <= '9') {
+            int cpu = 0;
+            c++;
+            while (*c >= '0' && *c <= '9') cpu = cpu * 10 + (*c++ - '0');
+            if (*c == ']') return cpu;
+        }
+    }
+    return 0;
+}
+
+int parse_field(const char *text, const char *key, char *value, size_t size) {
+    const char *found = text;
+    size_t length = 0;
+
+    while ((found = strstr(found, key)) != NULL) {
+        if (found == text || found[-1] == ' ') break;
+        found++;
+    }
+    if (found == NULL) return 1;
+
+    found += strlen(key);
+    while (found[length] != '\0' && found[length] != ' ' && found[length] != '\n' && length + 1 < size) {
+        value[length] = found[length];
+        length++;
+    }
+    value[length] = '\0';
+    return 0;
+}
+
+int parse_task(const char *text, int *pid, int *priority, char *state, size_t size) {
+    const char *bracket = strstr(text, " [");
+    const char *colon;
+
+    /* the command may itself hold " [", so find the one after a pid */
+    while (bracket != NULL) {
+        colon = bracket;
+        while (colon > text && colon[-1] >= '0' && colon[-1] <= '9') colon--;
+        if (colon < bracket && colon > text && colon[-1] == ':' && bracket[2] >= '0' && bracket[2] <= '9') break;
+        bracket = strstr(bracket + 1, " [");
+    }
+    if (bracket == NULL) return 1;
+
+    *pid = atoi(colon);
+    *priority = atoi(bracket + 2);
+    if (state != NULL) {
+        const char *close = strchr(bracket, ']');
+        size_t length = 0;
+
+        if (close == NULL) return 1;
+        close++;
+        while (*close == ' ') close++;
+        while (close[length] != '\0' && close[length] != ' ' && length + 1 < size) {
+            state[length] = close[length];
+            length++;
+        }
+        state[length] = '\0';
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   import.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef IMPORT_H
+#define IMPORT_H
+
+#include <stdio.h>
+
+#define IMPORT_MAX_TASKS 65536
+#define IMPORT_WINDOW 65536
+
+/*---------- STRUCTURE: ImportSummary ----------------------
+/  Structure Description:
+/    What a kernel trace contained, and how the kernel itself
+/    scheduled the jobs read from it, for comparison with the
+/    simulated policies.
+/
+/  Fields:
+/    long long lines
+/      Lines of the trace read
+/    long long events
+/      sched_switch and sched_wakeup events among them
+/    long long jobs
+/      Jobs (wakeup to sleep) reconstructed
+/    long long split
+/      Jobs cut short because their task stayed runnable for longer
+/      than the reorder window allows
+/    int cpus
+/      Number of CPUs seen in the trace
+/    long long span
+/      Time from the first event to the last, in microseconds
+/    long long turnaround_sum, waiting_sum, response_sum
+/      Totals of the jobs' metrics under the kernel's schedule
+/
+/  Relationships:
+/    - filled in as the FILE returned by import_open is read
+/---------------------------------------------------------*/
+typedef struct {
+    long long lines;
+    long long events;
+    long long jobs;
+    long long split;
+    int cpus;
+    long long span;
+    long long turnaround_sum;
+    long long waiting_sum;
+    long long response_sum;
+} ImportSummary;
+
+FILE *import_open(FILE *trace, int with_priority, ImportSummary *summary);
+
+#endif
@@ -27,6 +27,77 @@
 /      The full pathway of the input file.
 /    char output_file[256]
 /      The full pathway of the output file.
+/    char trace_file[256]
+/      The full pathway of the Chrome trace-event file, or empty if
+/      no trace should be written.
+/    int time_quantum
+/      The Round Robin time quantum, or 0 if the user should be 
+/      prompted for one.
+/    int quantum_mode
+/      QUANTUM_FIXED, or the adaptive Round Robin quantum to use 
+/      (--quantum).
+/    int stream
+/      1 to run the streaming simulator (-s), 0 otherwise.
+/    char window_file[256]
+/      The full pathway of the time series CSV file, or empty.
+/    long long window_width
+/      The length of each window of the time series, or 0.
+/    int stats
+/      0 for no statistics, 1 to print them as a table (--stats), 
+/      2 to print them as JSON (--stats=json).
+/    int replications
+/      The number of Monte Carlo replications to run (-e), or 0 for a
+/      single simulation of the input.
+/    int threads
+/      The number of threads to run the replications on, or 0 for one 
+/      per CPU.
+/    unsigned long long seed
+/      The seed the replications' workloads are generated from.
+/    char workload[64]
+/      The generated workload's shape as "count,gap,burst[,priorities]",
+/      or empty for the defaults.
+/    int sweep
+/      1 to run the replications as a sweep on worker processes 
+/      (--sweep), 0 to run them as an ensemble on threads.
+/    int workers
+/      The number of worker processes for a sweep, or 0 for one per CPU.
+/    char quanta[256]
+/      The RR time quanta a sweep covers, comma separated, or empty.
+/    char loads[256]
+/      The mean arrival gaps a sweep covers, comma separated, or empty.
+/    int format
+/      REPORT_TEXT for the usual tables, or REPORT_JSON or REPORT_CSV 
+/      for a machine-readable report (--format).
+/    int events
+/      1 to include the event list in the report (--events).
+/    char kernel_trace[256]
+/      The full pathway of a kernel scheduler trace to import (-k), 
+/      "-" for stdin, or empty.
+/    char convert_file[256]
+/      The full pathway of a binary workload to write the text input 
+/      to (--convert), or empty.
+/    int sort
+/      1 to sort the input by arrival time before streaming it (--sort).
+/    long long sort_memory
+/      Bytes of memory the sort may buffer (--sort-memory).
+/    char decision_cost[64]
+/      The scheduler-decision cost model, "model[,base[,per]]" 
+/      (--decision-cost), or empty for free decisions.
+/    char cache_penalty[64]
+/      The cache warm-up model, "working_set[,decay]" 
+/      (--cache-penalty), or empty for no refills.
+/    char cores[128]
+/      The cores to stream on, "count[xspeed],..." (--cores), or empty
+/      for a single CPU.
+/    int placement
+/      The PLACE_* policy that places processes on the cores 
+/      (--placement), or -1 if not given.
+/    int gang
+/      The GANG_* mode that co-schedules the threads of a process on 
+/      the cores (--gang), or -1 if not given.
+/    char groups_file[256]
+/      The group file processes are scheduled in (--groups), or empty
+/      for no groups.
 /  
 /  Relationships:
 /    N/A - this struct does not feature, and is not featured in, others 
@@ -35,6 +106,33 @@ typedef struct {
     char alg_selection[256];
     char input_file[256];
     char output_file[256];
+    char trace_file[256];
+    int time_quantum;
+    int quantum_mode;
+    int stream;
+    char window_file[256];
+    long long window_width;
+    int stats;
+    int replications;
+    int threads;
+    unsigned long long seed;
+    char workload[64];
+    int sweep;
+    int workers;
+    char quanta[256];
+    char loads[256];
+    int format;
+    int events;
+    char kernel_trace[256];
+    char convert_file[256];
+    int sort;
+    long long sort_memory;
+    char decision_cost[64];
+    char cache_penalty[64];
+    char cores[128];
+    int placement;
+    int gang;
+    char groups_file[256];
 } Options;
 
 
@@ -15,57 +15,97 @@
 /    A custom data type representing a process. Contains attributes
 /    and info on the current state to help the simulator track processes 
 /    while they run using different scheduling algorithms and to calculate
-/    performance metrics.
+/    performance metrics. All times are 64-bit, so that long runs and 
+/    long bursts cannot overflow the simulated clock.
 /    
 /  Fields:
 /    char id[10];            
 /      Process ID 
-/    int arrival_time;       
+/    int threads;
+/      Number of threads, which a multi-core run may have to 
+/      co-schedule (see cores.h); 1 unless the input gives more
+/    long long arrival_time;       
 /      Time at which the process arrives 
-/    int burst_time;         
+/    long long burst_time;         
 /      Total CPU burst time 
 /    int priority;           
 /      Priority level (lower value = higher priority) 
-/    int remaining_time;     
+/    int core;
+/      The core the process last ran on in a multi-core run, or -1
+/      (kept beside priority, where it fills the padding)
+/    long long remaining_time;     
 /      Remaining burst time (used for RR and pre-emptive algorithms)
-/    int start_time;         
+/    long long start_time;         
 /      Time that the process starts execution
-/    int completion_time;    
+/    long long completion_time;    
 /      Time that the process finishes execution
-/    int turnaround_time;    
+/    long long turnaround_time;    
 /      Time to process to complete execution. 
 /      Calculated as: turnaround_time = completion_time - arrival_time
-/    int waiting_time;
+/    long long waiting_time;
 /      Total time process waits in ready queue.       
 /      Calculated as: waiting_time = turnaround_time - burst_time
-/    int response_time;
+/    long long response_time;
 /      Total time it takes a process to execute from its arrival. 
 /      Calculated as: response_time = start_time - arrival_time 
-/    int predicted_burst;
+/    long long predicted_burst;
 /      Predicted CPU burst time for preemptive algorithms.
 /    int has_started;
 /      Flag to indicate if a process has started executing (1 = true, 0 = false) 
-/    int running_time[999];
-/      Used to track the time slots when a process runs. 
+/    int index;
+/      Position of the process in the input. Stays the same when the 
+/      array is sorted, so the Timeline uses it to identify processes.
+/    int dispatches;
+/      Times the process was put on the CPU after another process (or 
+/      none) had it. A process that keeps the CPU when its time slice 
+/      ends is not dispatched again.
+/    int preemptions;
+/      Times a process that had arrived took the CPU from it 
+/      (SRTF and PPS)
+/    int expirations;
+/      Times its time slice ended with another process waiting (RR)
+/    int working_set;
+/      Time it takes the process to reload its cache working set from 
+/      cold, used by the cache model (see cache.h)
+/    double cache_stamp;
+/      The process's cache warmth, as the CPU busy time at which it 
+/      was last fully warm (minus infinity if it has not run)
+/    double work_carried;
+/      The part of a unit of work it has done on a slow core beyond
+/      its remaining_time (from 0 up to 1), kept when it leaves the
+/      core so that the next run finishes the unit
+/    int group;
+/      Index of the process's group in the run's group tree (see 
+/      groups.h); 0, the root, if there are no groups
 /  Relationships:
 /    - one of the most fundamental data structures of the program 
 /    - CircularQueue maintains an array of this type to simulate the ready queue 
 /      for the various scheduling algorithms
+/    - Timeline segments refer to processes by their index member
 /---------------------------------------------------------*/
 typedef struct {
     char id[10];            
-    int arrival_time;       
-    int burst_time;         
+    int threads;
+    long long arrival_time;       
+    long long burst_time;         
     int priority;
-    int remaining_time;     
-    int start_time;         
-    int completion_time;    
-    int turnaround_time;    
-    int waiting_time;       
-    int response_time;
-    int predicted_burst;
+    int core;
+    long long remaining_time;     
+    long long start_time;         
+    long long completion_time;    
+    long long turnaround_time;    
+    long long waiting_time;       
+    long long response_time;
+    long long predicted_burst;
     int has_started;
-    int running_time[999];
+    int index;
+    int dispatches;
+    int preemptions;
+    int expirations;
+    int working_set;
+    double cache_stamp;
+    double work_carried;
+    int group;
 } Process;
 
 
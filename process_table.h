@@ -0,0 +1,83 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   process_table.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include "process.h"
+#include "arena.h"
+
+/*---------- STRUCTURE: ProcessTable -----------------------
+/  Structure Description:
+/    A column-oriented (struct-of-arrays) copy of the timing fields of
+/    a set of processes. Each field is stored in its own contiguous
+/    array, so a pass over one metric only reads the columns it needs
+/    and the compiler can process several processes per instruction.
+/
+/  Fields:
+/    long long *arrival, *burst, *start, *completion
+/      Input columns, copied from the processes by table_load
+/    long long *turnaround, *waiting, *response
+/      Derived columns, filled in by table_compute_metrics
+/    int count
+/      Number of rows in use
+/    int capacity
+/      Number of rows allocated (all columns share one allocation)
+/    Arena *arena
+/      Where the columns are allocated, or NULL for the heap
+/
+/  Relationships:
+/    - loaded from an array of Process structs
+/    - used by calculate_results to summarize a run
+/---------------------------------------------------------*/
+typedef struct {
+    long long *arrival;
+    long long *burst;
+    long long *start;
+    long long *completion;
+    long long *turnaround;
+    long long *waiting;
+    long long *response;
+    int count;
+    int capacity;
+    Arena *arena;
+} ProcessTable;
+
+/*---------- STRUCTURE: MetricSummary ----------------------
+/  Structure Description:
+/    Aggregate statistics of one per-process metric.
+/
+/  Fields:
+/    long long sum, min, max
+/      Total, smallest and largest value
+/    double mean
+/      Average value
+/    double variance
+/      Population variance
+/
+/  Relationships:
+/    - filled in by table_compute_metrics
+/    - contained in SimResult
+/---------------------------------------------------------*/
+typedef struct {
+    long long sum;
+    long long min;
+    long long max;
+    double mean;
+    double variance;
+} MetricSummary;
+
+void init_process_table(ProcessTable *table, Arena *arena);
+void free_process_table(ProcessTable *table);
+void table_reserve(ProcessTable *table, int capacity);
+void table_load(ProcessTable *table, const Process processes[], int num_processes);
+void table_compute_metrics(ProcessTable *table, MetricSummary *turnaround, MetricSummary *waiting, MetricSummary *response);
+
+#endif
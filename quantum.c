@@ -0,0 +1,412 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   quantum.c
+/
+/  File Description:
+/    This file implements Round Robin's time slice policies: the
+/    fixed quantum, and adaptive quanta that follow the median or mean
+/    remaining burst time of the ready queue, or share a target
+/    latency between the ready processes.
+/
+/    The simulators tell the policy as processes join and leave the
+/    ready queue, and it keeps the statistics it needs as they do: a
+/    count and a sum for the mean and latency policies, and for the
+/    median an order-statistic treap (a binary search tree, kept
+/    balanced by random heap priorities, whose nodes count their
+/    subtrees), so that adding, removing and finding the median each
+/    take O(log n) expected time however long the queue grows.
+/
+/  Citations:
+/  - Seidel and Aragon, "Randomized Search Trees", Algorithmica 16
+/    (1996)
+/  - Cormen et al., Introduction to Algorithms, 3rd ed., section 14.1,
+/    "Dynamic order statistics"
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "quantum.h"
+
+#define QUANTUM_INITIAL_NODES 64
+
+int node_new(QuantumPolicy *policy, long long value);
+void node_free(QuantumPolicy *policy, int node);
+long long node_size(QuantumPolicy *policy, int node);
+void node_update(QuantumPolicy *policy, int node);
+int treap_insert(QuantumPolicy *policy, int root, int node);
+void treap_split(QuantumPolicy *policy, int root, long long value, int *left, int *right);
+int treap_merge(QuantumPolicy *policy, int left, int right);
+int treap_erase(QuantumPolicy *policy, int root, long long value);
+int treap_find(QuantumPolicy *policy, long long value);
+void treap_adjust(QuantumPolicy *policy, long long value, long long change);
+long long treap_select(QuantumPolicy *policy, long long k);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions start, feed and query a time slice policy.
+/
+/  Functions and Their Purpose:
+/    - quantum_init: Starts a policy with an empty ready queue.
+/    - quantum_release: Gives back the policy's node array.
+/    - quantum_add: Records a process joining the ready queue.
+/    - quantum_remove: Records a process leaving the ready queue.
+/    - quantum_next: Gives the time slice for the next dispatch, from
+/      the processes in the ready queue (including the one being
+/      dispatched, which should be removed afterwards).
+/    - quantum_mode: Converts the name of a policy, as given with
+/      --quantum, to its QUANTUM_* value.
+/    - quantum_mode_name: Gives the name of a policy.
+/
+/  Input Parameters:
+/    - QuantumPolicy *policy: the policy
+/    - int mode: QUANTUM_*
+/    - int quantum: the time quantum given for the run
+/    - Arena *arena: where to allocate, or NULL for the heap
+/    - long long remaining: the process's remaining burst time
+/    - const char *name: "fixed", "median", "mean" or "latency", in
+/      any case
+/
+/  Output:
+/    - quantum_next: the time slice, at least 1
+/    - quantum_mode: the policy, or -1 if the name is not recognized
+/    - quantum_mode_name: the name
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - a process must be removed with the remaining time it was added
+/      with
+/    - the fixed policy keeps no statistics, so it costs nothing
+/    - the median is the lower one when the queue's length is even
+/    - if a node cannot be allocated, quantum_add leaves the process
+/      out of the median; the arena is marked failed, so the run
+/      reports the failure when it ends
+/------------------------------------------------------------------------*/
+void quantum_init(QuantumPolicy *policy, int mode, int quantum, Arena *arena) {
+    memset(policy, 0, sizeof(QuantumPolicy));
+    policy->mode = mode;
+    policy->quantum = quantum;
+    policy->root = -1;
+    policy->free_list = -1;
+    policy->seed = 2463534242u;
+    policy->arena = arena;
+}
+
+void quantum_release(QuantumPolicy *policy) {
+    arena_release(policy->arena, policy->nodes);
+    policy->nodes = NULL;
+    policy->capacity = 0;
+}
+
+void quantum_add(QuantumPolicy *policy, long long remaining) {
+    if (policy->mode == QUANTUM_FIXED) return;
+    policy->count++;
+    policy->sum += remaining;
+
+    if (policy->mode != QUANTUM_MEDIAN) return;
+    if (treap_find(policy, remaining) >= 0) {
+        treap_adjust(policy, remaining, 1);
+    } else {
+        int node = node_new(policy, remaining);
+        if (node >= 0) policy->root = treap_insert(policy, policy->root, node);
+    }
+}
+
+void quantum_remove(QuantumPolicy *policy, long long remaining) {
+    int node;
+
+    if (policy->mode == QUANTUM_FIXED) return;
+    policy->count--;
+    policy->sum -= remaining;
+
+    if (policy->mode != QUANTUM_MEDIAN) return;
+    node = treap_find(policy, remaining);
+    if (node < 0) return;
+    if (policy->nodes[node].count > 1) {
+        treap_adjust(policy, remaining, -1);
+    } else {
+        policy->root = treap_erase(policy, policy->root, remaining);
+    }
+}
+
+long long quantum_next(QuantumPolicy *policy) {
+    long long slice = policy->quantum;
+
+    if (policy->count < 1) return policy->quantum > 0 ? policy->quantum : 1;
+
+    switch (policy->mode) {
+        case QUANTUM_MEDIAN:
+            slice = treap_select(policy, (policy->count - 1) / 2);
+            if (slice < policy->quantum) slice = policy->quantum;
+            break;
+        case QUANTUM_MEAN:
+            slice = (policy->sum + policy->count - 1) / policy->count;
+            if (slice < policy->quantum) slice = policy->quantum;
+            break;
+        case QUANTUM_LATENCY:
+            slice = (policy->quantum + policy->count - 1) / policy->count;
+            break;
+    }
+    return slice > 0 ? slice : 1;
+}
+
+int quantum_mode(const char *name) {
+    if (strcasecmp(name, "fixed") == 0) return QUANTUM_FIXED;
+    if (strcasecmp(name, "median") == 0) return QUANTUM_MEDIAN;
+    if (strcasecmp(name, "mean") == 0) return QUANTUM_MEAN;
+    if (strcasecmp(name, "latency") == 0) return QUANTUM_LATENCY;
+    return -1;
+}
+
+const char *quantum_mode_name(int mode) {
+    switch (mode) {
+        case QUANTUM_MEDIAN: return "median";
+        case QUANTUM_MEAN: return "mean";
+        case QUANTUM_LATENCY: return "latency";
+        default: return "fixed";
+    }
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions manage the treap's nodes, which live in one
+/    growable array and refer to each other by index, so that growing
+/    the array does not invalidate them.
+/
+/  Functions and Their Purpose:
+/    - node_new: Takes a node from the free list, or from the end of
+/      the array (growing it if full), holding one process of value.
+/    - node_free: Puts a node on the free list.
+/    - node_size: The size of a node's subtree, 0 for -1.
+/    - node_update: Recalculates a node's size from its children.
+/
+/  Input Parameters:
+/    - QuantumPolicy *policy: the policy
+/    - long long value: the new node's remaining time
+/    - int node: a node's index
+/
+/  Output:
+/    - node_new: the node's index, or -1 if the array cannot be grown
+/      (the arena is then marked failed)
+/    - node_size: see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - pointers into the array are not held across node_new
+/------------------------------------------------------------------------*/
+int node_new(QuantumPolicy *policy, long long value) {
+    QuantumNode *node;
+    int index;
+
+    if (policy->free_list >= 0) {
+        index = policy->free_list;
+        policy->free_list = policy->nodes[index].left;
+    } else {
+        if (policy->num_nodes == policy->capacity) {
+            int capacity = policy->capacity ? policy->capacity * 2 : QUANTUM_INITIAL_NODES;
+            QuantumNode *nodes = arena_grow(policy->arena, policy->nodes,
+                                            policy->capacity * sizeof(QuantumNode),
+                                            capacity * sizeof(QuantumNode));
+
+            if (nodes == NULL) return -1;
+            policy->nodes = nodes;
+            policy->capacity = capacity;
+        }
+        index = policy->num_nodes++;
+    }
+
+    /* xorshift32 */
+    policy->seed ^= policy->seed << 13;
+    policy->seed ^= policy->seed >> 17;
+    policy->seed ^= policy->seed << 5;
+
+    node = &policy->nodes[index];
+    node->value = value;
+    node->count = 1;
+    node->size = 1;
+    node->priority = policy->seed;
+    node->left = -1;
+    node->right = -1;
+    return index;
+}
+
+void node_free(QuantumPolicy *policy, int node) {
+    policy->nodes[node].left = policy->free_list;
+    policy->free_list = node;
+}
+
+long long node_size(QuantumPolicy *policy, int node) {
+    return node < 0 ? 0 : policy->nodes[node].size;
+}
+
+void node_update(QuantumPolicy *policy, int node) {
+    QuantumNode *n = &policy->nodes[node];
+    n->size = n->count + node_size(policy, n->left) + node_size(policy, n->right);
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions are the treap's operations. Nodes are ordered by
+/    value as a search tree and by priority as a max-heap.
+/
+/  Functions and Their Purpose:
+/    - treap_insert: Inserts a node whose value is not yet in the
+/      tree, splitting the subtree it lands on by its value.
+/    - treap_split: Splits a subtree into the nodes below value and
+/      those above it.
+/    - treap_merge: Joins two subtrees, every value of left being
+/      below every value of right.
+/    - treap_erase: Removes the node holding value.
+/    - treap_find: Finds the node holding value.
+/    - treap_adjust: Changes the count of value's node, and the size
+/      of every node on the way to it, by change.
+/    - treap_select: Finds the k-th smallest remaining time, counting
+/      from 0 and counting each process.
+/
+/  Input Parameters:
+/    - QuantumPolicy *policy: the policy
+/    - int root: the subtree to work on
+/    - int node: the node to insert
+/    - long long value: the value to split at, remove, find or adjust
+/    - int *left, *right: the subtrees split off
+/    - int left, right: the subtrees to join
+/    - long long change: +1 or -1
+/    - long long k: the rank, below the number of processes
+/
+/  Output:
+/    - treap_insert, treap_merge, treap_erase: the new subtree root
+/    - treap_find: the node's index, or -1
+/    - treap_select: the remaining time of rank k
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - recursion depth is the tree's height, O(log n) expected
+/------------------------------------------------------------------------*/
+int treap_insert(QuantumPolicy *policy, int root, int node) {
+    if (root < 0) return node;
+
+    if (policy->nodes[node].priority > policy->nodes[root].priority) {
+        int left, right;
+        treap_split(policy, root, policy->nodes[node].value, &left, &right);
+        policy->nodes[node].left = left;
+        policy->nodes[node].right = right;
+        node_update(policy, node);
+        return node;
+    }
+
+    if (policy->nodes[node].value < policy->nodes[root].value) {
+        int child = treap_insert(policy, policy->nodes[root].left, node);
+        policy->nodes[root].left = child;
+    } else {
+        int child = treap_insert(policy, policy->nodes[root].right, node);
+        policy->nodes[root].right = child;
+    }
+    node_update(policy, root);
+    return root;
+}
+
+void treap_split(QuantumPolicy *policy, int root, long long value, int *left, int *right) {
+    if (root < 0) {
+        *left = -1;
+        *right = -1;
+        return;
+    }
+
+    if (policy->nodes[root].value < value) {
+        int l, r;
+        treap_split(policy, policy->nodes[root].right, value, &l, &r);
+        policy->nodes[root].right = l;
+        *left = root;
+        *right = r;
+    } else {
+        int l, r;
+        treap_split(policy, policy->nodes[root].left, value, &l, &r);
+        policy->nodes[root].left = r;
+        *left = l;
+        *right = root;
+    }
+    node_update(policy, root);
+}
+
+int treap_merge(QuantumPolicy *policy, int left, int right) {
+    if (left < 0) return right;
+    if (right < 0) return left;
+
+    if (policy->nodes[left].priority > policy->nodes[right].priority) {
+        int child = treap_merge(policy, policy->nodes[left].right, right);
+        policy->nodes[left].right = child;
+        node_update(policy, left);
+        return left;
+    }
+
+    {
+        int child = treap_merge(policy, left, policy->nodes[right].left);
+        policy->nodes[right].left = child;
+        node_update(policy, right);
+        return right;
+    }
+}
+
+int treap_erase(QuantumPolicy *policy, int root, long long value) {
+    int child;
+
+    if (root < 0) return -1;
+
+    if (policy->nodes[root].value == value) {
+        int merged = treap_merge(policy, policy->nodes[root].left, policy->nodes[root].right);
+        node_free(policy, root);
+        return merged;
+    }
+
+    if (value < policy->nodes[root].value) {
+        child = treap_erase(policy, policy->nodes[root].left, value);
+        policy->nodes[root].left = child;
+    } else {
+        child = treap_erase(policy, policy->nodes[root].right, value);
+        policy->nodes[root].right = child;
+    }
+    node_update(policy, root);
+    return root;
+}
+
+int treap_find(QuantumPolicy *policy, long long value) {
+    int node = policy->root;
+
+    while (node >= 0 && policy->nodes[node].value != value) {
+        node = value < policy->nodes[node].value ? policy->nodes[node].left : policy->nodes[node].right;
+    }
+    return node;
+}
+
+void treap_adjust(QuantumPolicy *policy, long long value, long long change) {
+    int node = policy->root;
+
+    while (node >= 0) {
+        policy->nodes[node].size += change;
+        if (policy->nodes[node].value == value) {
+            policy->nodes[node].count += change;
+            return;
+        }
+        node = value < policy->nodes[node].value ? policy->nodes[node].left : policy->nodes[node].right;
+    }
+}
+
+long long treap_select(QuantumPolicy *policy, long long k) {
+    int node = policy->root;
+
+    while (node >= 0) {
+        long long left_size = node_size(policy, policy->nodes[node].left);
+
+        if (k < left_size) {
+            node = policy->nodes[node].left;
+        } else if (k < left_size + policy->nodes[node].count) {
+            return policy->nodes[node].value;
+        } else {
+            k -= left_size + policy->nodes[node].count;
+            node = policy->nodes[node].right;
+        }
+    }
+    return 0;
+}
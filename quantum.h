@@ -0,0 +1,107 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   quantum.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef QUANTUM_H
+#define QUANTUM_H
+
+#include "arena.h"
+
+#define QUANTUM_FIXED 0
+#define QUANTUM_MEDIAN 1
+#define QUANTUM_MEAN 2
+#define QUANTUM_LATENCY 3
+
+/*---------- STRUCTURE: QuantumNode ------------------------
+/  Structure Description:
+/    A node of the order-statistic treap behind the median quantum:
+/    one distinct remaining burst time, and how many ready processes
+/    have it.
+/
+/  Fields:
+/    long long value
+/      The remaining burst time
+/    long long count
+/      Ready processes with this remaining time
+/    long long size
+/      Ready processes in this node's subtree, itself included
+/    unsigned int priority
+/      The node's random heap priority, which keeps the tree balanced
+/    int left, right
+/      Indices of the children, or -1
+/
+/  Relationships:
+/    - held in QuantumPolicy's node array
+/---------------------------------------------------------*/
+typedef struct {
+    long long value;
+    long long count;
+    long long size;
+    unsigned int priority;
+    int left;
+    int right;
+} QuantumNode;
+
+/*---------- STRUCTURE: QuantumPolicy ----------------------
+/  Structure Description:
+/    Chooses Round Robin's time slice at each dispatch. The fixed
+/    policy always gives the time quantum; the adaptive ones follow
+/    the ready queue, whose statistics are kept up to date as
+/    processes join and leave it rather than by scanning it:
+/      median   the median remaining burst time of the ready queue,
+/               but at least the time quantum
+/      mean     the mean remaining burst time, but at least the time
+/               quantum
+/      latency  the time quantum (a target latency) shared between
+/               the ready processes, so that each runs within that
+/               long, but at least 1
+/
+/  Fields:
+/    int mode
+/      QUANTUM_FIXED, QUANTUM_MEDIAN, QUANTUM_MEAN or QUANTUM_LATENCY
+/    int quantum
+/      The time quantum given for the run
+/    long long count, sum
+/      Number of ready processes and total of their remaining times
+/    QuantumNode *nodes, int num_nodes, capacity
+/      The treap's nodes (median only)
+/    int root, free_list
+/      Index of the root node and of the first unused node, or -1
+/    unsigned int seed
+/      State of the generator for node priorities
+/    Arena *arena
+/      Where the node array is allocated, or NULL for the heap
+/
+/  Relationships:
+/    - contains an array of QuantumNodes
+/    - used by simulate_round_robin and the streaming simulator
+/---------------------------------------------------------*/
+typedef struct {
+    int mode;
+    int quantum;
+    long long count;
+    long long sum;
+    QuantumNode *nodes;
+    int num_nodes;
+    int capacity;
+    int root;
+    int free_list;
+    unsigned int seed;
+    Arena *arena;
+} QuantumPolicy;
+
+void quantum_init(QuantumPolicy *policy, int mode, int quantum, Arena *arena);
+void quantum_release(QuantumPolicy *policy);
+void quantum_add(QuantumPolicy *policy, long long remaining);
+void quantum_remove(QuantumPolicy *policy, long long remaining);
+long long quantum_next(QuantumPolicy *policy);
+int quantum_mode(const char *name);
+const char *quantum_mode_name(int mode);
+
+#endif
@@ -0,0 +1,264 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   report.c
+/
+/  File Description:
+/    This file implements a streaming writer for machine-readable
+/    results, in JSON or CSV. The caller describes the report as
+/    sections of records of fields, and each field is written straight
+/    to the stream as it is given: the writer keeps only the counters
+/    it needs to place separators, and never allocates. Integers are
+/    formatted by hand rather than with fprintf, since a report of a
+/    long run is mostly integers.
+/
+/  Citations:
+/  - RFC 8259, The JavaScript Object Notation (JSON) Data Interchange Format
+/  - RFC 4180, Common Format and MIME Type for Comma-Separated Values (CSV) Files
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include "report.h"
+
+void report_field(ReportWriter *report, const char *name);
+void report_close_record(ReportWriter *report);
+void report_close_section(ReportWriter *report);
+void report_escaped(ReportWriter *report, const char *value);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: report_format -----------------------
+/  Function Description:
+/    Converts the name of a format, as given with --format, to the
+/    matching REPORT_* value.
+/
+/  Caller Input:
+/    const char *name: "json", "csv" or "text", in any case
+/
+/  Caller Output:
+/    The format, or -1 if the name is not recognized
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+int report_format(const char *name) {
+    if (strcasecmp(name, "json") == 0) return REPORT_JSON;
+    if (strcasecmp(name, "csv") == 0) return REPORT_CSV;
+    if (strcasecmp(name, "text") == 0) return REPORT_TEXT;
+    return -1;
+}
+
+/*---------- FUNCTION: report_json_escaped ----------------
+/  Function Description:
+/    Writes a string for the inside of a JSON string, escaping
+/    quotes, backslashes and control characters. Used by the reports
+/    and by the trace exporter, since process IDs are read from the
+/    input as they are.
+/
+/  Caller Input:
+/    FILE *fp: the stream to write to
+/    const char *value: the string
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - does not write the quotes around the string
+/---------------------------------------------------------*/
+void report_json_escaped(FILE *fp, const char *value) {
+    for (const char *c = value; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', fp);
+            fputc(*c, fp);
+        } else if ((unsigned char)*c < 0x20) {
+            fprintf(fp, "\\u%04x", (unsigned char)*c);
+        } else {
+            fputc(*c, fp);
+        }
+    }
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions write a report. A report is started with
+/    report_begin, is made up of sections started with report_section,
+/    each holding records started with report_record, each holding
+/    fields, and is finished with report_end. Records and sections are
+/    closed when the next one starts.
+/
+/  Functions and Their Purpose:
+/    - report_begin: Starts a report on fp.
+/    - report_section: Starts a section. In JSON it is a member named
+/      name, holding an array of records if list is 1 and a single
+/      record otherwise. In CSV it is a table headed by columns.
+/    - report_record: Starts a record (a JSON object, or a CSV row).
+/    - report_int, report_double, report_string: Write one field of
+/      the current record. Fields must be given in the order of the
+/      section's columns; in CSV their names are not written.
+/    - report_end: Closes the last section and the report.
+/
+/  Input Parameters:
+/    - ReportWriter *report: the writer
+/    - FILE *fp: the stream to write to
+/    - int format: REPORT_JSON or REPORT_CSV
+/    - const char *name: the name of the section or field
+/    - const char *columns: the section's field names, comma separated
+/    - int list: 1 if the section holds any number of records
+/    - long long value, double value, const char *value: the field's
+/      value (a NULL string, or a double that is not finite, is written
+/      as null in JSON and left empty in CSV)
+/
+/  Output:
+/    - N/A - output is written to the report's stream
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - doubles are written to 6 decimal places
+/------------------------------------------------------------------------*/
+void report_begin(ReportWriter *report, FILE *fp, int format) {
+    report->fp = fp;
+    report->format = format;
+    report->num_sections = 0;
+    report->list = 0;
+    report->num_records = 0;
+    report->num_fields = 0;
+    report->open_record = 0;
+
+    if (format == REPORT_JSON) fputc('{', fp);
+}
+
+void report_section(ReportWriter *report, const char *name, const char *columns, int list) {
+    if (report->num_sections > 0) {
+        report_close_section(report);
+        fputs(report->format == REPORT_JSON ? "," : "\n", report->fp);
+    }
+    report->num_sections++;
+    report->list = list;
+    report->num_records = 0;
+
+    if (report->format == REPORT_JSON) {
+        fprintf(report->fp, "\"%s\":", name);
+        if (list) fputc('[', report->fp);
+    } else {
+        fputs(columns, report->fp);
+        fputc('\n', report->fp);
+    }
+}
+
+void report_record(ReportWriter *report) {
+    report_close_record(report);
+    if (report->format == REPORT_JSON) {
+        if (report->num_records > 0) fputc(',', report->fp);
+        fputc('{', report->fp);
+    }
+    report->num_records++;
+    report->num_fields = 0;
+    report->open_record = 1;
+}
+
+void report_int(ReportWriter *report, const char *name, long long value) {
+    char digits[24];
+    int length = 0;
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+    report_field(report, name);
+    if (value < 0) fputc('-', report->fp);
+    do {
+        digits[sizeof(digits) - 1 - length++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    fwrite(digits + sizeof(digits) - length, 1, length, report->fp);
+}
+
+void report_double(ReportWriter *report, const char *name, double value) {
+    report_field(report, name);
+    if (!isfinite(value)) {
+        if (report->format == REPORT_JSON) fputs("null", report->fp);
+        return;
+    }
+    fprintf(report->fp, "%.6f", value);
+}
+
+void report_string(ReportWriter *report, const char *name, const char *value) {
+    report_field(report, name);
+    if (value == NULL) {
+        if (report->format == REPORT_JSON) fputs("null", report->fp);
+        return;
+    }
+    report_escaped(report, value);
+}
+
+void report_end(ReportWriter *report) {
+    if (report->num_sections > 0) report_close_section(report);
+    if (report->format == REPORT_JSON) fputs("}\n", report->fp);
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions place the punctuation between the parts of a
+/    report.
+/
+/  Functions and Their Purpose:
+/    - report_field: Writes the separator before a field and, in
+/      JSON, its name.
+/    - report_close_record: Ends the current record, if one is open.
+/    - report_close_section: Ends the current record and section.
+/    - report_escaped: Writes a string value, quoted and escaped as
+/      JSON requires, or quoted for CSV if it holds a comma, quote or
+/      line break.
+/
+/  Input Parameters:
+/    - ReportWriter *report: the writer
+/    - const char *name: the field's name
+/    - const char *value: the string to write
+/
+/  Output:
+/    - N/A - output is written to the report's stream
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+void report_field(ReportWriter *report, const char *name) {
+    if (report->num_fields++ > 0) fputc(',', report->fp);
+    if (report->format == REPORT_JSON) {
+        fputc('"', report->fp);
+        fputs(name, report->fp);
+        fputs("\":", report->fp);
+    }
+}
+
+void report_close_record(ReportWriter *report) {
+    if (!report->open_record) return;
+    fputc(report->format == REPORT_JSON ? '}' : '\n', report->fp);
+    report->open_record = 0;
+}
+
+void report_close_section(ReportWriter *report) {
+    report_close_record(report);
+    if (report->format == REPORT_JSON && report->list) fputc(']', report->fp);
+}
+
+void report_escaped(ReportWriter *report, const char *value) {
+    FILE *fp = report->fp;
+
+    if (report->format == REPORT_CSV) {
+        if (strpbrk(value, ",\"\r\n") == NULL) {
+            fputs(value, fp);
+            return;
+        }
+        fputc('"', fp);
+        for (const char *c = value; *c != '\0'; c++) {
+            if (*c == '"') fputc('"', fp);
+            fputc(*c, fp);
+        }
+        fputc('"', fp);
+        return;
+    }
+
+    fputc('"', fp);
+    report_json_escaped(fp, value);
+    fputc('"', fp);
+}
@@ -0,0 +1,70 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   report.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <stdio.h>
+
+#define REPORT_TEXT 0
+#define REPORT_JSON 1
+#define REPORT_CSV 2
+
+/*---------- STRUCTURE: ReportWriter -----------------------
+/  Structure Description:
+/    Streams a run's results as JSON or CSV. A report is a series of
+/    named sections, each a list of records or a single record, and
+/    every value is written as soon as it is given, so nothing is
+/    held in memory and nothing is allocated.
+/
+/    In JSON, a report is one object per line, with a member per
+/    section. In CSV, each section is a table with its own heading
+/    row, and sections are separated by a blank line.
+/
+/  Fields:
+/    FILE *fp
+/      The stream the report is written to
+/    int format
+/      REPORT_JSON or REPORT_CSV
+/    int num_sections
+/      Number of sections started so far (used for separators)
+/    int list
+/      1 if the current section is a list of records
+/    long long num_records
+/      Number of records started in the current section
+/    int num_fields
+/      Number of fields written in the current record
+/    int open_record
+/      1 if a record has been started and not yet closed
+/
+/  Relationships:
+/    - contained in SimContext
+/---------------------------------------------------------*/
+typedef struct {
+    FILE *fp;
+    int format;
+    int num_sections;
+    int list;
+    long long num_records;
+    int num_fields;
+    int open_record;
+} ReportWriter;
+
+int report_format(const char *name);
+void report_json_escaped(FILE *fp, const char *value);
+void report_begin(ReportWriter *report, FILE *fp, int format);
+void report_section(ReportWriter *report, const char *name, const char *columns, int list);
+void report_record(ReportWriter *report);
+void report_int(ReportWriter *report, const char *name, long long value);
+void report_double(ReportWriter *report, const char *name, double value);
+void report_string(ReportWriter *report, const char *name, const char *value);
+void report_end(ReportWriter *report);
+
+#endif
@@ -1,11 +1,13 @@
 /*---------- ID HEADER -------------------------------------
 /  Author(s):   Andrew Boisvert, Kyle Scidmore
 /  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca 
-/  File Name:   options.h
+/  File Name:   scheduling.c
 /
-/  Program Purpose(s):
-/    This header file describes the public interface of the accompanying
-/    ".c" file, describing how this module may be used by others. 
+/  File Description:
+/    This file implements the scheduling algorithms. Each simulator 
+/    runs the workload held in a SimContext, records the results in 
+/    it, and writes its event table, metrics and Gantt chart to the 
+/    context's output sink. 
 /
 /  Citations:
 /  - Using qsort: https://www.tutorialspoint.com/c_standard_library/c_function_qsort.htm
@@ -19,10 +21,20 @@
 #include "globals.h"
 #include "circular_queue.h"
 #include "ansi_esc_seqs.h"
-#include "options.h"
+#include "simulator.h"
 #include "display.h"
 #include "compare.h"
-
+#include "trace.h"
+#include "timeline.h"
+#include "histogram.h"
+#include "series.h"
+#include "stats.h"
+#include "report.h"
+
+void begin_simulation(SimContext *ctx, const char *title);
+void log_event(SimContext *ctx, long long current_time, const char *event, const char *id, CircularQueue *queue);
+void end_simulation(SimContext *ctx, Timeline *timeline, long long current_time, long long idle_time);
+void count_switch(Process processes[], int num_processes, const char *from, const char *to, int time_slice);
 
 /*---------- FUNCTION: simulate_FCFS -----------------------------------
 /  Function Description:
@@ -33,55 +45,64 @@
 /    and overall metrics upon completion.
 /  
 /  Caller Input:
-/    - Process processes[]: Array of processes to be scheduled.
-/    - int num_processes: Number of processes in the array.
+/    - SimContext *ctx: The run's workload, settings and output sink.
 /  
 /  Caller Output:
-/    N/A - No return value. Results are displayed directly in the console 
-/          or written to the file if provided.
+/    N/A - No return value. Results are stored in ctx->result and the 
+/          processes array, and written to ctx->out if it is set.
 /  
 /  Assumptions, Limitations, Known Bugs:
 /    - 
 /
 -------------------------------------------------------------------------*/
-void simulate_FCFS(Process processes[], int num_processes, Options *options) {
+void simulate_FCFS(SimContext *ctx) {
+
+    Process *processes = ctx->processes;
+    int num_processes = ctx->num_processes;
 
     CircularQueue ready_queue;
-    init_queue(&ready_queue);
+    Process *queue_data = arena_alloc(sim_arena(ctx), num_processes * sizeof(Process));
+    if (queue_data == NULL) return;
+    init_queue(&ready_queue, queue_data, num_processes);
+
+    TraceWriter trace;
+    trace_open(&trace, ctx->trace_file, ctx->algorithm);
+
+    Timeline timeline;
+    init_timeline(&timeline, sim_arena(ctx));
 
-    int current_time = 0;
-    int idle_time = 0;
-    int start_time;
+    long long current_time = 0;
+    long long idle_time = 0;
+    long long start_time;
 
     qsort(processes, num_processes, sizeof(Process), compare_arrival);
 
-    fprintf(stdout, "~~~~~~~~~~\n\n");
-    fprintf(stdout, "\nRunning Simulation for FCFS (First Come First Served)\n\n");
-    fprintf(stdout, "+---------+---------------------+---------------------------\n");
-    fprintf(stdout, "| %-8s| %-20s| %-40s", "Time", "Event", "Ready Queue");
-    fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+    begin_simulation(ctx, "FCFS (First Come First Served)");
 
     int i = 0; 
     while (i < num_processes || !isEmpty(&ready_queue)) {
+        STAT_INC(steps);
        
         /*Check if processes have arrived, stops when it finds a process that hasnt*/
         while (i < num_processes && processes[i].arrival_time <= current_time) {
             enqueue(&ready_queue, processes[i]);
+            trace_arrival(&trace, &processes[i], i + 1);
             i++;
         }
 
         /*If queue is empty track idle state */
         if (isEmpty(&ready_queue)) {
 
-            fprintf(stdout, "| %-8d| %-20s| ", current_time, "Idle");
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Idle", NULL, &ready_queue);
             while(isEmpty(&ready_queue)){
-                current_time++;
-                idle_time++;
+                /* jump to the next arrival instead of ticking through the gap */
+                STAT_ADD(idle_skipped, processes[i].arrival_time - current_time);
+                idle_time += processes[i].arrival_time - current_time;
+                current_time = processes[i].arrival_time;
 
                 while (i < num_processes && processes[i].arrival_time <= current_time) {
                     enqueue(&ready_queue, processes[i]);
+                    trace_arrival(&trace, &processes[i], i + 1);
                     i++;
                 }
 
@@ -91,46 +112,37 @@ void simulate_FCFS(Process processes[], int num_processes, Options *options) {
             Process current_process = ready_queue.data[ready_queue.front];
 
             start_time = current_time;
-            fprintf(stdout, "| %-8d| Started P%-11s| ", current_time, current_process.id);
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Started", current_process.id, &ready_queue);
             dequeue(&ready_queue);
             /*Update current time and current processes metrics*/
             current_time += current_process.burst_time;
 
+            STAT_INC(id_lookups);
             for(int j = 0; j < num_processes; j++){
 
+                STAT_INC(id_compares);
                 if(strcmp(processes[j].id, current_process.id) == 0){
                     processes[j].completion_time = current_time;
                     processes[j].turnaround_time = current_time - processes[j].arrival_time;
                     processes[j].waiting_time = processes[j].turnaround_time - processes[j].burst_time;
                     processes[j].response_time = start_time - processes[j].arrival_time;
                     processes[j].start_time = start_time;
+                    timeline_run(&timeline, processes[j].index, start_time, current_time);
+                    trace_run(&trace, &processes[j], j + 1, start_time);
+                    trace_stop(&trace, current_time);
+                    processes[j].dispatches++;
+                    record_latency(&ctx->result.latency, &processes[j]);
                     break;
                 }
             }
 
-            fprintf(stdout, "| %-8d| Completed P%-9s| ", current_time, current_process.id);
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Completed", current_process.id, &ready_queue);
 
         }
     }
 
-    fprintf(stdout, "\nSimulation complete.");
-    fprintf(stdout, "\n\n~~~~~~~~~~\n\n");
-
-    qsort(processes, num_processes, sizeof(Process), compare_arrival);
-
-    // display_metrics(processes, num_processes, idle_time, current_time);
-    display_metrics_table(processes, num_processes, idle_time, current_time);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
-
-    //if stdout is going to tty, print asci colours, else don't
-    isatty(fileno(stdout)) ?
-    display_chart(processes, num_processes) :
-    display_chart_file(processes, num_processes);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
+    trace_close(&trace, current_time);
+    end_simulation(ctx, &timeline, current_time, idle_time);
 
 }
 
@@ -143,54 +155,63 @@ void simulate_FCFS(Process processes[], int num_processes, Options *options) {
 /    and overall metrics upon completion.
 /  
 /  Caller Input:
-/    - Process processes[]: Array of processes to be scheduled.
-/    - int num_processes: Number of processes in the array.
+/    - SimContext *ctx: The run's workload, settings and output sink.
 /  
 /  Caller Output:
-/    N/A - No return value. Results are displayed directly in the console 
-/          or written to the file if provided.
+/    N/A - No return value. Results are stored in ctx->result and the 
+/          processes array, and written to ctx->out if it is set.
 /  
 /  Assumptions, Limitations, Known Bugs:
 /    - 
 /
 -------------------------------------------------------------------------*/
-void simulate_SJF(Process processes[], int num_processes, Options *options) {
+void simulate_SJF(SimContext *ctx) {
+
+    Process *processes = ctx->processes;
+    int num_processes = ctx->num_processes;
 
 
     CircularQueue ready_queue;
-    init_queue(&ready_queue);
+    Process *queue_data = arena_alloc(sim_arena(ctx), num_processes * sizeof(Process));
+    if (queue_data == NULL) return;
+    init_queue(&ready_queue, queue_data, num_processes);
+
+    TraceWriter trace;
+    trace_open(&trace, ctx->trace_file, ctx->algorithm);
+
+    Timeline timeline;
+    init_timeline(&timeline, sim_arena(ctx));
 
-    int current_time = 0;
-    int idle_time = 0;
-    int start_time;
+    long long current_time = 0;
+    long long idle_time = 0;
+    long long start_time;
 
     qsort(processes, num_processes, sizeof(Process), compare_arrival);
 
-    fprintf(stdout, "~~~~~~~~~~\n\n");
-    fprintf(stdout, "\nRunning Simulation for SJF (Shortest Job First)\n\n");
-    fprintf(stdout, "+---------+---------------------+---------------------------\n");
-    fprintf(stdout, "| %-8s| %-20s| %-40s", "Time", "Event", "Ready Queue");
-    fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+    begin_simulation(ctx, "SJF (Shortest Job First)");
 
     int i = 0;
     while (i < num_processes || !isEmpty(&ready_queue)) {
+        STAT_INC(steps);
 
         while (i < num_processes && processes[i].arrival_time <= current_time) {
             enqueue(&ready_queue, processes[i]);
+            trace_arrival(&trace, &processes[i], i + 1);
             i++;
         }
 
         if (isEmpty(&ready_queue)) {
 
-            fprintf(stdout, "| %-8d| %-20s| ", current_time, "Idle");
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Idle", NULL, &ready_queue);
             while(isEmpty(&ready_queue)){
-                current_time++;
-                idle_time++;
+                /* jump to the next arrival instead of ticking through the gap */
+                STAT_ADD(idle_skipped, processes[i].arrival_time - current_time);
+                idle_time += processes[i].arrival_time - current_time;
+                current_time = processes[i].arrival_time;
 
                 while (i < num_processes && processes[i].arrival_time <= current_time) {
                     enqueue(&ready_queue, processes[i]);
+                    trace_arrival(&trace, &processes[i], i + 1);
                     i++;
                 }
 
@@ -202,45 +223,36 @@ void simulate_SJF(Process processes[], int num_processes, Options *options) {
             Process current_process = ready_queue.data[ready_queue.front];
 
             start_time = current_time;
-            fprintf(stdout, "| %-8d| Started P%-11s| ", current_time, current_process.id);
-            display_queue(&ready_queue);
-            
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Started", current_process.id, &ready_queue);
             
             dequeue(&ready_queue);
             current_time += current_process.burst_time;
 
+            STAT_INC(id_lookups);
             for (int j = 0; j < num_processes; j++) {
+                STAT_INC(id_compares);
                 if (strcmp(processes[j].id, current_process.id) == 0) {
                     processes[j].completion_time = current_time;
                     processes[j].turnaround_time = current_time - processes[j].arrival_time;
                     processes[j].waiting_time = processes[j].turnaround_time - processes[j].burst_time;
                     processes[j].response_time = start_time - processes[j].arrival_time;
                     processes[j].start_time = start_time;
+                    timeline_run(&timeline, processes[j].index, start_time, current_time);
+                    trace_run(&trace, &processes[j], j + 1, start_time);
+                    trace_stop(&trace, current_time);
+                    processes[j].dispatches++;
+                    record_latency(&ctx->result.latency, &processes[j]);
                     break;
                 }
             }
 
 
-            fprintf(stdout, "| %-8d| Completed P%-9s| ", current_time, current_process.id);
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Completed", current_process.id, &ready_queue);
         }
     }
 
-    fprintf(stdout, "\nSimulation complete.");
-    fprintf(stdout, "\n\n~~~~~~~~~~\n\n");
-
-    qsort(processes, num_processes, sizeof(Process), compare_arrival);
-
-    display_metrics_table(processes, num_processes, idle_time, current_time);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
-
-    //if stdout is going to tty, print asci colours, else don't
-    isatty(fileno(stdout)) ?
-    display_chart(processes, num_processes) :
-    display_chart_file(processes, num_processes);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
+    trace_close(&trace, current_time);
+    end_simulation(ctx, &timeline, current_time, idle_time);
 
 }
 
@@ -253,53 +265,62 @@ void simulate_SJF(Process processes[], int num_processes, Options *options) {
 /    upon completion.
 /  
 /  Caller Input:
-/    - Process processes[]: Array of processes to be scheduled.
-/    - int num_processes: Number of processes in the array.
+/    - SimContext *ctx: The run's workload, settings and output sink.
 /  
 /  Caller Output:
-/    N/A - No return value. Results are displayed directly in the console 
-/          or written to the file if provided.
+/    N/A - No return value. Results are stored in ctx->result and the 
+/          processes array, and written to ctx->out if it is set.
 /  
 /  Assumptions, Limitations, Known Bugs:
 /    - 
 /
 ------------------------------------------------------------------------*/
-void simulate_priority(Process processes[], int num_processes, Options *options) {
+void simulate_priority(SimContext *ctx) {
+
+    Process *processes = ctx->processes;
+    int num_processes = ctx->num_processes;
 
     CircularQueue ready_queue;
-    init_queue(&ready_queue);
+    Process *queue_data = arena_alloc(sim_arena(ctx), num_processes * sizeof(Process));
+    if (queue_data == NULL) return;
+    init_queue(&ready_queue, queue_data, num_processes);
+
+    TraceWriter trace;
+    trace_open(&trace, ctx->trace_file, ctx->algorithm);
 
-    int current_time = 0;
-    int idle_time = 0;
-    int start_time;
+    Timeline timeline;
+    init_timeline(&timeline, sim_arena(ctx));
+
+    long long current_time = 0;
+    long long idle_time = 0;
+    long long start_time;
 
     qsort(processes, num_processes, sizeof(Process), compare_arrival);
 
-    fprintf(stdout, "~~~~~~~~~~\n\n");
-    fprintf(stdout, "\nRunning Simulation for Priority Scheduling\n\n");
-    fprintf(stdout, "+---------+---------------------+---------------------------\n");
-    fprintf(stdout, "| %-8s| %-20s| %-40s", "Time", "Event", "Ready Queue");
-    fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+    begin_simulation(ctx, "Priority Scheduling");
 
     int i = 0;
     while (i < num_processes || !isEmpty(&ready_queue)) {
+        STAT_INC(steps);
 
         while (i < num_processes && processes[i].arrival_time <= current_time) {
             enqueue(&ready_queue, processes[i]);
+            trace_arrival(&trace, &processes[i], i + 1);
             i++;
         }
 
         if (isEmpty(&ready_queue)) {
 
-            fprintf(stdout, "| %-8d| %-20s| ", current_time, "Idle");
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Idle", NULL, &ready_queue);
             while(isEmpty(&ready_queue)){
-                current_time++;
-                idle_time++;
+                /* jump to the next arrival instead of ticking through the gap */
+                STAT_ADD(idle_skipped, processes[i].arrival_time - current_time);
+                idle_time += processes[i].arrival_time - current_time;
+                current_time = processes[i].arrival_time;
 
                 while (i < num_processes && processes[i].arrival_time <= current_time) {
                     enqueue(&ready_queue, processes[i]);
+                    trace_arrival(&trace, &processes[i], i + 1);
                     i++;
                 }
 
@@ -311,43 +332,34 @@ void simulate_priority(Process processes[], int num_processes, Options *options)
             Process current_process = ready_queue.data[ready_queue.front];
 
             start_time = current_time;
-            fprintf(stdout, "| %-8d| Started P%-11s| ", current_time, current_process.id);
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Started", current_process.id, &ready_queue);
             dequeue(&ready_queue);
             current_time += current_process.burst_time;
 
+            STAT_INC(id_lookups);
             for (int j = 0; j < num_processes; j++) {
+                STAT_INC(id_compares);
                 if (strcmp(processes[j].id, current_process.id) == 0) {
                     processes[j].completion_time = current_time;
                     processes[j].turnaround_time = current_time - processes[j].arrival_time;
                     processes[j].waiting_time = processes[j].turnaround_time - processes[j].burst_time;
                     processes[j].response_time = start_time - processes[j].arrival_time;
                     processes[j].start_time = start_time;
+                    timeline_run(&timeline, processes[j].index, start_time, current_time);
+                    trace_run(&trace, &processes[j], j + 1, start_time);
+                    trace_stop(&trace, current_time);
+                    processes[j].dispatches++;
+                    record_latency(&ctx->result.latency, &processes[j]);
                     break;
                 }
             }
 
-            fprintf(stdout, "| %-8d| Completed P%-9s| ", current_time, current_process.id);
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Completed", current_process.id, &ready_queue);
         }
     }
 
-    fprintf(stdout, "\nSimulation complete.");
-    fprintf(stdout, "\n\n~~~~~~~~~~\n\n");
-
-    qsort(processes, num_processes, sizeof(Process), compare_arrival);
-    
-    // display_metrics(processes, num_processes, idle_time, current_time);
-    display_metrics_table(processes, num_processes, idle_time, current_time);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
-
-    //if stdout is going to tty, print asci colours, else don't
-    isatty(fileno(stdout)) ?
-    display_chart(processes, num_processes) :
-    display_chart_file(processes, num_processes);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
+    trace_close(&trace, current_time);
+    end_simulation(ctx, &timeline, current_time, idle_time);
 
 }
 
@@ -358,61 +370,71 @@ void simulate_priority(Process processes[], int num_processes, Options *options)
 /    waiting times, response times, and completion times. It outputs 
 /    detailed logs to the console or an optional file stream, 
 /    displaying scheduling events and overall metrics upon completion.
+/    The ready queue is only sorted at arrivals and completions: in 
+/    between, the running process only gets shorter, so it stays at 
+/    the front.
 /  
 /  Caller Input:
-/    - Process processes[]: Array of processes to be scheduled.
-/    - int num_processes: Number of processes in the array.
+/    - SimContext *ctx: The run's workload, settings and output sink.
 /  
 /  Caller Output:
-/    N/A - No return value. Results are displayed directly in the console 
-/          or written to the file if provided.
+/    N/A - No return value. Results are stored in ctx->result and the 
+/          processes array, and written to ctx->out if it is set.
 /  
 /  Assumptions, Limitations, Known Bugs:
 /    - 
 /
 -------------------------------------------------------------------------*/
-void simulate_SRTF(Process processes[], int num_processes) {
+void simulate_SRTF(SimContext *ctx) {
+
+    Process *processes = ctx->processes;
+    int num_processes = ctx->num_processes;
 
     CircularQueue ready_queue;
-    init_queue(&ready_queue);
+    Process *queue_data = arena_alloc(sim_arena(ctx), num_processes * sizeof(Process));
+    if (queue_data == NULL) return;
+    init_queue(&ready_queue, queue_data, num_processes);
 
-    int current_time = 0;
-    int idle_time = 0;
+    TraceWriter trace;
+    trace_open(&trace, ctx->trace_file, ctx->algorithm);
+
+    Timeline timeline;
+    init_timeline(&timeline, sim_arena(ctx));
+
+    long long current_time = 0;
+    long long idle_time = 0;
     char last_process_id[10] = "";
-    int idled = 0;
 
     
     qsort(processes, num_processes, sizeof(Process), compare_arrival);
 
-    fprintf(stdout, "~~~~~~~~~~\n\n");
-    fprintf(stdout, "\nRunning Simulation for SRTF (Shortest Remaining Time First)\n\n");
-    fprintf(stdout, "+---------+---------------------+---------------------------\n");
-    fprintf(stdout, "| %-8s| %-20s| %-40s", "Time", "Event", "Ready Queue");
-    fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+    begin_simulation(ctx, "SRTF (Shortest Remaining Time First)");
 
     int i = 0;
     while (i < num_processes || !isEmpty(&ready_queue)) {
+        STAT_INC(steps);
         
         while (i < num_processes && processes[i].arrival_time <= current_time) {
             enqueue(&ready_queue, processes[i]);
+            trace_arrival(&trace, &processes[i], i + 1);
             i++;
         }
 
         if (isEmpty(&ready_queue)) {
-            fprintf(stdout, "| %-8d| %-20s| ", current_time, "Idle");
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Idle", NULL, &ready_queue);
             while(isEmpty(&ready_queue)){
-                current_time++;
-                idle_time++;
+                /* jump to the next arrival instead of ticking through the gap */
+                STAT_ADD(idle_skipped, processes[i].arrival_time - current_time);
+                idle_time += processes[i].arrival_time - current_time;
+                current_time = processes[i].arrival_time;
 
                 while (i < num_processes && processes[i].arrival_time <= current_time) {
                     enqueue(&ready_queue, processes[i]);
+                    trace_arrival(&trace, &processes[i], i + 1);
                     i++;
                 }
 
             }
-            idled = 1;
         } else {
             
             sort_queue(&ready_queue, compare_remaining);
@@ -420,22 +442,9 @@ void simulate_SRTF(Process processes[], int num_processes) {
             Process *current_process = &ready_queue.data[ready_queue.front];
 
             if (strcmp(last_process_id, current_process->id) != 0) {
-                fprintf(stdout, "| %-8d| Started P%-11s| ", current_time, current_process->id);
-                display_queue(&ready_queue);
-                fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
-
-                if(!idled){
-
-                    for (int j = 0; j < num_processes; j++) {
-
-                        if (strcmp(processes[j].id, last_process_id) == 0) {
-                            processes[j].running_time[current_time] = 1;
-                            break;
-                        }
-                    }
-
-                }
+                log_event(ctx, current_time, "Started", current_process->id, &ready_queue);
 
+                count_switch(processes, num_processes, last_process_id, current_process->id, 0);
                 strcpy(last_process_id, current_process->id);
                 
                 if (current_process->remaining_time == current_process->burst_time) {
@@ -443,55 +452,53 @@ void simulate_SRTF(Process processes[], int num_processes) {
                 }
             }
 
+            /* run it to completion or to the next arrival, the only events that can preempt it */
+            long long run_until = current_time + current_process->remaining_time;
+            if (i < num_processes && processes[i].arrival_time < run_until) {
+                run_until = processes[i].arrival_time;
+            }
+
+            STAT_INC(id_lookups);
             for (int j = 0; j < num_processes; j++) {
 
+                STAT_INC(id_compares);
                 if (strcmp(processes[j].id, current_process->id) == 0) {
-                    processes[j].running_time[current_time] = 1;
+                    trace_run(&trace, &processes[j], j + 1, current_time);
+                    timeline_run(&timeline, processes[j].index, current_time, run_until);
                     break;
                 }
             }
-            current_process->remaining_time--;
-            current_time++;
+            current_process->remaining_time -= run_until - current_time;
+            current_time = run_until;
 
             
             if (current_process->remaining_time == 0) {
                 dequeue(&ready_queue);
-                fprintf(stdout, "| %-8d| Completed P%-9s| ", current_time, current_process->id);
-                display_queue(&ready_queue);
-                fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+                log_event(ctx, current_time, "Completed", current_process->id, &ready_queue);
 
                 
+                STAT_INC(id_lookups);
                 for (int j = 0; j < num_processes; j++) {
+                    STAT_INC(id_compares);
                     if (strcmp(processes[j].id, current_process->id) == 0) {
                         processes[j].completion_time = current_time;
                         processes[j].turnaround_time = current_time - processes[j].arrival_time;
                         processes[j].waiting_time = processes[j].turnaround_time - processes[j].burst_time;
                         processes[j].response_time = current_process->start_time - processes[j].arrival_time;
-                        processes[j].running_time[current_time] = 1;
+                        processes[j].start_time = current_process->start_time;
+                        trace_stop(&trace, current_time);
+                        record_latency(&ctx->result.latency, &processes[j]);
                         break;
                     }
                 }
+                last_process_id[0] = '\0';
             }
 
-            idled = 0;
-
         }
     }
 
-    fprintf(stdout, "\nSimulation complete.");
-    fprintf(stdout, "\n\n~~~~~~~~~~\n\n");
-
-    qsort(processes, num_processes, sizeof(Process), compare_arrival);
-
-    // display_metrics(processes, num_processes, idle_time, current_time);
-    display_metrics_table(processes, num_processes, idle_time, current_time);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
-
-    //if stdout is going to tty, print asci colours, else don't
-    isatty(fileno(stdout)) ?
-    display_preemptive_chart(processes, num_processes) :
-    display_preemptive_chart_file(processes, num_processes);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
+    trace_close(&trace, current_time);
+    end_simulation(ctx, &timeline, current_time, idle_time);
 }
 
 
@@ -501,63 +508,71 @@ void simulate_SRTF(Process processes[], int num_processes) {
 /    The function tracks process execution, waiting times, response times,
 /    and completion times. It outputs detailed logs to the console or an
 /    optional file stream, displaying scheduling events and overall metrics upon 
-/    completion.
+/    completion. As with SRTF, the ready queue is only sorted at arrivals and 
+/    completions, since priorities do not change while a process runs.
 /  
 /  Caller Input:
-/    - Process processes[]: Array of processes to be scheduled.
-/    - int num_processes: Number of processes in the array.
+/    - SimContext *ctx: The run's workload, settings and output sink.
 /  
 /  Caller Output:
-/    N/A - No return value. Results are displayed directly in the console 
-/          or written to the file if provided.
+/    N/A - No return value. Results are stored in ctx->result and the 
+/          processes array, and written to ctx->out if it is set.
 /  
 /  Assumptions, Limitations, Known Bugs:
 /    - 
 /
 ---------------------------------------------------------------------------------*/
-void simulate_preemptive_priority(Process processes[], int num_processes) {
+void simulate_preemptive_priority(SimContext *ctx) {
+
+    Process *processes = ctx->processes;
+    int num_processes = ctx->num_processes;
 
     CircularQueue ready_queue;
-    init_queue(&ready_queue);
+    Process *queue_data = arena_alloc(sim_arena(ctx), num_processes * sizeof(Process));
+    if (queue_data == NULL) return;
+    init_queue(&ready_queue, queue_data, num_processes);
 
-    int current_time = 0;
-    int idle_time = 0;
-    int start_time;
+    TraceWriter trace;
+    trace_open(&trace, ctx->trace_file, ctx->algorithm);
+
+    Timeline timeline;
+    init_timeline(&timeline, sim_arena(ctx));
+
+    long long current_time = 0;
+    long long idle_time = 0;
+    long long start_time;
     char last_process_id[10] = "";
-    int idled = 0;
     int first_run = 1;
 
     qsort(processes, num_processes, sizeof(Process), compare_arrival);
 
-    fprintf(stdout, "~~~~~~~~~~\n\n");
-    fprintf(stdout, "\nRunning Simulation for PP (Preemptive Priority)\n\n");
-    fprintf(stdout, "+---------+---------------------+---------------------------\n");
-    fprintf(stdout, "| %-8s| %-20s| %-40s", "Time", "Event", "Ready Queue");
-    fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+    begin_simulation(ctx, "PP (Preemptive Priority)");
 
     int i = 0;
     while (i < num_processes || !isEmpty(&ready_queue)) {
+        STAT_INC(steps);
     
         while (i < num_processes && processes[i].arrival_time <= current_time) {
             enqueue(&ready_queue, processes[i]);
+            trace_arrival(&trace, &processes[i], i + 1);
             i++;
         }
 
         if (isEmpty(&ready_queue)) {
-            fprintf(stdout, "| %-8d| %-20s| ", current_time, "Idle");
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Idle", NULL, &ready_queue);
             while(isEmpty(&ready_queue)){
-                current_time++;
-                idle_time++;
+                /* jump to the next arrival instead of ticking through the gap */
+                STAT_ADD(idle_skipped, processes[i].arrival_time - current_time);
+                idle_time += processes[i].arrival_time - current_time;
+                current_time = processes[i].arrival_time;
 
                 while (i < num_processes && processes[i].arrival_time <= current_time) {
                     enqueue(&ready_queue, processes[i]);
+                    trace_arrival(&trace, &processes[i], i + 1);
                     i++;
                 }
 
             }
-            idled = 1;
         } else {
             
             sort_queue(&ready_queue, compare_priority);
@@ -567,22 +582,9 @@ void simulate_preemptive_priority(Process processes[], int num_processes) {
 
             if (strcmp(last_process_id, current_process->id) != 0) {
                 
-                fprintf(stdout, "| %-8d| Started P%-11s| ", current_time, current_process->id);
-                display_queue(&ready_queue);
-                fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
-
-                if(!idled){
-
-                    for (int j = 0; j < num_processes; j++) {
-
-                        if (strcmp(processes[j].id, last_process_id) == 0) {
-                            processes[j].running_time[current_time] = 1;
-                            break;
-                        }
-                    }
-
-                }
+                log_event(ctx, current_time, "Started", current_process->id, &ready_queue);
 
+                count_switch(processes, num_processes, last_process_id, current_process->id, 0);
                 strcpy(last_process_id, current_process->id);
                 
                 if (current_process->remaining_time == current_process->burst_time) {
@@ -590,57 +592,55 @@ void simulate_preemptive_priority(Process processes[], int num_processes) {
                 }
             }
 
+            /* run it to completion or to the next arrival, the only events that can preempt it */
+            long long run_until = current_time + current_process->remaining_time;
+            if (i < num_processes && processes[i].arrival_time < run_until) {
+                run_until = processes[i].arrival_time;
+            }
+
+            STAT_INC(id_lookups);
             for (int j = 0; j < num_processes; j++) {
 
+                STAT_INC(id_compares);
                 if (strcmp(processes[j].id, current_process->id) == 0) {
-                    processes[j].running_time[current_time] = 1;
+                    trace_run(&trace, &processes[j], j + 1, current_time);
+                    timeline_run(&timeline, processes[j].index, current_time, run_until);
                     break;
                 }
             }
-            current_process->remaining_time--;
-            current_time++;
+            current_process->remaining_time -= run_until - current_time;
+            current_time = run_until;
 
             
             if (current_process->remaining_time == 0) {
                 dequeue(&ready_queue);
-                fprintf(stdout, "| %-8d| Completed P%-9s| ", current_time, current_process->id);
-                display_queue(&ready_queue);
-                fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+                log_event(ctx, current_time, "Completed", current_process->id, &ready_queue);
 
                 
+                STAT_INC(id_lookups);
                 for (int j = 0; j < num_processes; j++) {
+                    STAT_INC(id_compares);
                     if (strcmp(processes[j].id, current_process->id) == 0) {
                         processes[j].completion_time = current_time;
                         processes[j].turnaround_time = current_time - processes[j].arrival_time;
                         processes[j].waiting_time = processes[j].turnaround_time - processes[j].burst_time;
                         processes[j].response_time = current_process->start_time - processes[j].arrival_time;
-                        processes[j].running_time[current_time] = 1;
+                        processes[j].start_time = current_process->start_time;
+                        trace_stop(&trace, current_time);
+                        record_latency(&ctx->result.latency, &processes[j]);
                         break;
                     }
                 }
+                last_process_id[0] = '\0';
             }
 
-            idled = 0;
-
             Process *last_process = &ready_queue.data[ready_queue.front];
 
         }
     }
 
-    fprintf(stdout, "\nSimulation complete.");
-    fprintf(stdout, "\n\n~~~~~~~~~~\n\n");
-
-    qsort(processes, num_processes, sizeof(Process), compare_arrival);
-
-    // display_metrics(processes, num_processes, idle_time, current_time);
-    display_metrics_table(processes, num_processes, idle_time, current_time);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
-
-    //if stdout is going to tty, print asci colours, else don't
-    isatty(fileno(stdout)) ?
-    display_preemptive_chart(processes, num_processes) :
-    display_preemptive_chart_file(processes, num_processes);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
+    trace_close(&trace, current_time);
+    end_simulation(ctx, &timeline, current_time, idle_time);
 }
 
 /*---------- FUNCTION: simulate_round_robin ----------------------------
@@ -652,56 +652,76 @@ void simulate_preemptive_priority(Process processes[], int num_processes) {
 /    upon completion.
 /  
 /  Caller Input:
-/    - Process processes[]: Array of processes to be scheduled.
-/    - int num_processes: Number of processes in the array.
-/    - int time_quantum: Time slice for Round Robin scheduling.
+/    - SimContext *ctx: The run's workload, settings and output sink. 
+/      Its time_quantum is the time slice for Round Robin scheduling,
+/      or with an adaptive quantum_mode what each slice is set from.
 /  
 /  Caller Output:
-/    N/A - No return value. Results are displayed directly in the console 
-/          or written to the file if provided.
+/    N/A - No return value. Results are stored in ctx->result and the 
+/          processes array, and written to ctx->out if it is set.
 /  
 /  Assumptions, Limitations, Known Bugs:
 /    - 
 /
 ------------------------------------------------------------------------*/
-void simulate_round_robin(Process processes[], int num_processes, int time_quantum) {
+void simulate_round_robin(SimContext *ctx) {
+
+    Process *processes = ctx->processes;
+    int num_processes = ctx->num_processes;
+    int time_quantum = ctx->time_quantum;
 
     CircularQueue ready_queue;
-    init_queue(&ready_queue);
+    Process *queue_data = arena_alloc(sim_arena(ctx), num_processes * sizeof(Process));
+    if (queue_data == NULL) return;
+    init_queue(&ready_queue, queue_data, num_processes);
+
+    QuantumPolicy quantum;
+    quantum_init(&quantum, ctx->quantum_mode, time_quantum, sim_arena(ctx));
+    char title[48] = "RR (Round Robin)";
+    if (ctx->quantum_mode != QUANTUM_FIXED) {
+        snprintf(title, sizeof(title), "RR (Round Robin, %s quantum)", quantum_mode_name(ctx->quantum_mode));
+    }
 
-    int current_time = 0;
-    int idle_time = 0;
+    TraceWriter trace;
+    trace_open(&trace, ctx->trace_file, ctx->algorithm);
+
+    Timeline timeline;
+    init_timeline(&timeline, sim_arena(ctx));
+
+    long long current_time = 0;
+    long long idle_time = 0;
     int i = 0;
     int idling = 0;
     char last_process_id[10] = "";
 
     qsort(processes, num_processes, sizeof(Process), compare_arrival); 
 
-    fprintf(stdout, "~~~~~~~~~~\n\n");
-    fprintf(stdout, "\nRunning Simulation for RR (Round Robin)\n\n");
-    fprintf(stdout, "+---------+---------------------+---------------------------\n");
-    fprintf(stdout, "| %-8s| %-20s| %-40s", "Time", "Event", "Ready Queue");
-    fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+    begin_simulation(ctx, title);
 
     while (i < num_processes || !isEmpty(&ready_queue)) {
+        STAT_INC(steps);
 
         
         while (i < num_processes && processes[i].arrival_time <= current_time) {
             enqueue(&ready_queue, processes[i]);
+            quantum_add(&quantum, processes[i].remaining_time);
+            trace_arrival(&trace, &processes[i], i + 1);
             i++;
         }
 
         if (isEmpty(&ready_queue)) {  
 
-            fprintf(stdout, "| %-8d| %-20s| ", current_time, "Idle");
-            display_queue(&ready_queue);
-            fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+            log_event(ctx, current_time, "Idle", NULL, &ready_queue);
             while(isEmpty(&ready_queue)){
-                current_time++;
-                idle_time++;
+                /* jump to the next arrival instead of ticking through the gap */
+                STAT_ADD(idle_skipped, processes[i].arrival_time - current_time);
+                idle_time += processes[i].arrival_time - current_time;
+                current_time = processes[i].arrival_time;
 
                 while (i < num_processes && processes[i].arrival_time <= current_time) {
                     enqueue(&ready_queue, processes[i]);
+                    quantum_add(&quantum, processes[i].remaining_time);
+                    trace_arrival(&trace, &processes[i], i + 1);
                     i++;
                 }
 
@@ -713,7 +733,9 @@ void simulate_round_robin(Process processes[], int num_processes, int time_quant
             Process current_process = ready_queue.data[ready_queue.front];
 
             
+            STAT_INC(id_lookups);
             for (int j = 0; j < num_processes; j++) {
+                STAT_INC(id_compares);
                 if (strcmp(processes[j].id, current_process.id) == 0 && !processes[j].has_started) {
                     processes[j].response_time = current_time - processes[j].arrival_time;
                     processes[j].start_time = current_time;
@@ -722,32 +744,31 @@ void simulate_round_robin(Process processes[], int num_processes, int time_quant
                 }
             }
    
-            int exec_time = (current_process.remaining_time > time_quantum) ? time_quantum : current_process.remaining_time;
+            long long slice = quantum_next(&quantum);
+            long long exec_time = (current_process.remaining_time > slice) ? slice : current_process.remaining_time;
 
 
             if(strcmp(current_process.id, last_process_id) != 0){
 
-                fprintf(stdout, "| %-8d| Started P%-11s| ", current_time, current_process.id);
-                display_queue(&ready_queue);
-                fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+                /* the process that had the CPU was sent back by its time slice */
+                if (last_process_id[0] != '\0') trace_expire(&trace, current_time);
+                log_event(ctx, current_time, "Started", current_process.id, &ready_queue);
+                count_switch(processes, num_processes, last_process_id, current_process.id, 1);
                 strcpy(last_process_id, current_process.id);
 
             }
 
             dequeue(&ready_queue);
+            quantum_remove(&quantum, current_process.remaining_time);
 
+            STAT_INC(id_lookups);
             for (int j = 0; j < num_processes; j++) {
 
+                STAT_INC(id_compares);
                 if (strcmp(processes[j].id, current_process.id) == 0) {
                     
-                    int time_unit = current_time;
-                    for(int k = 0; k <= exec_time; k++){
-
-                        processes[j].running_time[time_unit] = 1;
-                        time_unit++;
-
-                    }
-                    
+                    trace_run(&trace, &processes[j], j + 1, current_time);
+                    timeline_run(&timeline, processes[j].index, current_time, current_time + exec_time);
                     break;
                 }
             }
@@ -758,39 +779,205 @@ void simulate_round_robin(Process processes[], int num_processes, int time_quant
             
             while (i < num_processes && processes[i].arrival_time <= current_time) {
                 enqueue(&ready_queue, processes[i]);
+                quantum_add(&quantum, processes[i].remaining_time);
+                trace_arrival(&trace, &processes[i], i + 1);
                 i++;
             }
 
             
             if (current_process.remaining_time > 0) {
                 enqueue(&ready_queue, current_process); 
+                quantum_add(&quantum, current_process.remaining_time);
             } else {
                 
+                STAT_INC(id_lookups);
                 for (int j = 0; j < num_processes; j++) {
+                    STAT_INC(id_compares);
                     if (strcmp(processes[j].id, current_process.id) == 0) {
                         processes[j].completion_time = current_time;
                         processes[j].turnaround_time = current_time - processes[j].arrival_time;
                         processes[j].waiting_time = processes[j].turnaround_time - processes[j].burst_time;
+                        trace_stop(&trace, current_time);
+                        record_latency(&ctx->result.latency, &processes[j]);
                         break;
                     }
                 }
-                fprintf(stdout, "| %-8d| Completed P%-9s| ", current_time, current_process.id);
-                display_queue(&ready_queue);
-                fprintf(stdout, "\n+---------+---------------------+---------------------------\n");
+                log_event(ctx, current_time, "Completed", current_process.id, &ready_queue);
+                last_process_id[0] = '\0';
             }
         }
     }
 
-    fprintf(stdout, "\nSimulation complete.");
-    fprintf(stdout, "\n\n~~~~~~~~~~\n\n");
+    quantum_release(&quantum);
+    trace_close(&trace, current_time);
+    end_simulation(ctx, &timeline, current_time, idle_time);
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions produce the parts of a run's output that all of the 
+/    simulators share. Nothing is written if ctx->out is NULL.
+/  
+/  Functions and Their Purpose:
+/    - begin_simulation: Prints the title and the event table heading.
+/    - log_event: Prints one row of the event table: the time, the event 
+/      (e.g. "Started P3"), and the contents of the ready queue.
+/    - end_simulation: Stores the run's totals in ctx->result, calculates 
+/      the summary metrics, writes the window series (if one was asked 
+/      for), then prints the metrics table and Gantt chart. Frees the 
+/      timeline.
+/    With ctx->format set to JSON or CSV, a report is written instead:
+/    the events (only if ctx->log_events is set, with the length of the 
+/    ready queue in place of its contents), the per-process metrics and 
+/    the summary. No Gantt chart is drawn.
+/  
+/  Input Parameters:
+/    - SimContext *ctx: the run being simulated
+/    - const char *title: the algorithm's full name
+/    - long long current_time: the time of the event, or the end of the run
+/    - const char *event, const char *id: the event and the process it 
+/      applies to (id is NULL for "Idle")
+/    - CircularQueue *queue: the ready queue
+/    - Timeline *timeline: the run segments recorded during the run
+/    - long long idle_time: total time the CPU was idle
+/  
+/  Output:
+/    - N/A - output is written to ctx->out
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    - end_simulation re-sorts ctx->processes
+/------------------------------------------------------------------------*/
+void begin_simulation(SimContext *ctx, const char *title) {
+    FILE *out = ctx->out;
+
+    STAT_TIMER_START(simulate);
+    if (out == NULL) return;
+
+    if (ctx->format != REPORT_TEXT) {
+        report_begin(&ctx->report, out, ctx->format);
+        if (ctx->log_events) {
+            report_section(&ctx->report, "events", REPORT_EVENT_COLUMNS, 1);
+        }
+        return;
+    }
+
+    fprintf(out, "~~~~~~~~~~\n\n");
+    fprintf(out, "\nRunning Simulation for %s\n\n", title);
+    fprintf(out, "+---------+---------------------+---------------------------\n");
+    fprintf(out, "| %-8s| %-20s| %-40s", "Time", "Event", "Ready Queue");
+    fprintf(out, "\n+---------+---------------------+---------------------------\n");
+}
+
+void log_event(SimContext *ctx, long long current_time, const char *event, const char *id, CircularQueue *queue) {
+    FILE *out = ctx->out;
+    char label[32];
+
+    STAT_INC(events);
+    if (out == NULL) return;
+
+    if (ctx->format != REPORT_TEXT) {
+        if (ctx->log_events) {
+            report_record(&ctx->report);
+            report_int(&ctx->report, "time", current_time);
+            report_string(&ctx->report, "event", event);
+            report_string(&ctx->report, "process", id);
+            report_int(&ctx->report, "ready", queue->fill);
+        }
+        return;
+    }
+
+    if (id != NULL) {
+        snprintf(label, sizeof(label), "%s P%s", event, id);
+    } else {
+        snprintf(label, sizeof(label), "%s", event);
+    }
+    fprintf(out, "| %-8lld| %-20s| ", current_time, label);
+    display_queue(queue, out);
+    fprintf(out, "\n+---------+---------------------+---------------------------\n");
+}
+
+void end_simulation(SimContext *ctx, Timeline *timeline, long long current_time, long long idle_time) {
+    FILE *out = ctx->out;
+
+    STAT_TIMER_STOP(simulate);
+    STAT_ADD(ticks, current_time);
+    STAT_TIMER_START(metrics);
+
+    ctx->result.current_time = current_time;
+    ctx->result.idle_time = idle_time;
+    calculate_results(ctx);
 
-    // display_metrics(processes, num_processes, idle_time, current_time);
-    display_metrics_table(processes, num_processes, idle_time, current_time);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
+    if (ctx->window_file[0] != '\0') {
+        WindowSeries series;
+
+        qsort(ctx->processes, ctx->num_processes, sizeof(Process), compare_arrival);
+        window_open(&series, ctx->window_file, ctx->window_width, sim_arena(ctx));
+        window_replay(&series, ctx->processes, ctx->num_processes, timeline, current_time);
+        window_close(&series, current_time);
+    }
+
+    if (out != NULL && ctx->format != REPORT_TEXT) {
+        display_report(&ctx->report, ctx->processes, ctx->num_processes,
+                       ctx->algorithm, ctx->time_quantum, &ctx->result);
+        report_end(&ctx->report);
+        STAT_TIMER_STOP(metrics);
+    } else if (out != NULL) {
+        fprintf(out, "\nSimulation complete.");
+        fprintf(out, "\n\n~~~~~~~~~~\n\n");
+
+        qsort(ctx->processes, ctx->num_processes, sizeof(Process), compare_arrival);
+
+        display_metrics_table(out, ctx->processes, ctx->num_processes, &ctx->result);
+        fprintf(out, "\n~~~~~~~~~~\n");
+        STAT_TIMER_STOP(metrics);
+
+        STAT_TIMER_START(chart);
+        display_gantt(out, ctx->processes, ctx->num_processes, timeline, ctx->colour);
+        fprintf(out, "\n~~~~~~~~~~\n");
+        STAT_TIMER_STOP(chart);
+    } else {
+        STAT_TIMER_STOP(metrics);
+    }
+
+    free_timeline(timeline);
+}
 
-    //if stdout is going to tty, print asci colours, else don't
-    isatty(fileno(stdout)) ?
-    display_preemptive_chart(processes, num_processes) :
-    display_preemptive_chart_file(processes, num_processes);
-    fprintf(stdout, "\n~~~~~~~~~~\n");
-}
\ No newline at end of file
+/*---------- FUNCTION: count_switch ------------------------
+/  Function Description:
+/    Counts a dispatch in a preemptive simulator: the process that 
+/    is put on the CPU is dispatched, and the one it took the CPU 
+/    from, if that one has not finished, was preempted or had its 
+/    time slice expire.
+/  
+/  Caller Input:
+/    - Process processes[], int num_processes: the run's processes
+/    - const char *from: ID of the process that had the CPU, or an 
+/      empty string if it finished or the CPU was idle
+/    - const char *to: ID of the process being dispatched
+/    - int time_slice: 1 if from's time slice ended (RR), 0 if it 
+/      was preempted
+/  
+/  Caller Output:
+/    N/A - the counts are kept in the processes
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    - IDs are looked up by a scan of processes, as in the simulators
+/------------------------------------------------------------------------*/
+void count_switch(Process processes[], int num_processes, const char *from, const char *to, int time_slice) {
+    STAT_INC(id_lookups);
+    for (int j = 0; j < num_processes; j++) {
+        STAT_INC(id_compares);
+        if (from[0] != '\0' && strcmp(processes[j].id, from) == 0) {
+            if (time_slice) {
+                processes[j].expirations++;
+            } else {
+                processes[j].preemptions++;
+            }
+        }
+        if (strcmp(processes[j].id, to) == 0) {
+            processes[j].dispatches++;
+        }
+    }
+}
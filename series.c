@@ -0,0 +1,375 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   series.c
+/
+/  File Description:
+/    This file implements the windowed metric time series. A run is
+/    cut into windows of a fixed number of time units, and for each
+/    window the CPU's busy time, the ready-queue length and the
+/    processes that completed are accumulated and written as one CSV
+/    row. Unlike the single throughput and utilization figures in the
+/    metrics table, the series shows how an algorithm copes with
+/    bursts of arrivals as they happen.
+/
+/    The streaming simulator feeds the series as it runs. The batch
+/    simulators record a Timeline, which window_replay sweeps once
+/    the run is complete.
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "process.h"
+#include "timeline.h"
+#include "series.h"
+#include "arena.h"
+#include "stats.h"
+
+#define SERIES_INITIAL_CAPACITY 64
+
+/*---------- STRUCTURE: Completion -------------------------
+/  Structure Description:
+/    When a process completed and how long it waited, used to replay
+/    completions in time order.
+/
+/  Fields:
+/    long long time
+/      Completion time
+/    long long waiting
+/      Waiting time
+/
+/  Relationships:
+/    - used only by window_replay
+/---------------------------------------------------------*/
+typedef struct {
+    long long time;
+    long long waiting;
+} Completion;
+
+void window_flush(WindowSeries *series, long long end_time);
+long long window_wait_percentile(WindowSeries *series, double percentile);
+int compare_long_long(const void *a, const void *b);
+int compare_completion_time(const void *a, const void *b);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: window_open -------------------------
+/  Function Description:
+/    Opens the CSV file and writes its header row. If path is empty
+/    or width is not positive, the series is left disabled.
+/
+/  Caller Input:
+/    WindowSeries *series: the series to initialize
+/    const char *path: pathway of the CSV file, or "" for none
+/    long long width: the length of each window in time units
+/    Arena *arena: where to keep the waiting times (NULL for the heap)
+/
+/  Caller Output:
+/    0 on success (or when disabled), 1 if the file could not be opened
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - prints to stderr if the file does not open, and leaves the
+/      series disabled so the simulation can still run
+/---------------------------------------------------------*/
+int window_open(WindowSeries *series, const char *path, long long width, Arena *arena) {
+    memset(series, 0, sizeof(WindowSeries));
+    series->arena = arena;
+
+    if (path == NULL || path[0] == '\0' || width <= 0) {
+        return 0;
+    }
+
+    series->fp = fopen(path, "w");
+    if (series->fp == NULL) {
+        fprintf(stderr, "Error: window series file did not open.\n");
+        return 1;
+    }
+    series->width = width;
+
+    fprintf(series->fp, "window_start,window_end,completions,throughput,busy_time,"
+            "utilization,mean_queue,max_queue,wait_p50,wait_p90,wait_p99\n");
+    return 0;
+}
+
+/*---------- FUNCTION: window_close ------------------------
+/  Function Description:
+/    Writes the remaining windows up to the end of the run, then
+/    closes the CSV file.
+/
+/  Caller Input:
+/    WindowSeries *series: the series to close
+/    long long end_time: simulation time at which the run ended
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the last window is cut short at end_time, and its throughput
+/      and utilization are relative to its actual length
+/---------------------------------------------------------*/
+void window_close(WindowSeries *series, long long end_time) {
+    long long last;
+
+    if (series->fp == NULL) return;
+
+    last = end_time > 0 ? (end_time - 1) / series->width : 0;
+    while (series->current < last) {
+        window_flush(series, -1);
+    }
+    window_flush(series, end_time);
+
+    STAT_ADD(bytes_series, ftell(series->fp));
+    fclose(series->fp);
+    arena_release(series->arena, series->waits);
+    memset(series, 0, sizeof(WindowSeries));
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions are called as the schedule unfolds to add to the
+/    series. Windows that the run has moved past are written out.
+/
+/  Functions and Their Purpose:
+/    - window_advance: Records that from "from" up to "to" the CPU was
+/      busy (running = 1) or idle, and the ready queue held
+/      queue_length processes. The interval may span several windows.
+/    - window_complete: Records that a process completed at time
+/      after waiting for waiting_time. It counts towards the window in
+/      which its last time unit ran.
+/
+/  Input Parameters:
+/    - WindowSeries *series: the series, a no-op if it is disabled
+/    - long long from, long long to: the interval, to exclusive
+/    - int running: 1 if a process held the CPU for the interval
+/    - long long queue_length: the number of processes that were ready
+/      but not running
+/    - long long time: completion time of a process
+/    - long long waiting_time: waiting time of that process
+/
+/  Output:
+/    - N/A - rows are written to the CSV file
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - assumes events are reported in time order
+/    - a waiting time that cannot be stored for lack of memory is
+/      left out of its window's percentiles, and the arena is marked
+/      failed
+/------------------------------------------------------------------------*/
+void window_advance(WindowSeries *series, long long from, long long to, int running, long long queue_length) {
+    if (series->fp == NULL) return;
+
+    while (from < to) {
+        long long index = from / series->width;
+        long long end = (index + 1) * series->width;
+
+        while (series->current < index) {
+            window_flush(series, -1);
+        }
+        if (end > to) end = to;
+
+        if (running) series->busy += end - from;
+        series->queue_area += queue_length * (end - from);
+        if (queue_length > series->max_queue) series->max_queue = queue_length;
+        from = end;
+    }
+}
+
+void window_complete(WindowSeries *series, long long time, long long waiting_time) {
+    long long index;
+
+    if (series->fp == NULL) return;
+
+    index = time > 0 ? (time - 1) / series->width : 0;
+    while (series->current < index) {
+        window_flush(series, -1);
+    }
+
+    if (series->completions == series->capacity) {
+        int capacity = series->capacity ? series->capacity * 2 : SERIES_INITIAL_CAPACITY;
+        long long *waits = arena_grow(series->arena, series->waits,
+                                      series->capacity * sizeof(long long),
+                                      capacity * sizeof(long long));
+
+        if (waits == NULL) return;
+        series->waits = waits;
+        series->capacity = capacity;
+    }
+    series->waits[series->completions++] = waiting_time;
+}
+
+/*---------- FUNCTION: window_replay -----------------------
+/  Function Description:
+/    Feeds a finished batch run to the series by sweeping its arrival,
+/    dispatch and completion events in time order. The ready-queue
+/    length at any time is the number of processes that have arrived,
+/    less those that have completed and the one that is running.
+/
+/  Caller Input:
+/    WindowSeries *series: the series, a no-op if it is disabled
+/    Process processes[]: the completed processes, sorted by arrival
+/    int num_processes: the number of processes in the array
+/    Timeline *timeline: the run segments recorded by the simulator
+/    long long end_time: simulation time at which the run ended
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - writes nothing if the completions cannot be sorted for lack of
+/      memory, and the arena is marked failed
+/---------------------------------------------------------*/
+void window_replay(WindowSeries *series, Process processes[], int num_processes, Timeline *timeline, long long end_time) {
+    Completion *completions;
+    long long t = 0;
+    long long arrived = 0;
+    long long done = 0;
+    int next_arrival = 0;
+    int next_completion = 0;
+    int s = 0;
+
+    if (series->fp == NULL) return;
+
+    completions = arena_alloc(series->arena, (num_processes + 1) * sizeof(Completion));
+    if (completions == NULL) return;
+    for (int i = 0; i < num_processes; i++) {
+        completions[i].time = processes[i].completion_time;
+        completions[i].waiting = processes[i].waiting_time;
+    }
+    qsort(completions, num_processes, sizeof(Completion), compare_completion_time);
+
+    while (t < end_time) {
+        long long next = end_time;
+        int running;
+
+        while (next_arrival < num_processes && processes[next_arrival].arrival_time <= t) {
+            arrived++;
+            next_arrival++;
+        }
+        while (next_completion < num_processes && completions[next_completion].time <= t) {
+            window_complete(series, completions[next_completion].time, completions[next_completion].waiting);
+            done++;
+            next_completion++;
+        }
+        while (s < timeline->count && timeline->segments[s].end <= t) {
+            s++;
+        }
+
+        running = s < timeline->count && timeline->segments[s].start <= t;
+        if (next_arrival < num_processes && processes[next_arrival].arrival_time < next) {
+            next = processes[next_arrival].arrival_time;
+        }
+        if (next_completion < num_processes && completions[next_completion].time < next) {
+            next = completions[next_completion].time;
+        }
+        if (s < timeline->count) {
+            long long boundary = running ? timeline->segments[s].end : timeline->segments[s].start;
+            if (boundary < next) next = boundary;
+        }
+
+        window_advance(series, t, next, running, arrived - done - running);
+        t = next;
+    }
+
+    while (next_completion < num_processes) {
+        window_complete(series, completions[next_completion].time, completions[next_completion].waiting);
+        next_completion++;
+    }
+
+    arena_release(series->arena, completions);
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION: window_flush ------------------------
+/  Function Description:
+/    Writes the current window's row and starts the next window.
+/
+/  Caller Input:
+/    WindowSeries *series: the series
+/    long long end_time: the end of the run if it falls within this
+/      window, or -1 to write the full window
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the percentiles are left blank for windows with no completions
+/---------------------------------------------------------*/
+void window_flush(WindowSeries *series, long long end_time) {
+    long long start = series->current * series->width;
+    long long end = start + series->width;
+    long long length;
+
+    if (end_time >= 0 && end_time < end) end = end_time;
+    length = end - start;
+
+    fprintf(series->fp, "%lld,%lld,%lld,%.4f,%lld,%.2f,%.2f,%lld,",
+            start, end,
+            series->completions,
+            length > 0 ? (double)series->completions / length : 0.0,
+            series->busy,
+            length > 0 ? (double)series->busy / length * 100 : 0.0,
+            length > 0 ? (double)series->queue_area / length : 0.0,
+            series->max_queue);
+
+    if (series->completions > 0) {
+        qsort(series->waits, series->completions, sizeof(long long), compare_long_long);
+        fprintf(series->fp, "%lld,%lld,%lld\n",
+                window_wait_percentile(series, 50.0),
+                window_wait_percentile(series, 90.0),
+                window_wait_percentile(series, 99.0));
+    } else {
+        fprintf(series->fp, ",,\n");
+    }
+
+    series->current++;
+    series->completions = 0;
+    series->busy = 0;
+    series->queue_area = 0;
+    series->max_queue = 0;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    Small helpers for the window rows.
+/
+/  Functions and Their Purpose:
+/    - window_wait_percentile: The nearest-rank percentile of the
+/      current window's waiting times, which must be sorted.
+/    - compare_long_long, compare_completion_time: qsort comparators.
+/
+/  Input Parameters:
+/    - WindowSeries *series: the series
+/    - double percentile: the percentile, from 0 to 100
+/    - const void *a, const void *b: the elements to compare
+/
+/  Output:
+/    - the percentile, or the usual negative/zero/positive comparison
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+long long window_wait_percentile(WindowSeries *series, double percentile) {
+    double target = percentile / 100.0 * series->completions;
+    long long rank = (long long)target;
+
+    /* nearest-rank: the ceiling of percentile% of the count */
+    if (rank < target) rank++;
+    if (rank < 1) rank = 1;
+    if (rank > series->completions) rank = series->completions;
+    return series->waits[rank - 1];
+}
+
+int compare_long_long(const void *a, const void *b) {
+    long long x = *(const long long *)a;
+    long long y = *(const long long *)b;
+    return (x > y) -
+           (x < y);
+}
+
+int compare_completion_time(const void *a, const void *b) {
+    const Completion *x = (const Completion *)a;
+    const Completion *y = (const Completion *)b;
+    return (x->time > y->time) -
+           (x->time < y->time);
+}
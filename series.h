@@ -0,0 +1,73 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   series.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef SERIES_H
+#define SERIES_H
+
+#include <stdio.h>
+#include "process.h"
+#include "timeline.h"
+#include "arena.h"
+
+/*---------- STRUCTURE: WindowSeries -----------------------
+/  Structure Description:
+/    Splits a simulation into fixed windows of simulated time and
+/    writes one CSV row of metrics per window: completions,
+/    throughput, busy time, utilization, mean and max ready-queue
+/    length, and waiting-time percentiles. Only the current window is
+/    held in memory; each row is written once the simulation moves
+/    past its window.
+/
+/  Fields:
+/    FILE *fp
+/      The CSV file, or NULL when the series is disabled. Every
+/      window_* function is a no-op when this is NULL.
+/    long long width
+/      Length of each window in time units
+/    long long current
+/      Index of the window being accumulated
+/    long long completions
+/      Processes that completed in the current window
+/    long long busy
+/      Time units the CPU was busy in the current window
+/    long long queue_area
+/      Sum over the window's time units of the ready-queue length
+/    long long max_queue
+/      Longest the ready queue was during the window
+/    long long *waits
+/      Waiting times of the processes that completed in the window
+/    int capacity
+/      Number of waiting times the waits array can hold
+/    Arena *arena
+/      Where waits is allocated, or NULL for the heap
+/
+/  Relationships:
+/    - fed by the simulators, or replayed from a Timeline
+/---------------------------------------------------------*/
+typedef struct {
+    FILE *fp;
+    long long width;
+    long long current;
+    long long completions;
+    long long busy;
+    long long queue_area;
+    long long max_queue;
+    long long *waits;
+    int capacity;
+    Arena *arena;
+} WindowSeries;
+
+int window_open(WindowSeries *series, const char *path, long long width, Arena *arena);
+void window_close(WindowSeries *series, long long end_time);
+void window_advance(WindowSeries *series, long long from, long long to, int running, long long queue_length);
+void window_complete(WindowSeries *series, long long time, long long waiting_time);
+void window_replay(WindowSeries *series, Process processes[], int num_processes, Timeline *timeline, long long end_time);
+
+#endif
@@ -16,8 +16,55 @@
 /    Program Input:
 /      - Command-line Arguments:
 /        -a <string>    where <string> = abbreviated algorithm selection
-/        -i <string>    where <string> = full input filepath
+/        -i <string>    where <string> = full input filepath (text, or a
+/                       binary workload written by --convert)
 /        -o <string>    where <string> = full output filepath
+/        -t <string>    where <string> = Chrome trace-event JSON filepath
+/        -q <int>       where <int> = Round Robin time quantum
+/        --quantum <string> where <string> = fixed, median, mean or 
+/                       latency: how RR sets each time slice
+/        -w <int>       where <int> = window length for the time series
+/        -W <string>    where <string> = time series CSV filepath
+/        -s             stream: simulate arrivals while they are still
+/                       being read (input must be sorted by arrival)
+/        --sort         with -s, sort the input by arrival time first, 
+/                       spilling to temporary files if it is large
+/        --sort-memory <int> where <int> = MB the sort may buffer
+/        --decision-cost <string> where <string> = "model[,base[,per]]";
+/                       with -s, charge CPU time for each scheduling 
+/                       decision (model = list, heap, tree or bitmap)
+/        --cache-penalty <string> where <string> = "working_set[,decay]";
+/                       with -s, charge the time processes take to 
+/                       reload their caches after a switch
+/        --cores <string> where <string> = "count[xspeed],..."; with -s,
+/                       run on several cores of the given speeds
+/        --placement <string> where <string> = fastest, energy or big:
+/                       which core a process is placed on
+/        --gang <string> where <string> = strict, backfill or relaxed:
+/                       how the threads of a process are co-scheduled
+/        --groups <string> where <string> = group filepath; with -s,
+/                       schedule processes in a tree of groups
+/        -k <string>    where <string> = Linux scheduler trace filepath
+/                       (perf sched script or ftrace text, "-" for 
+/                       stdin) to stream in place of -i; needs -s
+/        --stats[=json] print engine counters and phase timers to stderr
+/                       (needs a build made with: make STATS=1)
+/        -e <int>       where <int> = Monte Carlo replications of a 
+/                       generated workload (-a may list several 
+/                       algorithms, comma separated, or ALL)
+/        -j <int>       where <int> = threads to run replications on
+/        -g <string>    where <string> = generated workload shape, 
+/                       "count,gap,burst[,priorities]"
+/        --seed <int>   where <int> = seed for the generated workloads
+/        --sweep        run the replications as a sweep on worker 
+/                       processes, over the values given with:
+/        -Q <string>    where <string> = RR quanta, comma separated
+/        -L <string>    where <string> = mean arrival gaps, comma separated
+/        -P <int>       where <int> = worker processes for a sweep
+/        --format <string> where <string> = text, json or csv
+/        --events       include the event list in a json or csv report
+/        --convert <string> where <string> = binary workload filepath to 
+/                       write the text input (-i or stdin) to
 /        -h/--help      outputs a help menu 
 /      - Interactive:
 /        - algorithm selection, number of processes, and process details
@@ -37,9 +84,12 @@
 /          over the course of time
 /      - Formatting:
 /        - output of the results is printed to the terminal through stdout
-/        - if the user specifies an output file, using arguments or bash I/O 
-/          redirection, stdout will be redirected to that file, similarly 
-/          following the manner that Bash performs this 
+/        - if the user specifies an output file with -o, the results are 
+/          written to that file instead; bash I/O redirection of stdout 
+/          works as usual 
+/        - with --format json or csv, the per-process metrics and the 
+/          summary (and with --events, the event list) are written in that 
+/          form instead of the tables, and no Gantt chart is drawn
 /        - Gantt charts are printed using ASCI escape sequence colour codes
 /          when printing to the terminal. When printing to a file, this causes
 /          garbage characters to be inserted into the file, so colour-coding
@@ -53,6 +103,22 @@
 /        - manages the ready queue for the process simulation algorithms
 /      - Options:
 /        - stores settings passed by command-line arguments 
+/      - SimContext:
+/        - holds one simulation run for libsched (see simulator.h); this 
+/          file only gathers the input and hands the context to sim_run
+/      - ExtsortSummary:
+/        - what sorting the input took (see extsort.h)
+/      - Workload:
+/        - a binary workload file mapped into memory, whose columns are 
+/          read in place (see workload.h)
+/      - ImportSummary:
+/        - what an imported kernel trace held and how the kernel ran it 
+/          (see import.h)
+/      - EnsembleSpec:
+/        - describes a Monte Carlo ensemble for run_ensemble (see 
+/          ensemble.h)
+/      - SweepSpec:
+/        - describes a grid of ensembles for run_sweep (see sweep.h)
 /    
 /    Misc:
 /      - Assumes valid file formatting when passing an input file using 
@@ -66,54 +132,188 @@
 #include <string.h>
 #include <unistd.h>
 #include <ctype.h>
+#include <limits.h>
 #include "sim.h"
 #include "process.h"
-#include "scheduling.h"
+#include "simulator.h"
 #include "globals.h"
 #include "options.h"
+#include "stream.h"
+#include "stats.h"
+#include "report.h"
+#include "import.h"
+#include "workload.h"
+#include "extsort.h"
+#include "ensemble.h"
+#include "sweep.h"
+#include "display.h"
 
 
 int parse_cli_args(int argc, char **argv, Options *options);
 void init_options(Options *options);
 void print_help();
-int process_input(Process processes[], int choice);
-int process_file_input(Process processes[], Options *options, int choice);
-void run_cli_mode(int argc, char **argv, Process processes[], Options *options);
-void run_interactive_mode(Process processes[], Options *options);
-void run_selected_algorithm(Process processes[], int num_processes, Options *options);
+int process_input(FILE *in, Process processes[], int choice);
+int process_file_input(FILE *in, Process processes[], int choice);
+int run_cli_mode(FILE *in, const Workload *workload, Options *options, SimContext *ctx);
+int run_convert_mode(FILE *in, Options *options);
+int run_interactive_mode(Options *options, SimContext *ctx);
+int run_selected_algorithm(Options *options, SimContext *ctx);
+int run_ensemble_mode(Options *options, FILE *out);
+int run_sweep_mode(Options *options, FILE *out);
+int configure_ensemble(Options *options, EnsembleSpec *spec, int rr_prompt);
+int parse_value_list(const char *list, int is_int, void *values, int max_values);
+int parse_algorithm_list(const char *list, EnsembleSpec *spec);
+void configure_algorithm(Options *options, SimContext *ctx);
 void print_scheduling_menu();
 int terminal_prompt();
 void str_to_upper(char *str);
+int copy_option(char *dest, size_t size, const char *option, const char *value);
 
 
 int main(int argc, char **argv) {
     Process processes[MAX_PROCESSES];
     Options options;
+    SimContext ctx;
+    FILE *in = stdin;
+    FILE *out = stdout;
+    FILE *counted;
+    ImportSummary imported;
+    ExtsortSummary sorted;
+    Workload workload;
+    int binary = 0;
+    int status;
     
     init_options(&options);
-    parse_cli_args(argc, argv, &options);
+    if (parse_cli_args(argc, argv, &options) != 0) {
+        exit(1);
+    }
 
-    if (options.input_file[0] != '\0') {
-        if (freopen(options.input_file, "r", stdin) == NULL) {
+    if (options.input_file[0] != '\0' && workload_is_binary(options.input_file)) {
+        if (options.convert_file[0] != '\0') {
+            fprintf(stderr, "Error: the input file is already a binary workload.\n");
+            exit(1);
+        }
+        if (options.sort) {
+            fprintf(stderr, "Error: --sort reads text input, and the input file is a binary workload.\n");
+            exit(1);
+        }
+        if (workload_map(&workload, options.input_file) != 0) {
+            exit(1);
+        }
+        binary = 1;
+    } else if (options.input_file[0] != '\0') {
+        in = fopen(options.input_file, "r");
+        if (in == NULL) {
             fprintf(stderr, "Error: input file did not open.\n");
             exit(1);
         }
     }
 
+    if (options.kernel_trace[0] != '\0') {
+        FILE *trace = stdin;
+        int with_priority = strcmp(options.alg_selection, "PS") == 0 || strcmp(options.alg_selection, "PPS") == 0;
+
+        if (strcmp(options.kernel_trace, "-") != 0) {
+            trace = fopen(options.kernel_trace, "r");
+            if (trace == NULL) {
+                fprintf(stderr, "Error: kernel trace did not open.\n");
+                exit(1);
+            }
+        }
+        in = import_open(trace, with_priority, &imported);
+        if (in == NULL) {
+            fprintf(stderr, "Error: kernel trace could not be imported.\n");
+            exit(1);
+        }
+    }
+
+    if (options.sort) {
+        int with_priority = strcmp(options.alg_selection, "PS") == 0 || strcmp(options.alg_selection, "PPS") == 0;
+
+        in = extsort_open(in, with_priority, options.sort_memory, &sorted);
+        if (in == NULL) {
+            exit(1);
+        }
+    }
+
     if (options.output_file[0] != '\0') {
-        if (freopen(options.output_file, "w", stdout) == NULL) {
+        out = fopen(options.output_file, "w");
+        if (out == NULL) {
             fprintf(stderr, "Error: output file did not open.\n");
             exit(1);
         }
     }
 
-    if (argc > 1) {
-        run_cli_mode(argc, argv, processes, &options);
+    init_sim_context(&ctx);
+    ctx.processes = processes;
+    ctx.out = out;
+    ctx.colour = isatty(fileno(out));
+    ctx.format = options.format;
+    ctx.log_events = options.events;
+
+    counted = out;
+    if (options.stats) {
+        stats_reset();
+        counted = stats_count_output(out);
+        ctx.out = counted;
+    }
+    if (options.decision_cost[0] != '\0') {
+        parse_decision_cost(options.decision_cost, &ctx.decision_cost);
+    }
+    if (options.cache_penalty[0] != '\0') {
+        parse_cache_model(options.cache_penalty, &ctx.cache);
+    }
+    if (options.cores[0] != '\0') {
+        parse_core_set(options.cores, &ctx.cores);
+        if (options.placement >= 0) ctx.cores.placement = options.placement;
+        if (options.gang >= 0) ctx.cores.gang = options.gang;
+    }
+    if (options.groups_file[0] != '\0') {
+        FILE *groups = fopen(options.groups_file, "r");
+        int failed;
+
+        if (groups == NULL) {
+            fprintf(stderr, "Error: group file did not open.\n");
+            exit(1);
+        }
+        failed = parse_group_tree(groups, &ctx.groups);
+        fclose(groups);
+        if (failed) exit(1);
+        if (options.time_quantum > 0) ctx.groups.slice = options.time_quantum;
+    }
+    strcpy(ctx.trace_file, options.trace_file);
+    strcpy(ctx.window_file, options.window_file);
+    ctx.window_width = options.window_width;
+
+    if (options.convert_file[0] != '\0') {
+        status = run_convert_mode(in, &options);
+    } else if (options.replications > 0 && options.sweep) {
+        status = run_sweep_mode(&options, ctx.out);
+    } else if (options.replications > 0) {
+        status = run_ensemble_mode(&options, ctx.out);
+    } else if (argc > 1) {
+        status = run_cli_mode(in, binary ? &workload : NULL, &options, &ctx);
     } else {
-        run_interactive_mode(processes, &options);
+        status = run_interactive_mode(&options, &ctx);
     }
 
-    return 0;
+    if (options.kernel_trace[0] != '\0' && status == 0 && options.format == REPORT_TEXT) {
+        display_import_summary(ctx.out, &imported);
+    }
+    if (options.sort && status == 0 && options.format == REPORT_TEXT) {
+        display_sort_summary(ctx.out, &sorted);
+    }
+
+    if (counted != out) fclose(counted);
+    if (in != stdin) fclose(in);
+    if (out != stdout) fclose(out);
+    if (binary) workload_unmap(&workload);
+
+    if (options.stats) {
+        stats_print(stderr, options.stats == 2);
+    }
+
+    return status;
     
 }
 
@@ -124,20 +324,24 @@ int main(int argc, char **argv) {
 /    for info as necessary, then runs the selected algorithm. 
 /  
 /  Caller Input:
-/    int argc: number of command-line args
-/    char **argv: array of command-line args
-/    Process processes[]: array of process details 
+/    FILE *in: the stream process details are read from 
+/    const Workload *workload: the mapped binary input file, or NULL 
+/      if the input is text 
 /    Options *options: pointer to parsed CLI input 
+/    SimContext *ctx: the run, with its processes array and output set 
 /  
 /  Caller Output:
-/    N/A - No output values
+/    0 on success, 1 on failure 
 /  
 /  Assumptions, Limitations, Known Bugs:
 /    - errors are printed to stderr to avoid I/O redirection 
-/    - does not gracefully handle invalid file input formats 
-/    - this combo doesn't seem to work: ./sim < input.txt -o output.txt 
+/    - a malformed input file is reported and nothing is simulated 
+/    - with -s, the processes are streamed from the input file or 
+/      stdin (without prompts) instead of being read up front 
+/    - a binary workload is read from its columns, with no parsing; 
+/      without -s it must still fit in MAX_PROCESSES 
 /---------------------------------------------------------*/
-void run_cli_mode(int argc, char **argv, Process processes[], Options *options) {
+int run_cli_mode(FILE *in, const Workload *workload, Options *options, SimContext *ctx) {
 
     int num_processes = 0;
     int choice = 0;
@@ -173,14 +377,300 @@ void run_cli_mode(int argc, char **argv, Process processes[], Options *options)
         }
     }
 
-    if (options->input_file[0] != '\0') {
-        num_processes = process_file_input(processes, options, choice);
+    if (options->stream) {
+        configure_algorithm(options, ctx);
+        if (workload != NULL) {
+            return sim_stream_workload(ctx, workload);
+        }
+        return sim_stream(ctx, in);
+    }
+
+    STAT_TIMER_START(parse);
+    if (workload != NULL) {
+        num_processes = workload_load(workload, ctx->processes, MAX_PROCESSES, choice == 5 || choice == 6);
+    } else if (options->input_file[0] != '\0') {
+        num_processes = process_file_input(in, ctx->processes, choice);
     } else {
-        num_processes = process_input(processes, choice);
+        num_processes = process_input(in, ctx->processes, choice);
+    }
+    STAT_TIMER_STOP(parse);
+    if (num_processes < 0) {
+        return 1;
+    }
+
+    ctx->num_processes = num_processes;
+    return run_selected_algorithm(options, ctx);
+}
+
+/*---------- FUNCTION: run_convert_mode -------------------
+/  Function Description:
+/    Handles --convert. Reads a text workload and writes it out as a 
+/    binary workload file, which later runs can map with -i instead 
+/    of parsing. 
+/  
+/  Caller Input:
+/    FILE *in: the text workload, one "id arrival burst [priority]" 
+/      per line 
+/    Options *options: pointer to parsed CLI input 
+/  
+/  Caller Output:
+/    0 on success, 1 on failure 
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    - nothing is simulated 
+/    - the report of how many processes were written goes to stderr, 
+/      so stdout can still be redirected 
+/---------------------------------------------------------*/
+int run_convert_mode(FILE *in, Options *options) {
+    long long count = workload_convert(in, options->convert_file);
+
+    if (count < 0) {
+        return 1;
+    }
+    fprintf(stderr, "Wrote %lld processes to %s.\n", count, options->convert_file);
+    return 0;
+}
+
+/*---------- FUNCTION: run_ensemble_mode -------------------
+/  Function Description:
+/    Handles a Monte Carlo ensemble (-e). Builds the ensemble from
+/    the options, runs it, and prints the mean and 95% confidence 
+/    interval of each metric for each selected algorithm. 
+/  
+/  Caller Input:
+/    Options *options: pointer to parsed CLI input 
+/    FILE *out: the stream the results are written to 
+/  
+/  Caller Output:
+/    0 on success, 1 on failure 
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    - no input is read; the workloads are generated 
+/    - prompts for a time quantum if RR is selected and -q was not 
+/      given, as for a single run 
+/---------------------------------------------------------*/
+int run_ensemble_mode(Options *options, FILE *out) {
+    EnsembleSpec spec;
+    EnsembleResult results[ENSEMBLE_MAX_ALGORITHMS];
+
+    if (configure_ensemble(options, &spec, 1) != 0) {
+        return 1;
+    }
+    if (run_ensemble(&spec, results) != 0) {
+        return 1;
+    }
+    display_ensemble(out, &spec, results);
+    return 0;
+}
+
+/*---------- FUNCTION: run_sweep_mode ----------------------
+/  Function Description:
+/    Handles a sweep (--sweep). Builds the grid from the options, 
+/    runs it on worker processes, and prints the merged table. 
+/  
+/  Caller Input:
+/    Options *options: pointer to parsed CLI input 
+/    FILE *out: the stream the results are written to 
+/  
+/  Caller Output:
+/    0 on success, 1 on failure 
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    - the quanta default to the one given with -q (or 1), and the 
+/      load levels to the gap given with -g 
+/---------------------------------------------------------*/
+int run_sweep_mode(Options *options, FILE *out) {
+    SweepSpec spec;
+    SweepCell *cells;
+    int num_cells, restarts;
+    int status;
+
+    init_sweep_spec(&spec);
+    if (configure_ensemble(options, &spec.base, 0) != 0) {
+        return 1;
+    }
+    spec.workers = options->workers;
+    spec.quanta[0] = options->time_quantum > 0 ? options->time_quantum : 1;
+    spec.loads[0] = spec.base.mean_gap;
+
+    if (options->quanta[0] != '\0') {
+        spec.num_quanta = parse_value_list(options->quanta, 1, spec.quanta, SWEEP_MAX_VALUES);
+        if (spec.num_quanta < 1) {
+            fprintf(stderr, "Error: -Q expects up to %d positive integers, comma separated.\n", SWEEP_MAX_VALUES);
+            return 1;
+        }
+    }
+    if (options->loads[0] != '\0') {
+        spec.num_loads = parse_value_list(options->loads, 0, spec.loads, SWEEP_MAX_VALUES);
+        if (spec.num_loads < 1) {
+            fprintf(stderr, "Error: -L expects up to %d numbers, comma separated.\n", SWEEP_MAX_VALUES);
+            return 1;
+        }
+    }
+
+    num_cells = sweep_num_cells(&spec);
+    cells = malloc(num_cells * sizeof(SweepCell));
+    if (cells == NULL) {
+        fprintf(stderr, "Error: out of memory starting the sweep.\n");
+        return 1;
+    }
+
+    status = run_sweep(&spec, cells, &restarts);
+    if (status == 0) {
+        display_sweep(out, &spec, cells, num_cells, restarts);
+    }
+    free(cells);
+    return status;
+}
+
+/*---------- FUNCTION: configure_ensemble ------------------
+/  Function Description:
+/    Fills in an ensemble from the options: replications, threads, 
+/    seed, workload shape (-g) and algorithms (-a). 
+/  
+/  Caller Input:
+/    Options *options: pointer to parsed CLI input 
+/    EnsembleSpec *spec: the ensemble to fill in 
+/    int rr_prompt: 1 to prompt for a time quantum if RR is selected 
+/      and -q was not given 
+/  
+/  Caller Output:
+/    0 on success, 1 on failure 
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+int configure_ensemble(Options *options, EnsembleSpec *spec, int rr_prompt) {
+    int uses_rr = 0;
+
+    init_ensemble_spec(spec);
+    spec->replications = options->replications;
+    spec->threads = options->threads;
+    spec->seed = options->seed;
+
+    if (options->workload[0] != '\0') {
+        int fields = sscanf(options->workload, "%d,%lf,%lf,%d",
+                            &spec->num_processes, &spec->mean_gap, &spec->mean_burst, &spec->max_priority);
+        if (fields < 3) {
+            fprintf(stderr, "Error: -g expects count,gap,burst[,priorities].\n");
+            return 1;
+        }
+    }
+
+    if (parse_algorithm_list(options->alg_selection, spec) != 0) {
+        return 1;
+    }
+    for (int a = 0; a < spec->num_algorithms; a++) {
+        if (strcmp(spec->algorithms[a], "RR") == 0) uses_rr = 1;
+    }
+    if (uses_rr && rr_prompt) {
+        if (options->time_quantum > 0) {
+            spec->time_quantum = options->time_quantum;
+        } else {
+            fprintf(stderr, "Please enter a time quantum for the simulation: ");
+            spec->time_quantum = terminal_prompt();
+        }
+        if (spec->time_quantum < 1) {
+            fprintf(stderr, "Error: time quantum must be at least 1.\n");
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*---------- FUNCTION: parse_value_list --------------------
+/  Function Description:
+/    Parses a comma-separated list of numbers, such as "1,2,4". 
+/  
+/  Caller Input:
+/    const char *list: the list 
+/    int is_int: 1 for a list of positive ints, 0 for non-negative 
+/      doubles 
+/    void *values: the int or double array to fill in 
+/    int max_values: capacity of the array 
+/  
+/  Caller Output:
+/    the number of values, or -1 if the list is malformed 
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+int parse_value_list(const char *list, int is_int, void *values, int max_values) {
+    char copy[256];
+    char *item;
+    int count = 0;
+
+    snprintf(copy, sizeof(copy), "%s", list);
+    for (item = strtok(copy, ","); item != NULL; item = strtok(NULL, ",")) {
+        char *end;
+
+        if (count == max_values) return -1;
+        if (is_int) {
+            long value = strtol(item, &end, 10);
+            if (*end != '\0' || value < 1) return -1;
+            ((int *)values)[count++] = (int)value;
+        } else {
+            double value = strtod(item, &end);
+            if (*end != '\0' || value < 0) return -1;
+            ((double *)values)[count++] = value;
+        }
+    }
+    return count > 0 ? count : -1;
+}
+
+/*---------- FUNCTION: parse_algorithm_list ----------------
+/  Function Description:
+/    Fills in the algorithms of an ensemble from a comma-separated 
+/    list such as "FCFS,RR,SRTF". An empty list or "ALL" selects 
+/    every algorithm. 
+/  
+/  Caller Input:
+/    const char *list: the (uppercase) list given with -a 
+/    EnsembleSpec *spec: the ensemble to fill in 
+/  
+/  Caller Output:
+/    0 on success, 1 if an algorithm is unknown 
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    - an algorithm listed twice is run twice 
+/---------------------------------------------------------*/
+int parse_algorithm_list(const char *list, EnsembleSpec *spec) {
+    static const char *known[ENSEMBLE_MAX_ALGORITHMS] = {"FCFS", "SJF", "SRTF", "RR", "PS", "PPS"};
+    char copy[256];
+    char *name;
+
+    spec->num_algorithms = 0;
+    if (list[0] == '\0' || strcmp(list, "ALL") == 0) {
+        for (int k = 0; k < ENSEMBLE_MAX_ALGORITHMS; k++) {
+            strcpy(spec->algorithms[k], known[k]);
+        }
+        spec->num_algorithms = ENSEMBLE_MAX_ALGORITHMS;
+        return 0;
     }
 
-    run_selected_algorithm(processes, num_processes, options);
+    snprintf(copy, sizeof(copy), "%s", list);
+    for (name = strtok(copy, ","); name != NULL; name = strtok(NULL, ",")) {
+        int found = 0;
+
+        for (int k = 0; k < ENSEMBLE_MAX_ALGORITHMS; k++) {
+            if (strcmp(name, known[k]) == 0) found = 1;
+        }
+        if (!found) {
+            fprintf(stderr, "Invalid choice.\n");
+            return 1;
+        }
+        if (spec->num_algorithms == ENSEMBLE_MAX_ALGORITHMS) {
+            fprintf(stderr, "Error: at most %d algorithms may be listed.\n", ENSEMBLE_MAX_ALGORITHMS);
+            return 1;
+        }
+        strcpy(spec->algorithms[spec->num_algorithms++], name);
+    }
 
+    if (spec->num_algorithms == 0) {
+        fprintf(stderr, "Invalid choice.\n");
+        return 1;
+    }
+    return 0;
 }
 
 /*---------- FUNCTION: terminal_prompt ---------------------
@@ -216,16 +706,16 @@ int terminal_prompt() {
 /    set the algorithm, process count, and process details. 
 /  
 /  Caller Input:
-/    Process processes[]: array of process details 
 /    Options *options: pointer to parsed CLI input 
+/    SimContext *ctx: the run, with its processes array and output set 
 /  
 /  Caller Output:
-/    N/A - No output values
+/    0 on success, 1 on failure 
 /  
 /  Assumptions, Limitations, Known Bugs:
 /    N/A - all seems to be working as intended 
 /---------------------------------------------------------*/
-void run_interactive_mode(Process processes[], Options *options) {
+int run_interactive_mode(Options *options, SimContext *ctx) {
     int choice;
     int num_processes;
 
@@ -242,9 +732,10 @@ void run_interactive_mode(Process processes[], Options *options) {
         default: break;
     }
 
-    num_processes = process_input(processes, choice);
+    num_processes = process_input(stdin, ctx->processes, choice);
 
-    run_selected_algorithm(processes, num_processes, options);
+    ctx->num_processes = num_processes;
+    return run_selected_algorithm(options, ctx);
 }
 
 /*---------- FUNCTION: print_scheduling_menu ---------------
@@ -276,39 +767,54 @@ void print_scheduling_menu() {
 /*---------- FUNCTION: run_selected_algorithm --------------
 /  Function Description:
 /    Runs the selected scheduling algorithm on the processes 
-/    which have been provided. Prompts user for time quantum
-/    if running RR. 
+/    which have been provided, using libsched. 
 /  
 /  Caller Input:
-/    Process processes[]: array of process details 
-/    int num_processes: the number of processes in the array 
 /    Options *options: pointer to parsed CLI input 
+/    SimContext *ctx: the run, with its processes filled in 
 /  
 /  Caller Output:
-/    N/A - No output values
+/    0 on success, 1 on failure 
 /  
 /  Assumptions, Limitations, Known Bugs:
 /    - assumes processes[] contains valid data 
-/    - assumes that a valid algorithm selection has taken place 
+/    - an unknown algorithm is reported by sim_run 
 /---------------------------------------------------------*/
-void run_selected_algorithm(Process processes[], int num_processes, Options *options) {
-    if (strcmp(options->alg_selection, "FCFS") == 0) {
-        simulate_FCFS(processes, num_processes, options);
-    } else if (strcmp(options->alg_selection, "SJF") == 0) {
-        simulate_SJF(processes, num_processes, options);
-    } else if (strcmp(options->alg_selection, "RR") == 0) {
-        int time_quantum;
-        fprintf(stderr, "Please enter a time quantum for the simulation: ");
-        time_quantum = terminal_prompt();
-        simulate_round_robin(processes, num_processes, time_quantum);
-    } else if (strcmp(options->alg_selection, "PS") == 0) {
-        simulate_priority(processes, num_processes, options);
-    } else if (strcmp(options->alg_selection, "SRTF") == 0){
-        simulate_SRTF(processes, num_processes);
-    } else if (strcmp(options->alg_selection, "PPS") == 0) {
-        simulate_preemptive_priority(processes, num_processes);
-    } else{
-         printf("Invalid choice.\n");
+int run_selected_algorithm(Options *options, SimContext *ctx) {
+    configure_algorithm(options, ctx);
+    return sim_run(ctx);
+}
+
+/*---------- FUNCTION: configure_algorithm -----------------
+/  Function Description:
+/    Copies the selected algorithm into the context. Prompts user 
+/    for time quantum if running RR and none was given with -q. The 
+/    median and mean quanta do not need one, and default to a 
+/    smallest slice of 1. 
+/  
+/  Caller Input:
+/    Options *options: pointer to parsed CLI input 
+/    SimContext *ctx: the run to configure 
+/  
+/  Caller Output:
+/    N/A - No output values
+/  
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void configure_algorithm(Options *options, SimContext *ctx) {
+    snprintf(ctx->algorithm, sizeof(ctx->algorithm), "%s", options->alg_selection);
+
+    if (strcmp(ctx->algorithm, "RR") == 0) {
+        ctx->quantum_mode = options->quantum_mode;
+        if (options->time_quantum > 0) {
+            ctx->time_quantum = options->time_quantum;
+        } else if (options->quantum_mode == QUANTUM_MEDIAN || options->quantum_mode == QUANTUM_MEAN) {
+            ctx->time_quantum = 1;
+        } else {
+            fprintf(stderr, "Please enter a time quantum for the simulation: ");
+            ctx->time_quantum = terminal_prompt();
+        }
     }
 }
 
@@ -318,6 +824,7 @@ void run_selected_algorithm(Process processes[], int num_processes, Options *opt
 /    for each from the user. 
 /  
 /  Caller Input:
+/    FILE *in: the stream to read the details from 
 /    Process processes[]: array of process details 
 /    int choice: the scheduling algorithm the user has selected
 /  
@@ -328,10 +835,10 @@ void run_selected_algorithm(Process processes[], int num_processes, Options *opt
 /    - prints to stderr to ensure it prints to the terminal 
 /      when stdin is redirected 
 /---------------------------------------------------------*/
-int process_input(Process processes[], int choice) {
+int process_input(FILE *in, Process processes[], int choice) {
     int num;
     fprintf(stderr, "\nEnter the number of processes (max %d): ", MAX_PROCESSES);
-    scanf("%d", &num);
+    fscanf(in, "%d", &num);
 
     if(num < 1 || num > MAX_PROCESSES){
         fprintf(stderr, "Invalid number of processes. Exiting.\n");
@@ -347,7 +854,7 @@ int process_input(Process processes[], int choice) {
         
         while (!unique) {
             fprintf(stderr, "Process ID: ");
-            scanf("%s", temp_id);
+            fscanf(in, "%9s", temp_id);
 
             if (is_unique_id(processes, i, temp_id)) {
                 unique = 1;
@@ -358,29 +865,18 @@ int process_input(Process processes[], int choice) {
         }
 
         fprintf(stderr, "Arrival Time: ");
-        scanf("%d", &processes[i].arrival_time);
+        fscanf(in, "%lld", &processes[i].arrival_time);
         fprintf(stderr, "Burst Time: ");
-        scanf("%d", &processes[i].burst_time);
+        fscanf(in, "%lld", &processes[i].burst_time);
 
 
         if (choice == 5 || choice == 6) {
             fprintf(stderr, "Priority: ");
-            scanf("%d", &processes[i].priority);
+            fscanf(in, "%d", &processes[i].priority);
         }
 
         /* Set up other default values */
-        processes[i].remaining_time = processes[i].burst_time;
-        processes[i].start_time = -1;
-        processes[i].completion_time = 0;
-        processes[i].turnaround_time = 0;
-        processes[i].waiting_time = 0;
-        processes[i].response_time = -1;
-        processes[i].predicted_burst = -1;
-        processes[i].has_started = 0;
-
-        for(int j = 0; j < MAX_RUNTIME; j++){
-            processes[i].running_time[j] = 0;
-        }
+        reset_process(&processes[i], i);
     }
 
     fprintf(stderr, "\n");
@@ -395,81 +891,28 @@ int process_input(Process processes[], int choice) {
 /    to ensure all necessary attributes are captured. 
 /  
 /  Caller Input:
+/    FILE *in: the opened input file 
 /    Process processes[]: array of process details 
-/    Options *options: pointer to parsed CLI input 
 /    int choice: the scheduling algorithm the user has selected
 /  
 /  Caller Output:
-/    int i: the number of processes in the file 
+/    the number of processes in the file, or -1 if it is malformed 
 /  
 /  Assumptions, Limitations, Known Bugs:
-/    - assumes that the file format matches what is expected, errors 
-/      might cause improper or incomplete population 
+/    - the parsing itself is done by sim_read_workload in libsched 
 /    - prints to stderr to ensure it prints to the terminal 
 /      when stdin is redirected 
 /---------------------------------------------------------*/
-int process_file_input(Process processes[], Options *options, int choice) {
-
-    int i = 0;
-    char temp_id[10];
-    int unique = 0;
-    char pid[10];
-    int arrival, burst, priority, vals_read;
-
-    if (options->input_file[0] == '\0') {
-        fprintf(stderr, "Error: no input file.\n");
-        return 0;
-    }
-
-    while (i < MAX_PROCESSES) {
-
-        if (choice >= 0 && choice < 5) {
-            vals_read = fscanf(stdin, "%s %d %d", temp_id, &arrival, &burst);
-        } else if (choice == 5 || choice == 6) {
-            vals_read = fscanf(stdin, "%s %d %d %d", temp_id, &arrival, &burst, &priority);
-        } else {
-            fprintf(stderr, "Error: invalid choice.\n");
-        }
-
-        if (vals_read == EOF) break;
-
-        while (!unique) {
-            if (is_unique_id(processes, i, temp_id)) {
-                unique = 1;
-                strcpy(processes[i].id, temp_id);
-            } else {
-                fprintf(stderr, "Error: ID is taken. Enter a unique ID.\n");
-            }
-        }
-        unique = 0;
-
-        processes[i].arrival_time = arrival;
-        processes[i].burst_time = burst;
-        processes[i].priority = (vals_read == 3) ? -1 : priority;
-        processes[i].remaining_time = processes[i].burst_time;
-        processes[i].start_time = -1;         
-        processes[i].completion_time = -1;    
-        processes[i].turnaround_time = -1;    
-        processes[i].waiting_time = -1;       
-        processes[i].response_time = -1;
-        processes[i].predicted_burst = -1;
-        processes[i].has_started = 0;
-
-        for (int j = 0; j < MAX_RUNTIME; j++) {
-            processes[i].running_time[j] = 0;
-        } 
-
-        i++;
-    }
-
-    return i;
-
+int process_file_input(FILE *in, Process processes[], int choice) {
+    return sim_read_workload(in, processes, MAX_PROCESSES, choice == 5 || choice == 6);
 }
 
 /*---------- FUNCTION: init_options ------------------------
 /  Function Description:
-/    Initializes each of the members of the options struct 
-/    as an empty string. 
+/    Initializes each of the string members of the options struct 
+/    as an empty string, the time quantum as 0 (not given), turns 
+/    streaming off, and sets up a single run rather than an ensemble 
+/    (with seed 1 should one be requested). 
 /  
 /  Caller Input:
 /    Options *options: pointer to options struct 
@@ -484,6 +927,33 @@ void init_options(Options *options) {
     strcpy(options->alg_selection, "");
     strcpy(options->input_file, "");
     strcpy(options->output_file, "");
+    strcpy(options->trace_file, "");
+    options->time_quantum = 0;
+    options->quantum_mode = QUANTUM_FIXED;
+    options->stream = 0;
+    strcpy(options->window_file, "");
+    options->window_width = 0;
+    options->stats = 0;
+    options->replications = 0;
+    options->threads = 0;
+    options->seed = 1;
+    strcpy(options->workload, "");
+    options->sweep = 0;
+    options->workers = 0;
+    strcpy(options->quanta, "");
+    strcpy(options->loads, "");
+    options->format = REPORT_TEXT;
+    options->events = 0;
+    strcpy(options->kernel_trace, "");
+    strcpy(options->convert_file, "");
+    options->sort = 0;
+    options->sort_memory = EXTSORT_DEFAULT_MEMORY;
+    strcpy(options->decision_cost, "");
+    strcpy(options->cache_penalty, "");
+    strcpy(options->cores, "");
+    options->placement = -1;
+    options->gang = -1;
+    strcpy(options->groups_file, "");
 }
 
 /*---------- FUNCTION: parse_cli_args ----------------------
@@ -510,7 +980,7 @@ int parse_cli_args(int argc, char **argv, Options *options) {
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-a") == 0) {
             if (i + 1 < argc) {
-                strcpy(options->alg_selection, argv[++i]);
+                snprintf(options->alg_selection, sizeof(options->alg_selection), "%s", argv[++i]);
                 str_to_upper(options->alg_selection);
             } else {
                 fprintf(stderr, "Error: -a option requires an argument.");
@@ -518,18 +988,259 @@ int parse_cli_args(int argc, char **argv, Options *options) {
             }
         } else if (strcmp(argv[i], "-i") == 0) {
             if (i + 1 < argc) {
-                strcpy(options->input_file, argv[++i]);
+                snprintf(options->input_file, sizeof(options->input_file), "%s", argv[++i]);
             } else {
                 fprintf(stderr, "Error: -i option requires an argument.\n");
                 return 1;
             }
         } else if (strcmp(argv[i], "-o") == 0) {
             if (i + 1 < argc) {
-                strcpy(options->output_file, argv[++i]);
+                snprintf(options->output_file, sizeof(options->output_file), "%s", argv[++i]);
             } else {
                 fprintf(stderr, "Error: -o option requires an argument.\n");
                 return 1;
             }
+        } else if (strcmp(argv[i], "-t") == 0) {
+            if (i + 1 < argc) {
+                snprintf(options->trace_file, sizeof(options->trace_file), "%s", argv[++i]);
+            } else {
+                fprintf(stderr, "Error: -t option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-q") == 0) {
+            if (i + 1 < argc) {
+                options->time_quantum = atoi(argv[++i]);
+                if (options->time_quantum < 1) {
+                    fprintf(stderr, "Error: -q option requires a positive integer.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: -q option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--quantum") == 0) {
+            if (i + 1 < argc) {
+                options->quantum_mode = quantum_mode(argv[++i]);
+                if (options->quantum_mode < 0) {
+                    fprintf(stderr, "Error: --quantum option requires fixed, median, mean or latency.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: --quantum option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-w") == 0) {
+            if (i + 1 < argc) {
+                options->window_width = atoll(argv[++i]);
+                if (options->window_width < 1) {
+                    fprintf(stderr, "Error: -w option requires a positive integer.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: -w option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-W") == 0) {
+            if (i + 1 < argc) {
+                if (copy_option(options->window_file, sizeof(options->window_file), argv[i], argv[i + 1]) != 0) return 1;
+                i++;
+            } else {
+                fprintf(stderr, "Error: -W option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--stats") == 0 || strcmp(argv[i], "--stats=json") == 0) {
+            if (!stats_enabled()) {
+                fprintf(stderr, "Error: --stats needs a build with instrumentation "
+                        "(make clean && make STATS=1).\n");
+                return 1;
+            }
+            options->stats = (strcmp(argv[i], "--stats=json") == 0) ? 2 : 1;
+        } else if (strcmp(argv[i], "-e") == 0) {
+            if (i + 1 < argc) {
+                options->replications = atoi(argv[++i]);
+                if (options->replications < 2) {
+                    fprintf(stderr, "Error: -e option requires at least 2 replications.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: -e option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-j") == 0) {
+            if (i + 1 < argc) {
+                options->threads = atoi(argv[++i]);
+                if (options->threads < 1) {
+                    fprintf(stderr, "Error: -j option requires a positive integer.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: -j option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-g") == 0) {
+            if (i + 1 < argc) {
+                snprintf(options->workload, sizeof(options->workload), "%s", argv[++i]);
+            } else {
+                fprintf(stderr, "Error: -g option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            if (i + 1 < argc) {
+                options->seed = strtoull(argv[++i], NULL, 10);
+            } else {
+                fprintf(stderr, "Error: --seed option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--sweep") == 0) {
+            options->sweep = 1;
+        } else if (strcmp(argv[i], "-P") == 0) {
+            if (i + 1 < argc) {
+                options->workers = atoi(argv[++i]);
+                if (options->workers < 1) {
+                    fprintf(stderr, "Error: -P option requires a positive integer.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: -P option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-Q") == 0) {
+            if (i + 1 < argc) {
+                if (copy_option(options->quanta, sizeof(options->quanta), argv[i], argv[i + 1]) != 0) return 1;
+                i++;
+            } else {
+                fprintf(stderr, "Error: -Q option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-L") == 0) {
+            if (i + 1 < argc) {
+                if (copy_option(options->loads, sizeof(options->loads), argv[i], argv[i + 1]) != 0) return 1;
+                i++;
+            } else {
+                fprintf(stderr, "Error: -L option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--format") == 0) {
+            if (i + 1 < argc) {
+                options->format = report_format(argv[++i]);
+                if (options->format < 0) {
+                    fprintf(stderr, "Error: --format option requires text, json or csv.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: --format option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--events") == 0) {
+            options->events = 1;
+        } else if (strcmp(argv[i], "-k") == 0) {
+            if (i + 1 < argc) {
+                if (copy_option(options->kernel_trace, sizeof(options->kernel_trace), argv[i], argv[i + 1]) != 0) return 1;
+                i++;
+            } else {
+                fprintf(stderr, "Error: -k option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--convert") == 0) {
+            if (i + 1 < argc) {
+                if (copy_option(options->convert_file, sizeof(options->convert_file), argv[i], argv[i + 1]) != 0) return 1;
+                i++;
+            } else {
+                fprintf(stderr, "Error: --convert option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--sort") == 0) {
+            options->sort = 1;
+        } else if (strcmp(argv[i], "--sort-memory") == 0) {
+            if (i + 1 < argc) {
+                char *end;
+                long long megabytes = strtoll(argv[++i], &end, 10);
+
+                /* checked before scaling, so the byte count cannot overflow */
+                if (end == argv[i] || *end != '\0' || megabytes < 1 || megabytes > LLONG_MAX / (1024 * 1024)) {
+                    fprintf(stderr, "Error: --sort-memory option requires a whole number of megabytes "
+                            "from 1 to %lld.\n", LLONG_MAX / (1024 * 1024));
+                    return 1;
+                }
+                options->sort_memory = megabytes * 1024 * 1024;
+            } else {
+                fprintf(stderr, "Error: --sort-memory option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--decision-cost") == 0) {
+            DecisionCost cost;
+
+            if (i + 1 < argc) {
+                snprintf(options->decision_cost, sizeof(options->decision_cost), "%s", argv[++i]);
+                if (parse_decision_cost(options->decision_cost, &cost) != 0) {
+                    fprintf(stderr, "Error: --decision-cost expects list, heap, tree or bitmap, "
+                            "then optionally a base and per-step cost, comma separated.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: --decision-cost option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--cache-penalty") == 0) {
+            CacheModel model;
+
+            if (i + 1 < argc) {
+                snprintf(options->cache_penalty, sizeof(options->cache_penalty), "%s", argv[++i]);
+                if (parse_cache_model(options->cache_penalty, &model) != 0) {
+                    fprintf(stderr, "Error: --cache-penalty expects a working set (a whole number of "
+                            "time units), then optionally a positive decay, comma separated.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: --cache-penalty option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--cores") == 0) {
+            CoreSet cores;
+
+            if (i + 1 < argc) {
+                snprintf(options->cores, sizeof(options->cores), "%s", argv[++i]);
+                init_core_set(&cores);
+                if (parse_core_set(options->cores, &cores) != 0) {
+                    fprintf(stderr, "Error: --cores expects groups of count[xspeed], comma separated, "
+                            "with at most %d cores and %d speeds.\n", MAX_CORES, MAX_CORE_CLASSES);
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: --cores option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--placement") == 0) {
+            if (i + 1 < argc) {
+                options->placement = placement_policy(argv[++i]);
+                if (options->placement < 0) {
+                    fprintf(stderr, "Error: --placement option requires fastest, energy or big.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: --placement option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--gang") == 0) {
+            if (i + 1 < argc) {
+                options->gang = gang_mode(argv[++i]);
+                if (options->gang < 0) {
+                    fprintf(stderr, "Error: --gang option requires strict, backfill or relaxed.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: --gang option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--groups") == 0) {
+            if (i + 1 < argc) {
+                snprintf(options->groups_file, sizeof(options->groups_file), "%s", argv[++i]);
+            } else {
+                fprintf(stderr, "Error: --groups option requires an argument.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-s") == 0) {
+            options->stream = 1;
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             print_help();
         } else {
@@ -537,6 +1248,88 @@ int parse_cli_args(int argc, char **argv, Options *options) {
             return 1;
         }
     }
+
+    if ((options->window_width > 0) != (options->window_file[0] != '\0')) {
+        fprintf(stderr, "Error: -w and -W must be given together.\n");
+        options->window_width = 0;
+        strcpy(options->window_file, "");
+        return 1;
+    }
+    if (options->replications > 0 && (options->stream || options->input_file[0] != '\0' ||
+                                      options->trace_file[0] != '\0' || options->window_file[0] != '\0')) {
+        fprintf(stderr, "Error: -e generates its own workloads and cannot be used with -i, -s, -t or -W.\n");
+        return 1;
+    }
+    if (options->replications == 0 && (options->sweep || options->workers > 0 ||
+                                       options->quanta[0] != '\0' || options->loads[0] != '\0')) {
+        fprintf(stderr, "Error: --sweep, -P, -Q and -L need -e.\n");
+        return 1;
+    }
+    if (options->kernel_trace[0] != '\0' && (!options->stream || options->alg_selection[0] == '\0' ||
+                                              options->input_file[0] != '\0')) {
+        fprintf(stderr, "Error: -k streams the trace, so it needs -s and -a, and cannot be used with -i.\n");
+        return 1;
+    }
+    if (options->replications > 0 && options->format != REPORT_TEXT) {
+        fprintf(stderr, "Error: --format applies to single runs and cannot be used with -e.\n");
+        return 1;
+    }
+    if (options->events && (options->format == REPORT_TEXT || options->stream)) {
+        fprintf(stderr, "Error: --events needs --format json or csv, and cannot be used with -s.\n");
+        return 1;
+    }
+    if (options->sort && (!options->stream || options->alg_selection[0] == '\0' ||
+                          options->kernel_trace[0] != '\0')) {
+        fprintf(stderr, "Error: --sort needs -s and -a, and cannot be used with -k.\n");
+        return 1;
+    }
+    if (options->quantum_mode != QUANTUM_FIXED && (options->replications > 0 ||
+                                                   (options->alg_selection[0] != '\0' &&
+                                                    strcmp(options->alg_selection, "RR") != 0))) {
+        fprintf(stderr, "Error: --quantum applies to single RR runs.\n");
+        return 1;
+    }
+    if (options->decision_cost[0] != '\0' && !options->stream) {
+        fprintf(stderr, "Error: --decision-cost is charged by the streaming simulator, so it needs -s.\n");
+        return 1;
+    }
+    if (options->cache_penalty[0] != '\0' && (!options->stream || options->sort)) {
+        fprintf(stderr, "Error: --cache-penalty is charged by the streaming simulator, so it needs -s, "
+                "and cannot be used with --sort, which drops the working set column.\n");
+        return 1;
+    }
+    if (options->cores[0] != '\0' && (!options->stream || options->trace_file[0] != '\0' ||
+                                       options->window_file[0] != '\0' || options->decision_cost[0] != '\0' ||
+                                       options->cache_penalty[0] != '\0')) {
+        fprintf(stderr, "Error: --cores runs the streaming simulator on several cores, so it needs -s, "
+                "and cannot be used with -t, -W, --decision-cost or --cache-penalty.\n");
+        return 1;
+    }
+    if (options->placement >= 0 && options->cores[0] == '\0') {
+        fprintf(stderr, "Error: --placement needs --cores.\n");
+        return 1;
+    }
+    if (options->gang >= 0 && (options->cores[0] == '\0' || options->sort)) {
+        fprintf(stderr, "Error: --gang needs --cores, and cannot be used with --sort, which drops the "
+                "thread count column.\n");
+        return 1;
+    }
+    if (options->groups_file[0] != '\0' && (!options->stream || options->kernel_trace[0] != '\0' ||
+                                              options->sort || options->cores[0] != '\0' ||
+                                              options->cache_penalty[0] != '\0')) {
+        fprintf(stderr, "Error: --groups needs -s, and cannot be used with -k, --sort, --cores or "
+                "--cache-penalty, which drop or add input columns.\n");
+        return 1;
+    }
+    if (options->convert_file[0] != '\0' && (options->replications > 0 || options->stream ||
+                                              options->kernel_trace[0] != '\0')) {
+        fprintf(stderr, "Error: --convert only converts its input, and cannot be used with -e, -s or -k.\n");
+        return 1;
+    }
+    if (!options->sweep && (options->workers > 0 || options->quanta[0] != '\0' || options->loads[0] != '\0')) {
+        fprintf(stderr, "Error: -P, -Q and -L need --sweep.\n");
+        return 1;
+    }
     return 0;
 }
 
@@ -558,7 +1351,7 @@ int parse_cli_args(int argc, char **argv, Options *options) {
 /---------------------------------------------------------*/
 void print_help() {
     fprintf(stderr, "NAME\n\tsim - simulate process scheduling algorithms\n\n");
-    fprintf(stderr, "SYNOPSIS\n\t./sim [-a algorithm_type] [-i file_name] [-o file_name] [-h | --help]\n\n");
+    fprintf(stderr, "SYNOPSIS\n\t./sim [-a algorithm_type] [-i file_name] [-o file_name] [-t file_name] [-q quantum [--quantum fixed|median|mean|latency]] [-w width -W file_name] [-s [-k trace_file] [--sort [--sort-memory MB]] [--decision-cost model[,base[,per]]] [--cache-penalty working_set[,decay]] [--cores count[xspeed],... [--placement fastest|energy|big] [--gang strict|backfill|relaxed]] [--groups file_name]] [--stats[=json]] [-e replications [-j threads] [-g count,gap,burst[,priorities]] [--seed n] [--sweep [-Q quanta] [-L gaps] [-P workers]]] [--format text|json|csv [--events]] [--convert file_name] [-h | --help]\n\n");
     fprintf(stderr, "DESCRIPTION\n");
     fprintf(stderr, "\tSimulates various process scheduling algorithms. The user may "
            "provide input data\n\tthrough stdin or by redirecting data from an input file. "
@@ -573,52 +1366,139 @@ void print_help() {
     fprintf(stderr, "\t\tRR\t\tRound Robin\n");
     fprintf(stderr, "\t\tPS\tPriority Scheduling\n");
     fprintf(stderr, "\t\tPPS\t\tPreemptive Priority Scheduling\n\n");
-    fprintf(stderr, "\t-i file_name\n\t\tSpecify the full path of an input file.\n\n");
+    fprintf(stderr, "\t-i file_name\n\t\tSpecify the full path of an input file: text, or a binary workload\n"
+           "\t\twritten by --convert, which is mapped and read with no parsing.\n\n");
     fprintf(stderr, "\t-o file_name\n\t\tSpecify the full path of an output file.\n\n");
+    fprintf(stderr, "\t-t file_name\n\t\tWrite the schedule as Chrome trace-event JSON, viewable in\n"
+           "\t\tPerfetto (ui.perfetto.dev) or chrome://tracing.\n\n");
+    fprintf(stderr, "\t-q quantum\n\t\tSpecify the Round Robin time quantum instead of being prompted.\n\n");
+    fprintf(stderr, "\t--quantum fixed|median|mean|latency\n\t\tHow Round Robin sets each time slice: the -q quantum (fixed, the\n"
+           "\t\tdefault); the median or mean remaining burst time of the ready queue,\n"
+           "\t\tbut at least -q (default 1); or the -q quantum taken as a target\n"
+           "\t\tlatency and shared between the ready processes (latency).\n\n");
+    fprintf(stderr, "\t-w width -W file_name\n\t\tWrite a time series of the run to a CSV file, one row per width\n"
+           "\t\ttime units: completions, throughput, busy time, utilization, mean\n"
+           "\t\tand max ready-queue length, and p50/p90/p99 waiting time.\n\n");
+    fprintf(stderr, "\t-s\n\t\tStream the input: processes are simulated as they are read and\n"
+           "\t\tforgotten once complete, and each one's metrics are written as it\n"
+           "\t\tfinishes. The input must be sorted by arrival time. Suits long\n"
+           "\t\ttraces piped in on stdin. No Gantt chart is drawn.\n\n");
+    fprintf(stderr, "\t--sort [--sort-memory MB]\n\t\tWith -s, sort the input by arrival time before streaming it. Input\n"
+           "\t\tlarger than the sort's memory (default: %d MB) is sorted in runs\n"
+           "\t\tspilled to temporary files in $TMPDIR and merged, so a trace larger\n"
+           "\t\tthan RAM can be simulated. Input already in order is not sorted.\n\n",
+           EXTSORT_DEFAULT_MEMORY / (1024 * 1024));
+    fprintf(stderr, "\t--decision-cost model[,base[,per]]\n\t\tWith -s, charge CPU time for each scheduling decision, as a scheduler\n"
+           "\t\tkeeping n ready processes in the given structure would take:\n"
+           "\t\tlist (base + per * n), heap (base + per * log2 n), tree (base + per\n"
+           "\t\t* 2 log2 n) or bitmap (base + per). The defaults are base %g and\n"
+           "\t\tper %g time units. The overhead is reported as a share of the CPU.\n\n",
+           COST_DEFAULT_BASE, COST_DEFAULT_PER);
+    fprintf(stderr, "\t--cache-penalty working_set[,decay]\n\t\tWith -s, charge the time a process takes to reload its cache after\n"
+           "\t\ta switch before it makes progress again. The working set is the time a\n"
+           "\t\tfull reload takes; a text input line may end with the process's own.\n"
+           "\t\tA waiting process loses all but 1/e of its cache once others have run\n"
+           "\t\tfor decay time units (default: the working set); idle time costs it\n"
+           "\t\tnothing. The refill time is reported as a share of the CPU.\n\n");
+    fprintf(stderr, "\t--cores count[xspeed],... [--placement fastest|energy|big]\n\t\tWith -s, run on several cores sharing one ready queue, e.g. \"4x1,4x0.5\"\n"
+           "\t\tfor four cores and four cores twice as slow; a burst of B takes B/speed.\n"
+           "\t\tA process goes to the fastest idle core (fastest, the default), to the\n"
+           "\t\tslowest (energy), or to the fastest with running processes moved up\n"
+           "\t\tto faster cores as they free up (big). Each class of cores is reported\n"
+           "\t\twith its utilization, response times and energy (speed^3 per unit).\n\n");
+    fprintf(stderr, "\t--gang strict|backfill|relaxed\n\t\tWith --cores, a text input line may end with the process's number of\n"
+           "\t\tthreads (default 1), which run on cores of their own at once. Under\n"
+           "\t\tstrict, a process waits for that many idle cores and the ones behind it\n"
+           "\t\twait too; backfill lets those behind it start early if that does not\n"
+           "\t\tdelay it; relaxed starts it on the idle cores there are, its threads\n"
+           "\t\tsharing them. Backfills, idle core time while processes wait and the\n"
+           "\t\tslowdown (turnaround over the burst on the fastest cores) are reported.\n\n");
+    fprintf(stderr, "\t--groups file_name\n\t\tWith -s, schedule processes in a tree of groups, one per line of the\n"
+           "\t\tfile as \"name parent shares [quota period]\" (the root is \"/\"). A text\n"
+           "\t\tinput line may end with the group of its process (default \"/\"), which\n"
+           "\t\tmust have no groups in it. At each level, the group that used the least\n"
+           "\t\tCPU for its shares runs next, for a slice of -q (default 10); within\n"
+           "\t\tit, the algorithm picks. A group may use at most quota time units in\n"
+           "\t\teach period (quota \"max\" for no limit). Each group is reported with\n"
+           "\t\tits entitled and used share of the CPU and the time it was throttled.\n\n");
+    fprintf(stderr, "\t-k trace_file\n\t\tWith -s, replay a Linux scheduler trace (the output of \"perf sched\n"
+           "\t\tscript\", or ftrace text with sched_switch and sched_wakeup enabled;\n"
+           "\t\t\"-\" reads stdin). Each wakeup-to-sleep of a task becomes a job, in\n"
+           "\t\tmicroseconds, with its kernel priority. How the kernel scheduled the\n"
+           "\t\tsame jobs is printed after the run, for comparison.\n\n");
+    fprintf(stderr, "\t--stats, --stats=json\n\t\tPrint engine counters (queue operations, sorts, comparisons, ID\n"
+           "\t\tlookups, steps vs. events, bytes written) and phase timers to stderr,\n"
+           "\t\tas a table or as JSON. Only available in builds made with STATS=1.\n\n");
+    fprintf(stderr, "\t-e replications\n\t\tRun a Monte Carlo ensemble: generate this many random workloads,\n"
+           "\t\trun each through the algorithms given with -a (a comma-separated\n"
+           "\t\tlist, or ALL), and print each metric's mean and 95%% confidence\n"
+           "\t\tinterval, and the latency percentiles of every process of every\n"
+           "\t\tworkload. No input is read.\n\n");
+    fprintf(stderr, "\t-j threads\n\t\tRun the replications on this many threads (default: one per CPU).\n"
+           "\t\tThe results do not depend on it.\n\n");
+    fprintf(stderr, "\t-g count,gap,burst[,priorities]\n\t\tShape of the generated workloads: the number of processes (at most\n"
+           "\t\t%d), the mean time between arrivals, the mean burst time, and the\n"
+           "\t\thighest priority (default: %d,4,5,5).\n\n", ENSEMBLE_MAX_PROCESSES, MAX_PROCESSES);
+    fprintf(stderr, "\t--seed n\n\t\tSeed for the generated workloads (default: 1).\n\n");
+    fprintf(stderr, "\t--sweep [-Q q1,q2,...] [-L gap1,gap2,...] [-P workers]\n\t\tRun a grid of ensembles: every algorithm given with -a, for RR every\n"
+           "\t\tquantum given with -Q, and every mean arrival gap given with -L, each\n"
+           "\t\ton the same -e seeds. The grid is split into shards run by -P worker\n"
+           "\t\tprocesses (default: one per CPU); the shards of a worker that crashes\n"
+           "\t\tare rerun. Prints one table row per cell, with the p99 of the waiting\n"
+           "\t\ttimes of every process of its seeds.\n\n");
+    fprintf(stderr, "\t--format text|json|csv [--events]\n\t\tWrite the per-process metrics and the summary metrics (mean, min,\n"
+           "\t\tmax, std. dev. and percentiles) as JSON, one object per run, or as\n"
+           "\t\tCSV tables separated by blank lines, instead of the text tables.\n"
+           "\t\tWith --events, the event list is included too. Not for use with -e.\n\n");
+    fprintf(stderr, "\t--convert file_name\n\t\tConvert the text input (-i, or stdin) to a binary workload file,\n"
+           "\t\tinstead of simulating it. Giving the file to -i later skips parsing,\n"
+           "\t\twhich suits large traces run many times with -s.\n\n");
     fprintf(stderr, "\t-h, --help\n\t\tPrint detailed help info about the program.\n\n");
 }
 
-/*---------- FUNCTION: is_unique_id ------------------------
+/*---------- FUNCTION: str_to_upper ------------------------
 /  Function Description:
-/    Checks whether a given process ID is unique amongst the 
-/    other array entries. 
+/    Converts the characters in a given string to uppercase.
 /  
 /  Caller Input:
-/    Process processes[]: array of process details 
-/    int count: number of processes in the array 
-/    char *id: the pid that needs to be validated as unique 
+/    char *str: the string to be made uppercase
 /  
 /  Caller Output:
-/    0 on success, 1 on failure 
+/    N/A - No output values
 /  
 /  Assumptions, Limitations, Known Bugs:
-/    - assumes the array contains valid data 
+/    N/A - simple, tested, works as intended 
 /---------------------------------------------------------*/
-int is_unique_id(Process processes[], int count, char *id) {
-    for (int i = 0; i < count; i++) {
-        if (strcmp(processes[i].id, id) == 0) {
-            return 0;
-        }
+void str_to_upper(char *str) {
+    while (*str != '\0') {
+        *str = toupper(*str);
+        str++;
     }
-    return 1;
 }
-
-/*---------- FUNCTION: str_to_upper ------------------------
+/*---------- FUNCTION: copy_option -------------------------
 /  Function Description:
-/    Converts the characters in a given string to uppercase.
+/    Copies the value of a command-line option into its field of the
+/    options, if it fits.
 /  
 /  Caller Input:
-/    char *str: the string to be made uppercase
+/    char *dest: the field
+/    size_t size: the size of the field
+/    const char *option: the option, as given, for the error message
+/    const char *value: the option's value
 /  
 /  Caller Output:
-/    N/A - No output values
+/    0 on success, 1 if the value is too long (dest is then left as
+/    it was)
 /  
 /  Assumptions, Limitations, Known Bugs:
-/    N/A - simple, tested, works as intended 
+/    - prints to stderr if the value is too long, as cutting it short
+/      would silently change what is run
 /---------------------------------------------------------*/
-void str_to_upper(char *str) {
-    while (*str != '\0') {
-        *str = toupper(*str);
-        str++;
+int copy_option(char *dest, size_t size, const char *option, const char *value) {
+    if (strlen(value) >= size) {
+        fprintf(stderr, "Error: the value of %s is too long (at most %zu characters).\n", option, size - 1);
+        return 1;
     }
-}
\ No newline at end of file
+    strcpy(dest, value);
+    return 0;
+}
@@ -11,9 +11,9 @@
 #ifndef SIM_H
 #define SIM_H
 
+#include <stdio.h>
 #include "process.h"
 
-int process_input(Process processes[], int choice);
-int is_unique_id(Process processes[], int count, char *id);
+int process_input(FILE *in, Process processes[], int choice);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,1477 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   sim_check.c
+/
+/  Program Description:
+/    The regression harness behind "make check". Runs ./sim on every
+/    input under testing/input and testing-stuff/in, compares the
+/    output byte for byte with the stored outputs under testing/output
+/    and testing-stuff/out, and enforces a CPU time and memory budget
+/    on every case. Inputs that have no stored output are still run,
+/    and must succeed within budget. A benchmark case that exercises
+/    the engine far harder than the small inputs is also timed.
+/
+/    Generated cases write a large FCFS workload, with times and totals
+/    well past what a 32-bit int holds, and check the run's JSON report
+/    against the schedule this harness works out on its own.
+/
+/    Reference cases make a second run first and compare the case's
+/    output with it: the streaming simulator's rows with the batch 
+/    simulator's, a single core's rows with the single-CPU 
+/    simulator's, a converted binary workload with its text original,
+/    and an externally sorted workload with one written in order.
+/
+/    The adaptive quantum cases hold the batch simulator's CSV report
+/    to a stored one byte for byte, and the streaming simulator's to
+/    the same report's rows, in any order.
+/
+/    The sweep cases run a small grid on two worker processes, once as
+/    is and once with SCHED_SWEEP_CRASH set, so that a worker dies
+/    part way through its shard. The table must be the same, apart
+/    from the line counting the rerun shard.
+/
+/    Trace cases check that the Chrome trace written with -t is valid
+/    JSON, with as many slices and instant events as expected, and
+/    that RR's time slices are marked as expired, not preempted.
+/
+/    Kernel cases replay a small "perf sched script" trace and a small
+/    ftrace one with -k; the stored output holds the jobs imported
+/    from the trace and the kernel's own schedule of them.
+/
+/    Outputs and generated workloads go to temporary files made with
+/    mkstemp, which are removed when the check ends.
+/
+/    Every input file found on disk must be covered by a case, as its
+/    input or as one of its arguments (a group file, say), so a new
+/    input cannot be skipped by accident.
+/
+/    With a baseline (make check-baseline, run before a change), each
+/    case must also stay within a set percentage of its baseline CPU
+/    time, so an engine change that slows a schedule down fails the
+/    check just as one that changes it does.
+/
+/  Program Details:
+/    Program Input:
+/      - Command-line Arguments:
+/        -t <int>    CPU time budget per case, in milliseconds (1000)
+/        -m <int>    memory budget per case, in KB of peak RSS (65536)
+/        -r <int>    timed runs per case; the fastest counts (5)
+/        -s <int>    allowed slowdown over the baseline, in percent (50)
+/        -b <string> baseline file (testing/perf-baseline.txt)
+/        -u          write the baseline instead of checking against it
+/        -v          print every case, not just failures
+/
+/    Program Output:
+/      - a line per failing case and a summary; exits 1 if any case
+/        failed
+/
+/    Misc:
+/      - times are CPU (user + system) times of the sim process, from
+/        wait4, so they do not include this harness
+/      - the baseline is specific to the machine it was recorded on,
+/        and small cases get 2 ms of slack for timer noise
+/---------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#define SIM_PATH "./sim"
+#define MAX_CASES 256
+#define MAX_ARGS 24
+#define WALL_LIMIT_SECONDS 30
+#define SLACK_US 2000
+#define MAX_ROWS 1024
+
+/* the temporary files every case shares, made by make_temp_files */
+char output_path[] = "/tmp/sim_check_output_XXXXXX";
+char reference_path[] = "/tmp/sim_check_reference_XXXXXX";
+char workload_path[] = "/tmp/sim_check_workload_XXXXXX";
+char shuffled_path[] = "/tmp/sim_check_shuffled_XXXXXX";
+char binary_path[] = "/tmp/sim_check_binary_XXXXXX";
+
+/*---------- STRUCTURE: Generated --------------------------
+/  Structure Description:
+/    A workload the harness writes for a case, and the FCFS schedule
+/    it should give.
+/
+/  Fields:
+/    int count
+/      Number of processes, or 0 if the case reads a stored input
+/    int shuffled
+/      1 to also write the workload to shuffled_path, with its lines
+/      in a random order
+/    long long max_gap, max_burst
+/      The largest gap between arrivals and the largest burst; each
+/      is drawn uniformly from 1 up to it
+/    long long end_time, idle_time
+/      When the last process completes, and the time the CPU is idle
+/    long long waiting_sum, turnaround_sum
+/      The totals of the processes' waiting and turnaround times
+/
+/  Relationships:
+/    - contained in CheckCase, filled in by generate_workload
+/---------------------------------------------------------*/
+typedef struct {
+    int count;
+    int shuffled;
+    long long max_gap;
+    long long max_burst;
+    long long end_time;
+    long long idle_time;
+    long long waiting_sum;
+    long long turnaround_sum;
+} Generated;
+
+/*---------- STRUCTURE: CheckCase --------------------------
+/  Structure Description:
+/    One run of the simulator and what is expected of it.
+/
+/  Fields:
+/    char name[64]
+/      The case's name, as printed and stored in the baseline
+/    char input[256]
+/      The input file, or empty if the case reads none
+/    char expected[256]
+/      The stored output to compare with, or empty to only check
+/      that the run succeeds
+/    char *args[MAX_ARGS]
+/      The arguments to run sim with, ending in NULL
+/    int interactive
+/      1 to feed the input on stdin with no arguments, as in the
+/      interactive menu
+/    long long baseline_us
+/      CPU time recorded in the baseline, or -1 if none
+/    Generated generated
+/      The workload to write to workload_path before the case runs,
+/      whose JSON output is then checked by check_generated
+/    char *setup[MAX_ARGS]
+/      A run to make before the case, such as a conversion, or NULL
+/      at setup[0]
+/    char *reference[MAX_ARGS]
+/      A run whose output, written to reference_path, the case's must
+/      match, or NULL at reference[0]
+/    int rows
+/      1 to compare only the rows of the processes section of a CSV
+/      report, in any order
+/    int slices, instants
+/      With slices above 0, the output is a Chrome trace, which must
+/      be valid JSON with this many complete ("X") and instant ("i")
+/      events
+/    int preempted, expired
+/      Of a trace's instant events, how many must mark preemptions and
+/      how many the ends of RR time slices
+/    char *environment
+/      A NAME=value to add to the run's environment, or NULL
+/
+/  Relationships:
+/    - built by add_case, run by run_case
+/---------------------------------------------------------*/
+typedef struct {
+    char name[64];
+    char input[256];
+    char expected[256];
+    char *args[MAX_ARGS];
+    int interactive;
+    long long baseline_us;
+    Generated generated;
+    char *setup[MAX_ARGS];
+    char *reference[MAX_ARGS];
+    int rows;
+    int slices;
+    int instants;
+    int preempted;
+    int expired;
+    char *environment;
+} CheckCase;
+
+/*---------- STRUCTURE: Measurement ------------------------
+/  Structure Description:
+/    What a single run of the simulator cost and how it ended.
+/
+/  Fields:
+/    long long cpu_us
+/      User plus system CPU time, in microseconds
+/    long max_rss_kb
+/      Peak resident set size, in KB
+/    int status
+/      The wait status
+/
+/  Relationships:
+/    - filled in by measure
+/---------------------------------------------------------*/
+typedef struct {
+    long long cpu_us;
+    long max_rss_kb;
+    int status;
+} Measurement;
+
+int add_case(CheckCase cases[], int num_cases, const char *name, const char *input,
+             const char *expected, const char *algorithm, int quantum);
+int build_cases(CheckCase cases[]);
+int add_generated_case(CheckCase cases[], int num_cases, const char *name, int stream,
+                       int count, long long max_gap, long long max_burst);
+int add_reference_case(CheckCase cases[], int num_cases, const char *name, const char *input,
+                       char *setup[], char *reference[], char *args[]);
+int check_coverage(CheckCase cases[], int num_cases, const char *dir);
+int make_temp_files(void);
+void remove_temp_files(void);
+int measure(CheckCase *check, Measurement *result);
+int run_step(char *args[]);
+int compare_output(const char *expected, const char *actual, char *detail, size_t size);
+int compare_rows(const char *expected, const char *actual, char *detail, size_t size);
+int read_rows(const char *path, char *rows[], int max_rows);
+int compare_row(const void *a, const void *b);
+void load_baseline(const char *path, CheckCase cases[], int num_cases);
+int generate_workload(const char *path, const char *shuffled, Generated *generated);
+int check_generated(const Generated *generated, const char *actual, char *detail, size_t size);
+double json_number(const char *text, const char *name, int *found);
+int check_trace(const CheckCase *check, const char *actual, char *detail, size_t size);
+int json_value(const char **at, int depth);
+void json_space(const char **at);
+
+
+int main(int argc, char **argv) {
+    static CheckCase cases[MAX_CASES];
+    long long time_budget_us = 1000 * 1000LL;
+    long memory_budget_kb = 65536;
+    int repeats = 5;
+    int slowdown_pct = 50;
+    const char *baseline_path = "testing/perf-baseline.txt";
+    int update = 0, verbose = 0;
+    int num_cases, passed = 0, failed = 0;
+    FILE *baseline = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            time_budget_us = atoll(argv[++i]) * 1000;
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            memory_budget_kb = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            repeats = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            slowdown_pct = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "-u") == 0) {
+            update = 1;
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [-t ms] [-m kb] [-r runs] [-s percent] [-b file] [-u] [-v]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (repeats < 1) repeats = 1;
+
+    if (access(SIM_PATH, X_OK) != 0) {
+        fprintf(stderr, "Error: %s not found; build it with make first.\n", SIM_PATH);
+        return 1;
+    }
+
+    if (make_temp_files() != 0) {
+        fprintf(stderr, "Error: could not make the temporary files.\n");
+        return 1;
+    }
+    num_cases = build_cases(cases);
+    failed += check_coverage(cases, num_cases, "testing/input");
+    failed += check_coverage(cases, num_cases, "testing-stuff/in");
+
+    if (update) {
+        baseline = fopen(baseline_path, "w");
+        if (baseline == NULL) {
+            fprintf(stderr, "Error: baseline file did not open.\n");
+            return 1;
+        }
+    } else {
+        load_baseline(baseline_path, cases, num_cases);
+    }
+
+    for (int c = 0; c < num_cases; c++) {
+        CheckCase *check = &cases[c];
+        Measurement run, best;
+        char detail[512] = "";
+        int ok = 1;
+
+        /* the first run is checked for output; the fastest run is timed */
+        if (check->generated.count > 0 &&
+            generate_workload(workload_path, check->generated.shuffled ? shuffled_path : NULL,
+                              &check->generated) != 0) {
+            snprintf(detail, sizeof(detail), "could not write %s", workload_path);
+            ok = 0;
+        } else if (check->setup[0] != NULL && run_step(check->setup) != 0) {
+            snprintf(detail, sizeof(detail), "the setup run failed");
+            ok = 0;
+        } else if (check->reference[0] != NULL && run_step(check->reference) != 0) {
+            snprintf(detail, sizeof(detail), "the reference run failed");
+            ok = 0;
+        } else if (measure(check, &run) != 0) {
+            snprintf(detail, sizeof(detail), "could not run %s", SIM_PATH);
+            ok = 0;
+        } else if (WIFSIGNALED(run.status)) {
+            snprintf(detail, sizeof(detail), "killed by signal %d%s", WTERMSIG(run.status),
+                     WTERMSIG(run.status) == SIGALRM ? " (wall-clock limit)" : "");
+            ok = 0;
+        } else if (WEXITSTATUS(run.status) != 0) {
+            snprintf(detail, sizeof(detail), "exited with status %d", WEXITSTATUS(run.status));
+            ok = 0;
+        } else if (check->expected[0] != '\0' && !check->rows &&
+                   compare_output(check->expected, output_path, detail, sizeof(detail)) != 0) {
+            ok = 0;
+        } else if (check->expected[0] != '\0' && check->rows &&
+                   compare_rows(check->expected, output_path, detail, sizeof(detail)) != 0) {
+            ok = 0;
+        } else if (check->generated.count > 0 &&
+                   check_generated(&check->generated, output_path, detail, sizeof(detail)) != 0) {
+            ok = 0;
+        } else if (check->slices > 0 && check_trace(check, output_path, detail, sizeof(detail)) != 0) {
+            ok = 0;
+        }
+
+        best = run;
+        for (int r = 1; ok && r < repeats; r++) {
+            Measurement again;
+            if (measure(check, &again) == 0 && again.cpu_us < best.cpu_us) {
+                best.cpu_us = again.cpu_us;
+            }
+            if (again.max_rss_kb > best.max_rss_kb) best.max_rss_kb = again.max_rss_kb;
+        }
+
+        if (ok && best.cpu_us > time_budget_us) {
+            snprintf(detail, sizeof(detail), "CPU time %.2f ms is over the budget of %.2f ms",
+                     best.cpu_us / 1000.0, time_budget_us / 1000.0);
+            ok = 0;
+        }
+        if (ok && best.max_rss_kb > memory_budget_kb) {
+            snprintf(detail, sizeof(detail), "peak RSS %ld KB is over the budget of %ld KB",
+                     best.max_rss_kb, memory_budget_kb);
+            ok = 0;
+        }
+        if (ok && !update && check->baseline_us >= 0 &&
+            best.cpu_us > check->baseline_us * (100 + slowdown_pct) / 100 + SLACK_US) {
+            snprintf(detail, sizeof(detail), "CPU time %.2f ms is more than %d%% over the baseline of %.2f ms",
+                     best.cpu_us / 1000.0, slowdown_pct, check->baseline_us / 1000.0);
+            ok = 0;
+        }
+
+        if (ok) {
+            passed++;
+            if (baseline != NULL) fprintf(baseline, "%s %lld\n", check->name, best.cpu_us);
+        } else {
+            failed++;
+        }
+        if (!ok || verbose) {
+            printf("%-4s  %-28s %9.2f ms %8ld KB", ok ? "ok" : "FAIL", check->name,
+                   best.cpu_us / 1000.0, best.max_rss_kb);
+            if (check->baseline_us >= 0 && !update) {
+                printf("  (baseline %.2f ms)", check->baseline_us / 1000.0);
+            }
+            printf("\n");
+            if (!ok) printf("      %s\n", detail);
+        }
+    }
+
+    remove_temp_files();
+    if (baseline != NULL) {
+        fclose(baseline);
+        printf("Baseline written to %s.\n", baseline_path);
+    }
+    printf("%d passed, %d failed\n", passed, failed);
+    return failed > 0;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions build the list of cases.
+/
+/  Functions and Their Purpose:
+/    - add_case: Appends a case that runs sim with -a algorithm on
+/      input (and -q quantum for RR), and returns the new count. An
+/      algorithm of NULL makes an interactive case, and an input of
+/      NULL a case that reads nothing.
+/    - build_cases: Builds every case. The stored outputs were made
+/      with a time quantum of n + 1 for testing/input/cli/n and 5 for
+/      testing-stuff, but for the gang and group cases, which use 2,
+/      the slow core cases, which use 3, the cache cases, which use
+/      4, and the kernel cases, which use 50 microseconds.
+/    - add_generated_case: Appends a case that runs FCFS, batch or
+/      streaming (stream 1), on a generated workload of count
+/      processes, with its report written as JSON.
+/    - add_reference_case: Appends a case that makes the setup run
+/      (if not NULL) and the reference run, then runs args and 
+/      compares its output with the reference's.
+/    - check_coverage: Reports, and counts as failures, any input file
+/      under dir that no case reads.
+/
+/  Input Parameters:
+/    - CheckCase cases[]: the cases
+/    - int num_cases: the number of cases so far
+/    - const char *name, *input, *expected, *algorithm: the new case
+/    - int quantum: the RR time quantum
+/    - int stream, count: see add_generated_case
+/    - long long max_gap, max_burst: see Generated
+/    - char *setup[], *reference[], *args[]: the runs of a reference
+/      case, each ending in NULL
+/    - const char *dir: the directory to scan
+/
+/  Output:
+/    - the number of cases, or of uncovered inputs
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - check_coverage descends into every subdirectory
+/------------------------------------------------------------------------*/
+int add_case(CheckCase cases[], int num_cases, const char *name, const char *input,
+             const char *expected, const char *algorithm, int quantum) {
+    CheckCase *check = &cases[num_cases];
+    int n = 0;
+
+    memset(check, 0, sizeof(CheckCase));
+    snprintf(check->name, sizeof(check->name), "%s", name);
+    snprintf(check->input, sizeof(check->input), "%s", input != NULL ? input : "");
+    snprintf(check->expected, sizeof(check->expected), "%s", expected != NULL ? expected : "");
+    check->interactive = algorithm == NULL && input != NULL;
+    check->baseline_us = -1;
+
+    check->args[n++] = SIM_PATH;
+    if (algorithm != NULL) {
+        check->args[n++] = "-a";
+        check->args[n++] = strdup(algorithm);
+        if (input != NULL) {
+            check->args[n++] = "-i";
+            check->args[n++] = check->input;
+        }
+        if (strcmp(algorithm, "rr") == 0) {
+            char quantum_arg[16];
+            snprintf(quantum_arg, sizeof(quantum_arg), "%d", quantum);
+            check->args[n++] = "-q";
+            check->args[n++] = strdup(quantum_arg);
+        }
+        check->args[n++] = "-o";
+        check->args[n++] = output_path;
+    }
+    check->args[n] = NULL;
+
+    return num_cases + 1;
+}
+
+int build_cases(CheckCase cases[]) {
+    static const char *algorithms[] = {"fcfs", "sjf", "srtf", "rr", "ps", "pps"};
+    char name[64], input[256], expected[256];
+    int n = 0;
+
+    for (int t = 1; t <= 2; t++) {
+        for (int a = 0; a < 6; a++) {
+            int priority = a >= 4;
+            snprintf(name, sizeof(name), "cli/%d/%s", t, algorithms[a]);
+            snprintf(input, sizeof(input), "testing/input/cli/%d/%s.txt", t, priority ? "pri" : "non");
+            snprintf(expected, sizeof(expected), "testing/output/cli/%d/%s-%d.txt", t, algorithms[a], t);
+            n = add_case(cases, n, name, input, expected, algorithms[a], t + 1);
+        }
+    }
+
+    for (int t = 1; t <= 5; t++) {
+        for (int a = 0; a < 6; a++) {
+            int priority = a >= 4;
+            const char *stored = NULL;
+
+            /* testcases 3 and 4 only come with priorities */
+            if ((t == 3 || t == 4) && !priority) continue;
+
+            snprintf(name, sizeof(name), "testcase%d/%s", t, algorithms[a]);
+            snprintf(input, sizeof(input), "testing-stuff/in/%d/testcase%d-%s.txt", t, t, priority ? "p" : "np");
+            if (t == 1) {
+                snprintf(expected, sizeof(expected), "testing-stuff/out/1/%s.txt", algorithms[a]);
+                stored = expected;
+            } else if (t == 2) {
+                snprintf(expected, sizeof(expected), "testing-stuff/out/2/testcase-2-%s.txt", algorithms[a]);
+                stored = expected;
+            }
+            n = add_case(cases, n, name, input, stored, algorithms[a], 5);
+        }
+    }
+
+    n = add_case(cases, n, "menu/fcfs_1", "testing/input/menu/fcfs_1.txt", NULL, NULL, 0);
+    n = add_case(cases, n, "menu/fcfs_2", "testing/input/menu/fcfs_2.txt", NULL, NULL, 0);
+
+    /* the engine benchmark: thousands of runs of every algorithm */
+    n = add_case(cases, n, "bench/ensemble", NULL, NULL, "all", 0);
+    {
+        CheckCase *bench = &cases[n - 1];
+        char *args[] = {SIM_PATH, "-e", "2000", "-a", "all", "-q", "3", "-j", "1", "-o", output_path, NULL};
+        memcpy(bench->args, args, sizeof(args));
+    }
+
+    /* times past 2^31 in a batch run, and totals past it over a long stream */
+    n = add_generated_case(cases, n, "large/batch", 0, 20, 4000000000LL, 5000000000LL);
+    n = add_generated_case(cases, n, "large/stream", 1, 100000, 50000, 50000);
+
+    for (int a = 0; a < 6; a++) {
+        char *algorithm = (char *)algorithms[a];
+        char *input = a >= 4 ? "testing-stuff/in/1/testcase1-p.txt" : "testing-stuff/in/1/testcase1-np.txt";
+
+        /* the JSON and CSV reports, with the event list */
+        for (int f = 0; f < 2; f++) {
+            char *format = f == 0 ? "json" : "csv";
+            char *args[] = {SIM_PATH, "-a", algorithm, "-q", "5", "-i", input, "--format", format,
+                            "--events", "-o", output_path, NULL};
+
+            snprintf(name, sizeof(name), "report/testcase1/%s-%s", algorithm, format);
+            snprintf(expected, sizeof(expected), "testing-stuff/out/1/%s.%s", algorithm, format);
+            n = add_case(cases, n, name, input, expected, algorithm, 5);
+            memcpy(cases[n - 1].args, args, sizeof(args));
+        }
+
+        /* the streaming simulator must give the batch simulator's rows */
+        {
+            char *reference[] = {SIM_PATH, "-a", algorithm, "-q", "5", "-i", input, "--format", "csv",
+                                 "-o", reference_path, NULL};
+            char *args[] = {SIM_PATH, "-a", algorithm, "-q", "5", "-i", input, "--format", "csv",
+                            "-s", "-o", output_path, NULL};
+
+            snprintf(name, sizeof(name), "stream/testcase1/%s", algorithm);
+            n = add_reference_case(cases, n, name, input, NULL, reference, args);
+            cases[n - 1].rows = 1;
+        }
+
+        /* a workload converted to binary must stream as its text does */
+        {
+            char *setup[] = {SIM_PATH, "--convert", binary_path, "-i", input, NULL};
+            char *reference[] = {SIM_PATH, "-a", algorithm, "-q", "5", "-i", input, "-s",
+                                 "-o", reference_path, NULL};
+            char *args[] = {SIM_PATH, "-a", algorithm, "-q", "5", "-i", binary_path, "-s",
+                            "-o", output_path, NULL};
+
+            snprintf(name, sizeof(name), "convert/testcase1/%s", algorithm);
+            n = add_reference_case(cases, n, name, input, setup, reference, args);
+        }
+
+        /* one core must give the rows of the single-CPU simulator */
+        {
+            char *reference[] = {SIM_PATH, "-a", algorithm, "-q", "5", "-i", input, "--format", "csv",
+                                 "-s", "-o", reference_path, NULL};
+            char *args[] = {SIM_PATH, "-a", algorithm, "-q", "5", "-i", input, "--format", "csv",
+                            "-s", "--cores", "1", "-o", output_path, NULL};
+
+            snprintf(name, sizeof(name), "cores/testcase1/%s", algorithm);
+            n = add_reference_case(cases, n, name, input, NULL, reference, args);
+            cases[n - 1].rows = 1;
+        }
+    }
+
+    /* a fast core and two slow ones, with the processes moving between them */
+    for (int p = 0; p < 3; p++) {
+        static const char *placements[] = {"fastest", "energy", "big"};
+        static const char *preemptive[] = {"srtf", "rr"};
+
+        for (int a = 0; a < 2; a++) {
+            char *algorithm = (char *)preemptive[a];
+            char *input = "testing-stuff/in/2/testcase2-np.txt";
+            char *args[] = {SIM_PATH, "-a", algorithm, "-q", "5", "-i", input, "-s", "--cores", "1x2,2x1",
+                            "--placement", (char *)placements[p], "-o", output_path, NULL};
+
+            snprintf(name, sizeof(name), "cores/testcase2/%s-%s", placements[p], algorithm);
+            snprintf(expected, sizeof(expected), "testing-stuff/out/2/cores-%s-%s.txt", placements[p], algorithm);
+            n = add_case(cases, n, name, input, expected, algorithm, 5);
+            memcpy(cases[n - 1].args, args, sizeof(args));
+        }
+    }
+
+    /* RR time slices of 1.5 units of work on a half-speed core, alone and taking turns */
+    for (int f = 0; f < 2; f++) {
+        char *input = f == 0 ? "testing-stuff/in/cores/one.txt" : "testing-stuff/in/cores/two.txt";
+        char *args[] = {SIM_PATH, "-a", "rr", "-q", "3", "-i", input, "-s", "--cores", "1x0.5",
+                        "-o", output_path, NULL};
+
+        n = add_case(cases, n, f == 0 ? "cores/slow/one-rr" : "cores/slow/two-rr", input,
+                     f == 0 ? "testing-stuff/out/cores/one-rr.txt" : "testing-stuff/out/cores/two-rr.txt", "rr", 3);
+        memcpy(cases[n - 1].args, args, sizeof(args));
+    }
+
+    /* each adaptive quantum, whose stored rows the streaming simulator must also give */
+    for (int t = 0; t < 3; t++) {
+        static const char *testcases[] = {"1", "2", "5"};
+        static const char *modes[] = {"median", "mean", "latency"};
+
+        for (int m = 0; m < 3; m++) {
+            for (int stream = 0; stream < 2; stream++) {
+                char input[256];
+                char *args[] = {SIM_PATH, "-a", "rr", "-q", "5", "--quantum", (char *)modes[m], "-i", NULL,
+                                "--format", "csv", "-o", output_path, stream ? "-s" : NULL, NULL};
+
+                snprintf(input, sizeof(input), "testing-stuff/in/%s/testcase%s-np.txt", testcases[t], testcases[t]);
+                snprintf(name, sizeof(name), "quantum/testcase%s/%s-%s", testcases[t], modes[m],
+                         stream ? "stream" : "batch");
+                snprintf(expected, sizeof(expected), "testing-stuff/out/%s/quantum-%s-rr.csv", testcases[t], modes[m]);
+                n = add_case(cases, n, name, input, expected, "rr", 5);
+                args[8] = cases[n - 1].input;
+                memcpy(cases[n - 1].args, args, sizeof(args));
+                cases[n - 1].rows = stream;
+            }
+        }
+    }
+
+    /* each decision cost model, priced high enough that the models' schedules differ */
+    for (int m = 0; m < 4; m++) {
+        static const char *models[] = {"list", "heap", "tree", "bitmap"};
+        static const char *costs[] = {"list,0.5,0.25", "heap,0.5,0.25", "tree,0.5,0.25", "bitmap,0.5,0.25"};
+        char *input = "testing-stuff/in/2/testcase2-np.txt";
+        char *args[] = {SIM_PATH, "-a", "rr", "-q", "5", "-i", input, "-s", "--decision-cost", (char *)costs[m],
+                        "-o", output_path, NULL};
+
+        snprintf(name, sizeof(name), "cost/testcase2/%s-rr", models[m]);
+        snprintf(expected, sizeof(expected), "testing-stuff/out/2/cost-%s-rr.txt", models[m]);
+        n = add_case(cases, n, name, input, expected, "rr", 5);
+        memcpy(cases[n - 1].args, args, sizeof(args));
+    }
+
+    /* cache refills, with working sets of the lines' own and the model's */
+    for (int a = 0; a < 2; a++) {
+        char *algorithm = a == 0 ? "rr" : "srtf";
+        char *input = "testing-stuff/in/cache/jobs.txt";
+        char *args[] = {SIM_PATH, "-a", algorithm, "-q", "4", "-i", input, "-s", "--cache-penalty", "3,10",
+                        "-o", output_path, NULL};
+
+        snprintf(name, sizeof(name), "cache/%s", algorithm);
+        snprintf(expected, sizeof(expected), "testing-stuff/out/cache/%s.txt", algorithm);
+        n = add_case(cases, n, name, input, expected, algorithm, 4);
+        memcpy(cases[n - 1].args, args, sizeof(args));
+    }
+
+    /* processes of one to four threads on four cores, under each gang mode */
+    for (int g = 0; g < 3; g++) {
+        static const char *modes[] = {"strict", "backfill", "relaxed"};
+        static const char *gang_algorithms[] = {"fcfs", "srtf", "rr"};
+
+        for (int a = 0; a < 3; a++) {
+            char *algorithm = (char *)gang_algorithms[a];
+            char *input = "testing-stuff/in/gang/threads.txt";
+            char *args[] = {SIM_PATH, "-a", algorithm, "-q", "2", "-i", input, "-s", "--cores", "4",
+                            "--gang", (char *)modes[g], "-o", output_path, NULL};
+
+            snprintf(name, sizeof(name), "gang/%s-%s", modes[g], algorithm);
+            snprintf(expected, sizeof(expected), "testing-stuff/out/gang/%s-%s.txt", modes[g], algorithm);
+            n = add_case(cases, n, name, input, expected, algorithm, 2);
+            memcpy(cases[n - 1].args, args, sizeof(args));
+        }
+    }
+
+    /* processes in a tree of groups with shares, two of which are throttled by their quotas */
+    for (int a = 0; a < 3; a++) {
+        static const char *group_algorithms[] = {"fcfs", "srtf", "rr"};
+        char *algorithm = (char *)group_algorithms[a];
+        char *input = "testing-stuff/in/groups/jobs.txt";
+        char *args[] = {SIM_PATH, "-a", algorithm, "-q", "2", "-i", input, "-s",
+                        "--groups", "testing-stuff/in/groups/tree.txt", "-o", output_path, NULL};
+
+        snprintf(name, sizeof(name), "groups/%s", algorithm);
+        snprintf(expected, sizeof(expected), "testing-stuff/out/groups/%s.txt", algorithm);
+        n = add_case(cases, n, name, input, expected, algorithm, 2);
+        memcpy(cases[n - 1].args, args, sizeof(args));
+    }
+
+    /* the windowed series, which the batch and streaming simulators must both give */
+    for (int stream = 0; stream < 2; stream++) {
+        char *input = "testing-stuff/in/2/testcase2-np.txt";
+        char *args[] = {SIM_PATH, "-a", "rr", "-q", "5", "-i", input, "-w", "50", "-W", output_path,
+                        "-o", "/dev/null", stream ? "-s" : NULL, NULL};
+
+        n = add_case(cases, n, stream ? "series/testcase2/stream" : "series/testcase2/batch", input,
+                     "testing-stuff/out/2/series-rr.csv", "rr", 5);
+        memcpy(cases[n - 1].args, args, sizeof(args));
+    }
+
+    /* a sweep on two worker processes, and the same sweep with one worker killed part way */
+    for (int crash = 0; crash < 2; crash++) {
+        char *args[] = {SIM_PATH, "--sweep", "-e", "6", "-a", "fcfs,rr", "-Q", "2,4", "-L", "3,5",
+                        "-P", "2", "-g", "30,4,5", "-o", output_path, NULL};
+
+        n = add_case(cases, n, crash ? "sweep/crash" : "sweep/grid", NULL,
+                     crash ? "testing-stuff/out/sweep/crash.txt" : "testing-stuff/out/sweep/sweep.txt", "fcfs", 0);
+        memcpy(cases[n - 1].args, args, sizeof(args));
+        if (crash) cases[n - 1].environment = "SCHED_SWEEP_CRASH=1";
+    }
+
+    /* jobs imported from each form of kernel trace, against the kernel's own schedule */
+    for (int k = 0; k < 2; k++) {
+        char *algorithm = k == 0 ? "fcfs" : "rr";
+        char *input = k == 0 ? "testing-stuff/in/kernel/perf.txt" : "testing-stuff/in/kernel/ftrace.txt";
+        char *args[] = {SIM_PATH, "-a", algorithm, "-q", "50", "-s", "-k", input, "-o", output_path, NULL};
+
+        n = add_case(cases, n, k == 0 ? "kernel/perf" : "kernel/ftrace", input,
+                     k == 0 ? "testing-stuff/out/kernel/perf-fcfs.txt" : "testing-stuff/out/kernel/ftrace-rr.txt",
+                     algorithm, 50);
+        memcpy(cases[n - 1].args, args, sizeof(args));
+    }
+
+    /* the Chrome trace of a run with many time slices, and of one with few, from both simulators */
+    for (int a = 0; a < 4; a++) {
+        char *algorithm = a % 2 == 0 ? "rr" : "srtf";
+        char *input = "testing-stuff/in/2/testcase2-np.txt";
+        char *args[] = {SIM_PATH, "-a", algorithm, "-q", "5", "-i", input, "-t", output_path,
+                        "-o", "/dev/null", a >= 2 ? "-s" : NULL, NULL};
+
+        snprintf(name, sizeof(name), "trace/testcase2/%s%s", algorithm, a >= 2 ? "-stream" : "");
+        n = add_case(cases, n, name, input, NULL, algorithm, 5);
+        memcpy(cases[n - 1].args, args, sizeof(args));
+        cases[n - 1].slices = a % 2 == 0 ? 438 : 44;
+        cases[n - 1].instants = a % 2 == 0 ? 219 : 22;
+        cases[n - 1].preempted = a % 2 == 0 ? 0 : 2;
+        cases[n - 1].expired = a % 2 == 0 ? 199 : 0;
+    }
+
+    /* a shuffled workload sorted in 1 MB runs must stream as it does in order */
+    n = add_generated_case(cases, n, "sort/external", 1, 100000, 50000, 50000);
+    {
+        CheckCase *sort = &cases[n - 1];
+        char *reference[] = {SIM_PATH, "-a", "fcfs", "-i", workload_path, "-s", "--format", "json",
+                             "-o", reference_path, NULL};
+        char *args[] = {SIM_PATH, "-a", "fcfs", "-i", shuffled_path, "-s", "--sort", "--sort-memory", "1",
+                        "--format", "json", "-o", output_path, NULL};
+
+        memcpy(sort->reference, reference, sizeof(reference));
+        memcpy(sort->args, args, sizeof(args));
+        snprintf(sort->expected, sizeof(sort->expected), "%s", reference_path);
+        sort->generated.shuffled = 1;
+    }
+
+    return n;
+}
+
+int add_generated_case(CheckCase cases[], int num_cases, const char *name, int stream,
+                       int count, long long max_gap, long long max_burst) {
+    CheckCase *check = &cases[num_cases];
+    char *args[] = {SIM_PATH, "-a", "fcfs", "-i", workload_path, "--format", "json",
+                    "-o", output_path, stream ? "-s" : NULL, NULL};
+
+    num_cases = add_case(cases, num_cases, name, NULL, NULL, "fcfs", 0);
+    memcpy(check->args, args, sizeof(args));
+    snprintf(check->input, sizeof(check->input), "%s", workload_path);
+    check->generated.count = count;
+    check->generated.max_gap = max_gap;
+    check->generated.max_burst = max_burst;
+    return num_cases;
+}
+
+int add_reference_case(CheckCase cases[], int num_cases, const char *name, const char *input,
+                       char *setup[], char *reference[], char *args[]) {
+    CheckCase *check = &cases[num_cases];
+
+    num_cases = add_case(cases, num_cases, name, input, reference_path, "fcfs", 0);
+    for (int i = 0; setup != NULL && setup[i] != NULL && i < MAX_ARGS - 1; i++) {
+        check->setup[i] = setup[i];
+    }
+    for (int i = 0; reference[i] != NULL && i < MAX_ARGS - 1; i++) {
+        check->reference[i] = reference[i];
+    }
+    memset(check->args, 0, sizeof(check->args));
+    for (int i = 0; args[i] != NULL && i < MAX_ARGS - 1; i++) {
+        check->args[i] = args[i];
+    }
+    return num_cases;
+}
+
+int check_coverage(CheckCase cases[], int num_cases, const char *dir) {
+    DIR *listing = opendir(dir);
+    struct dirent *entry;
+    int missing = 0;
+
+    if (listing == NULL) return 0;
+    while ((entry = readdir(listing)) != NULL) {
+        char path[512];
+        DIR *sub;
+        int covered = 0;
+
+        if (entry->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+
+        sub = opendir(path);
+        if (sub != NULL) {
+            closedir(sub);
+            missing += check_coverage(cases, num_cases, path);
+            continue;
+        }
+
+        for (int c = 0; c < num_cases && !covered; c++) {
+            if (strcmp(cases[c].input, path) == 0) covered = 1;
+            for (int i = 0; i < MAX_ARGS && cases[c].args[i] != NULL && !covered; i++) {
+                if (strcmp(cases[c].args[i], path) == 0) covered = 1;
+            }
+        }
+        if (!covered) {
+            printf("FAIL  %s is not covered by any case\n", path);
+            missing++;
+        }
+    }
+    closedir(listing);
+    return missing;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions manage the temporary files the cases share.
+/
+/  Functions and Their Purpose:
+/    - make_temp_files: Makes each temporary file with mkstemp, which 
+/      fills in the end of its pathway, so that checks run at the 
+/      same time do not overwrite each other's files.
+/    - remove_temp_files: Removes every temporary file that was made.
+/
+/  Input Parameters:
+/    N/A
+/
+/  Output:
+/    - make_temp_files returns 0 on success, or 1 after removing the
+/      files it did make
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+int make_temp_files(void) {
+    char *paths[] = {output_path, reference_path, workload_path, shuffled_path, binary_path};
+
+    for (size_t p = 0; p < sizeof(paths) / sizeof(paths[0]); p++) {
+        int fd = mkstemp(paths[p]);
+
+        if (fd < 0) {
+            remove_temp_files();
+            return 1;
+        }
+        close(fd);
+    }
+    return 0;
+}
+
+void remove_temp_files(void) {
+    char *paths[] = {output_path, reference_path, workload_path, shuffled_path, binary_path};
+
+    for (size_t p = 0; p < sizeof(paths) / sizeof(paths[0]); p++) {
+        /* a pathway mkstemp did not fill in still ends in its template */
+        if (strstr(paths[p], "XXXXXX") == NULL) unlink(paths[p]);
+    }
+}
+
+/*---------- FUNCTION: measure -----------------------------
+/  Function Description:
+/    Runs one case, with its output going to output_path, and
+/    records its CPU time, peak memory and exit status.
+/
+/  Caller Input:
+/    CheckCase *check: the case to run
+/    Measurement *result: filled in with the run's costs
+/
+/  Caller Output:
+/    0 if the run took place, 1 if it could not be started
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - a run is killed by SIGALRM after WALL_LIMIT_SECONDS, so a
+/      schedule that never finishes fails instead of hanging the check
+/---------------------------------------------------------*/
+int measure(CheckCase *check, Measurement *result) {
+    struct rusage usage;
+    pid_t pid = fork();
+
+    if (pid < 0) return 1;
+    if (pid == 0) {
+        int in = open(check->interactive ? check->input : "/dev/null", O_RDONLY);
+        int null = open("/dev/null", O_WRONLY);
+
+        if (in >= 0) dup2(in, STDIN_FILENO);
+        if (check->interactive) {
+            int out = open(output_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (out >= 0) dup2(out, STDOUT_FILENO);
+        } else if (null >= 0) {
+            dup2(null, STDOUT_FILENO);
+        }
+        if (null >= 0) dup2(null, STDERR_FILENO);
+        if (check->environment != NULL) putenv(check->environment);
+
+        alarm(WALL_LIMIT_SECONDS);
+        execv(SIM_PATH, check->args);
+        _exit(127);
+    }
+
+    if (wait4(pid, &result->status, 0, &usage) < 0) return 1;
+    result->cpu_us = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000LL +
+                     usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    result->max_rss_kb = usage.ru_maxrss;
+    return 0;
+}
+
+/*---------- FUNCTION: run_step ----------------------------
+/  Function Description:
+/    Makes the setup or reference run of a case, untimed.
+/
+/  Caller Input:
+/    char *args[]: the arguments to run sim with, ending in NULL
+/
+/  Caller Output:
+/    0 if the run succeeded, 1 otherwise
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the run's own output is discarded; anything it is checked on
+/      must be written with -o or --convert
+/---------------------------------------------------------*/
+int run_step(char *args[]) {
+    int status;
+    pid_t pid = fork();
+
+    if (pid < 0) return 1;
+    if (pid == 0) {
+        int null = open("/dev/null", O_RDWR);
+
+        if (null >= 0) {
+            dup2(null, STDIN_FILENO);
+            dup2(null, STDOUT_FILENO);
+            dup2(null, STDERR_FILENO);
+        }
+        alarm(WALL_LIMIT_SECONDS);
+        execv(SIM_PATH, args);
+        _exit(127);
+    }
+
+    if (waitpid(pid, &status, 0) < 0) return 1;
+    return !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+}
+
+/*---------- FUNCTION: compare_output ----------------------
+/  Function Description:
+/    Compares the output of a run with its stored output, byte for
+/    byte, and describes the first line that differs.
+/
+/  Caller Input:
+/    const char *expected: the stored output
+/    const char *actual: the run's output
+/    char *detail: where to describe the difference
+/    size_t size: size of detail
+/
+/  Caller Output:
+/    0 if the files are identical, 1 otherwise
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the lines are cut to fit detail
+/---------------------------------------------------------*/
+int compare_output(const char *expected, const char *actual, char *detail, size_t size) {
+    FILE *want = fopen(expected, "r");
+    FILE *got = fopen(actual, "r");
+    char want_line[256], got_line[256];
+    int line = 0;
+    int differ = 0;
+
+    if (want == NULL || got == NULL) {
+        snprintf(detail, size, "could not open %s", want == NULL ? expected : actual);
+        if (want != NULL) fclose(want);
+        if (got != NULL) fclose(got);
+        return 1;
+    }
+
+    while (!differ) {
+        char *w = fgets(want_line, sizeof(want_line), want);
+        char *g = fgets(got_line, sizeof(got_line), got);
+
+        line++;
+        if (w == NULL && g == NULL) break;
+        if (w == NULL || g == NULL || strcmp(want_line, got_line) != 0) {
+            if (w == NULL) strcpy(want_line, "<end of file>\n");
+            if (g == NULL) strcpy(got_line, "<end of file>\n");
+            want_line[strcspn(want_line, "\n")] = '\0';
+            got_line[strcspn(got_line, "\n")] = '\0';
+            snprintf(detail, size, "output differs from %s at line %d\n        expected: %.100s\n        got:      %.100s",
+                     expected, line, want_line, got_line);
+            differ = 1;
+        }
+    }
+
+    fclose(want);
+    fclose(got);
+    return differ;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions compare the processes section of two CSV 
+/    reports, whose rows may come in a different order: the batch 
+/    simulator writes them in input order, the streaming simulator as
+/    the processes complete.
+/
+/  Functions and Their Purpose:
+/    - compare_rows: Compares the rows of both reports, sorted, and
+/      describes the first that differs.
+/    - read_rows: Reads the rows of the processes section of path,
+/      after its header and up to the first blank line, and returns 
+/      how many there were, or -1 if the file could not be read or 
+/      has more than max_rows.
+/    - compare_row: Orders two rows for qsort.
+/
+/  Input Parameters:
+/    - const char *expected, *actual: the reports
+/    - char *detail: where to describe the difference
+/    - size_t size: size of detail
+/    - const char *path: the report to read
+/    - char *rows[]: where to store the rows, which the caller frees
+/    - int max_rows: room in rows
+/    - const void *a, *b: pointers to the rows
+/
+/  Output:
+/    - compare_rows returns 0 if the rows are the same, 1 otherwise
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the summary is not compared, as the streaming simulator's has
+/      a column of its own
+/    - rows are cut at 255 characters
+/------------------------------------------------------------------------*/
+int compare_rows(const char *expected, const char *actual, char *detail, size_t size) {
+    static char *want[MAX_ROWS], *got[MAX_ROWS];
+    int num_want = read_rows(expected, want, MAX_ROWS);
+    int num_got = read_rows(actual, got, MAX_ROWS);
+    int differ = 0;
+
+    if (num_want < 0 || num_got < 0) {
+        snprintf(detail, size, "could not read the rows of %s", num_want < 0 ? expected : actual);
+        differ = 1;
+    } else if (num_want != num_got) {
+        snprintf(detail, size, "%d rows, but %s has %d", num_got, expected, num_want);
+        differ = 1;
+    } else {
+        qsort(want, num_want, sizeof(char *), compare_row);
+        qsort(got, num_got, sizeof(char *), compare_row);
+        for (int r = 0; r < num_want && !differ; r++) {
+            if (strcmp(want[r], got[r]) != 0) {
+                snprintf(detail, size, "rows differ from %s\n        expected: %.100s\n        got:      %.100s",
+                         expected, want[r], got[r]);
+                differ = 1;
+            }
+        }
+    }
+
+    for (int r = 0; r < num_want; r++) free(want[r]);
+    for (int r = 0; r < num_got; r++) free(got[r]);
+    return differ;
+}
+
+int read_rows(const char *path, char *rows[], int max_rows) {
+    FILE *fp = fopen(path, "r");
+    char line[256];
+    int count = 0;
+
+    if (fp == NULL) return -1;
+    if (fgets(line, sizeof(line), fp) == NULL) {
+        fclose(fp);
+        return 0;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL && line[0] != '\n') {
+        if (count == max_rows) {
+            while (count > 0) free(rows[--count]);
+            fclose(fp);
+            return -1;
+        }
+        line[strcspn(line, "\n")] = '\0';
+        rows[count++] = strdup(line);
+    }
+    fclose(fp);
+    return count;
+}
+
+int compare_row(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/*---------- FUNCTION: load_baseline -----------------------
+/  Function Description:
+/    Reads the CPU time of each case from a baseline file written by
+/    an earlier "make check-baseline".
+/
+/  Caller Input:
+/    const char *path: the baseline file
+/    CheckCase cases[]: the cases to fill in
+/    int num_cases: the number of cases
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - a missing file means no baseline; cases missing from it have
+/      none
+/---------------------------------------------------------*/
+void load_baseline(const char *path, CheckCase cases[], int num_cases) {
+    FILE *fp = fopen(path, "r");
+    char name[64];
+    long long cpu_us;
+
+    if (fp == NULL) {
+        printf("No baseline at %s; run \"make check-baseline\" first to check for slowdowns.\n", path);
+        return;
+    }
+    while (fscanf(fp, "%63s %lld", name, &cpu_us) == 2) {
+        for (int c = 0; c < num_cases; c++) {
+            if (strcmp(cases[c].name, name) == 0) cases[c].baseline_us = cpu_us;
+        }
+    }
+    fclose(fp);
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions run the generated cases.
+/
+/  Functions and Their Purpose:
+/    - generate_workload: Writes count processes to path, arriving in
+/      order from time 0, and works out their FCFS schedule as it
+/      goes. The same workload is written every time. If shuffled is
+/      not NULL, the same lines are also written there, shuffled.
+/    - check_generated: Checks the JSON report of a run on the
+/      workload: its end and idle times, its mean waiting, turnaround
+/      and response times, and the totals of its processes' waiting
+/      and turnaround times.
+/    - json_number: The number after the first "name": in text.
+/
+/  Input Parameters:
+/    - const char *path: the workload file
+/    - const char *shuffled: the file for the shuffled copy, or NULL
+/    - Generated *generated: the workload, its schedule filled in
+/    - const char *actual: the run's output
+/    - char *detail: where to describe the first mismatch
+/    - size_t size: size of detail
+/    - const char *text, *name: the JSON and the field to find
+/    - int *found: cleared if the field is missing
+/
+/  Output:
+/    - 0 on success, 1 if the file could not be written or the report
+/      does not match; json_number gives the number
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the means are printed with six decimals, so they are compared
+/      to within one part in 10^9
+/------------------------------------------------------------------------*/
+int generate_workload(const char *path, const char *shuffled, Generated *generated) {
+    FILE *fp = fopen(path, "w");
+    unsigned long long state = 0x2545f4914f6cdd1dULL;
+    long long arrival = 0, clock = 0;
+    long long *times = NULL;
+    int status;
+
+    if (fp == NULL) return 1;
+    if (shuffled != NULL) {
+        times = malloc(3 * (size_t)generated->count * sizeof(long long));
+        if (times == NULL) {
+            fclose(fp);
+            return 1;
+        }
+    }
+    generated->idle_time = 0;
+    generated->waiting_sum = 0;
+    generated->turnaround_sum = 0;
+
+    for (int i = 0; i < generated->count; i++) {
+        long long burst;
+
+        /* xorshift64 keeps the workload the same on every machine */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        if (i > 0) arrival += 1 + (long long)(state % (unsigned long long)generated->max_gap);
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        burst = 1 + (long long)(state % (unsigned long long)generated->max_burst);
+        fprintf(fp, "%d %lld %lld\n", i + 1, arrival, burst);
+        if (times != NULL) {
+            times[3 * i] = i + 1;
+            times[3 * i + 1] = arrival;
+            times[3 * i + 2] = burst;
+        }
+
+        if (clock < arrival) {
+            generated->idle_time += arrival - clock;
+            clock = arrival;
+        }
+        generated->waiting_sum += clock - arrival;
+        clock += burst;
+        generated->turnaround_sum += clock - arrival;
+    }
+    generated->end_time = clock;
+    status = fclose(fp) != 0;
+
+    if (times != NULL && status == 0) {
+        /* each arrival is later than the last, so sorting restores the order */
+        fp = fopen(shuffled, "w");
+        status = fp == NULL;
+        for (int i = generated->count - 1; i >= 0 && fp != NULL; i--) {
+            /* swap a random one of the first i + 1 lines into slot i, and write it */
+            int j;
+
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            j = (int)(state % (unsigned long long)(i + 1));
+            for (int k = 0; k < 3; k++) {
+                long long value = times[3 * j + k];
+                times[3 * j + k] = times[3 * i + k];
+                times[3 * i + k] = value;
+            }
+            fprintf(fp, "%lld %lld %lld\n", times[3 * i], times[3 * i + 1], times[3 * i + 2]);
+        }
+        if (fp != NULL && fclose(fp) != 0) status = 1;
+    }
+    free(times);
+    return status;
+}
+
+int check_generated(const Generated *generated, const char *actual, char *detail, size_t size) {
+    FILE *fp = fopen(actual, "r");
+    char *text;
+    const char *row;
+    long length;
+    long long waiting_sum = 0, turnaround_sum = 0;
+    int found = 1;
+    int mismatch = 0;
+    struct {
+        const char *name;
+        double expected;
+    } fields[] = {
+        {"end_time", (double)generated->end_time},
+        {"idle_time", (double)generated->idle_time},
+        {"waiting_mean", (double)generated->waiting_sum / generated->count},
+        {"turnaround_mean", (double)generated->turnaround_sum / generated->count},
+        {"response_mean", (double)generated->waiting_sum / generated->count},
+    };
+
+    if (fp == NULL) {
+        snprintf(detail, size, "could not open %s", actual);
+        return 1;
+    }
+    fseek(fp, 0, SEEK_END);
+    length = ftell(fp);
+    rewind(fp);
+    text = malloc(length + 1);
+    if (text == NULL || fread(text, 1, length, fp) != (size_t)length) {
+        snprintf(detail, size, "could not read %s", actual);
+        free(text);
+        fclose(fp);
+        return 1;
+    }
+    text[length] = '\0';
+    fclose(fp);
+
+    for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]) && !mismatch; f++) {
+        double value = json_number(text, fields[f].name, &found);
+        double error = value - fields[f].expected;
+        double bound = fields[f].expected * 1e-9 + 1e-6;
+
+        if (!found || error > bound || error < -bound) {
+            snprintf(detail, size, "%s is %.6f, but should be %.6f", fields[f].name, value, fields[f].expected);
+            mismatch = 1;
+        }
+    }
+
+    for (row = strstr(text, "\"turnaround\":"); row != NULL && !mismatch;
+         row = strstr(row + 1, "\"turnaround\":")) {
+        turnaround_sum += (long long)json_number(row, "turnaround", &found);
+        waiting_sum += (long long)json_number(row, "waiting", &found);
+    }
+    if (!mismatch && (waiting_sum != generated->waiting_sum || turnaround_sum != generated->turnaround_sum)) {
+        snprintf(detail, size, "the processes wait %lld and turn around in %lld in total, but should in %lld and %lld",
+                 waiting_sum, turnaround_sum, generated->waiting_sum, generated->turnaround_sum);
+        mismatch = 1;
+    }
+
+    free(text);
+    return mismatch;
+}
+
+double json_number(const char *text, const char *name, int *found) {
+    char key[64];
+    const char *at;
+
+    snprintf(key, sizeof(key), "\"%s\":", name);
+    at = strstr(text, key);
+    if (at == NULL) {
+        *found = 0;
+        return 0;
+    }
+    return strtod(at + strlen(key), NULL);
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions check the Chrome trace a run wrote with -t.
+/
+/  Functions and Their Purpose:
+/    - check_trace: Checks that the trace is one valid JSON value, and
+/      counts its complete and instant events, and its preemptions and
+/      expired time slices.
+/    - json_value: Reads the JSON value at *at, and anything nested in
+/      it, leaving *at after it.
+/    - json_space: Skips the whitespace at *at.
+/
+/  Input Parameters:
+/    - const CheckCase *check: the case, with the counts expected
+/    - const char *actual: the run's trace
+/    - char *detail: where to describe the first mismatch
+/    - size_t size: size of detail
+/    - const char **at: where to read from, moved past what is read
+/    - int depth: how deeply the value is nested
+/
+/  Output:
+/    - check_trace returns 0 if the trace matches, 1 otherwise;
+/      json_value returns 0 if the value is valid, 1 otherwise
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - events are counted by their "ph" field as the exporter writes
+/      it, with no space after the colon
+/    - values nested more than 64 deep are taken as invalid
+/------------------------------------------------------------------------*/
+int check_trace(const CheckCase *check, const char *actual, char *detail, size_t size) {
+    FILE *fp = fopen(actual, "r");
+    char *text;
+    const char *at;
+    long length;
+    int slices = 0, instants = 0, preempted = 0, expired = 0;
+    int mismatch = 0;
+
+    if (fp == NULL) {
+        snprintf(detail, size, "could not open %s", actual);
+        return 1;
+    }
+    fseek(fp, 0, SEEK_END);
+    length = ftell(fp);
+    rewind(fp);
+    text = malloc(length + 1);
+    if (text == NULL || fread(text, 1, length, fp) != (size_t)length) {
+        snprintf(detail, size, "could not read %s", actual);
+        free(text);
+        fclose(fp);
+        return 1;
+    }
+    text[length] = '\0';
+    fclose(fp);
+
+    at = text;
+    if (json_value(&at, 0) != 0 || (json_space(&at), *at != '\0')) {
+        snprintf(detail, size, "the trace is not valid JSON, at byte %ld", (long)(at - text));
+        mismatch = 1;
+    }
+    for (at = strstr(text, "\"ph\":\""); at != NULL && !mismatch; at = strstr(at + 1, "\"ph\":\"")) {
+        char phase = at[6];
+
+        if (phase == 'X') slices++;
+        if (phase == 'i') instants++;
+    }
+    for (at = strstr(text, "\"name\":\"Preempted\""); at != NULL; at = strstr(at + 1, "\"name\":\"Preempted\"")) {
+        preempted++;
+    }
+    for (at = strstr(text, "\"name\":\"Expired\""); at != NULL; at = strstr(at + 1, "\"name\":\"Expired\"")) {
+        expired++;
+    }
+    if (!mismatch && (slices != check->slices || instants != check->instants)) {
+        snprintf(detail, size, "the trace has %d slices and %d instants, but should have %d and %d",
+                 slices, instants, check->slices, check->instants);
+        mismatch = 1;
+    }
+    if (!mismatch && (preempted != check->preempted || expired != check->expired)) {
+        snprintf(detail, size, "the trace has %d preemptions and %d expired slices, but should have %d and %d",
+                 preempted, expired, check->preempted, check->expired);
+        mismatch = 1;
+    }
+
+    free(text);
+    return mismatch;
+}
+
+int json_value(const char **at, int depth) {
+    const char *p;
+
+    json_space(at);
+    p = *at;
+    if (depth > 64) return 1;
+
+    if (*p == '{' || *p == '[') {
+        char close = *p == '{' ? '}' : ']';
+        int first = 1;
+
+        (*at)++;
+        json_space(at);
+        while (**at != close) {
+            if (!first) {
+                if (**at != ',') return 1;
+                (*at)++;
+            }
+            if (close == '}') {
+                json_space(at);
+                if (**at != '"' || json_value(at, depth + 1) != 0) return 1;
+                json_space(at);
+                if (**at != ':') return 1;
+                (*at)++;
+            }
+            if (json_value(at, depth + 1) != 0) return 1;
+            json_space(at);
+            first = 0;
+        }
+        (*at)++;
+        return 0;
+    }
+
+    if (*p == '"') {
+        for (p++; *p != '"'; p++) {
+            if (*p == '\0' || (unsigned char)*p < 0x20) return 1;
+            if (*p == '\\') {
+                p++;
+                if (*p == 'u') {
+                    for (int h = 1; h <= 4; h++) {
+                        if (strchr("0123456789abcdefABCDEF", p[h]) == NULL || p[h] == '\0') return 1;
+                    }
+                    p += 4;
+                } else if (*p == '\0' || strchr("\"\\/bfnrt", *p) == NULL) {
+                    return 1;
+                }
+            }
+        }
+        *at = p + 1;
+        return 0;
+    }
+
+    if (strncmp(p, "true", 4) == 0 || strncmp(p, "null", 4) == 0) {
+        *at = p + 4;
+        return 0;
+    }
+    if (strncmp(p, "false", 5) == 0) {
+        *at = p + 5;
+        return 0;
+    }
+
+    /* a number: -?int(.digits)?([eE][+-]?digits)?, with no leading zeros */
+    if (*p == '-') p++;
+    if (*p == '0') {
+        p++;
+    } else if (*p >= '1' && *p <= '9') {
+        while (*p >= '0' && *p <= '9') p++;
+    } else {
+        return 1;
+    }
+    if (*p == '.') {
+        p++;
+        if (*p < '0' || *p > '9') return 1;
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        if (*p == '+' || *p == '-') p++;
+        if (*p < '0' || *p > '9') return 1;
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    *at = p;
+    return 0;
+}
+
+void json_space(const char **at) {
+    while (**at == ' ' || **at == '\t' || **at == '\n' || **at == '\r') (*at)++;
+}
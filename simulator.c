@@ -0,0 +1,321 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   simulator.c
+/
+/  File Description:
+/    This file implements the entry points of libsched. It sets up
+/    simulation contexts, reads workloads from a stream, dispatches a
+/    context to the selected scheduling algorithm, and calculates the
+/    summary metrics of a run. No global state is used, so every
+/    function here is reentrant.
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "process.h"
+#include "globals.h"
+#include "histogram.h"
+#include "process_table.h"
+#include "arena.h"
+#include "scheduling.h"
+#include "simulator.h"
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: init_sim_context --------------------
+/  Function Description:
+/    Sets a context to its defaults: no workload, no algorithm, a
+/    fixed time quantum of 1, silent output, no colour, no trace file, free
+/    scheduling decisions and the calling thread's arena.
+/
+/  Caller Input:
+/    SimContext *ctx: the context to initialize
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void init_sim_context(SimContext *ctx) {
+    memset(ctx, 0, sizeof(SimContext));
+    ctx->processes = NULL;
+    ctx->num_processes = 0;
+    ctx->time_quantum = 1;
+    ctx->quantum_mode = QUANTUM_FIXED;
+    ctx->out = NULL;
+    ctx->format = REPORT_TEXT;
+    ctx->log_events = 0;
+    ctx->colour = 0;
+    init_decision_cost(&ctx->decision_cost);
+    init_cache_model(&ctx->cache);
+    init_core_set(&ctx->cores);
+    init_group_tree(&ctx->groups);
+    ctx->arena = NULL;
+    init_latency(&ctx->result.latency);
+}
+
+/*---------- FUNCTION: sim_run -----------------------------
+/  Function Description:
+/    Runs the context's workload through its selected algorithm and
+/    fills in ctx->result. Output is written to ctx->out, if set.
+/    The context's arena is reset first, so the memory used by the
+/    previous run on it is reused.
+/
+/  Caller Input:
+/    SimContext *ctx: the context to run
+/
+/  Caller Output:
+/    0 on success, 1 on failure
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - errors are printed to stderr, and ctx->error says which kind
+/      it was; a run whose arena ran out may have written part of its
+/      output
+/    - the processes must have been reset with reset_process (or read
+/      with sim_read_workload) before each run
+/    - anything allocated from the arena before the call is released
+/---------------------------------------------------------*/
+int sim_run(SimContext *ctx) {
+    ctx->error = SIM_ERROR_INPUT;
+    if (ctx->processes == NULL || ctx->num_processes < 1) {
+        fprintf(stderr, "Error: invalid number of processes.\n");
+        return 1;
+    }
+
+    memset(&ctx->result, 0, sizeof(SimResult));
+    init_latency(&ctx->result.latency);
+    arena_reset(sim_arena(ctx));
+
+    if (strcmp(ctx->algorithm, "FCFS") == 0) {
+        simulate_FCFS(ctx);
+    } else if (strcmp(ctx->algorithm, "SJF") == 0) {
+        simulate_SJF(ctx);
+    } else if (strcmp(ctx->algorithm, "RR") == 0) {
+        if (ctx->time_quantum < 1) {
+            fprintf(stderr, "Error: time quantum must be at least 1.\n");
+            return 1;
+        }
+        simulate_round_robin(ctx);
+    } else if (strcmp(ctx->algorithm, "PS") == 0) {
+        simulate_priority(ctx);
+    } else if (strcmp(ctx->algorithm, "SRTF") == 0) {
+        simulate_SRTF(ctx);
+    } else if (strcmp(ctx->algorithm, "PPS") == 0) {
+        simulate_preemptive_priority(ctx);
+    } else {
+        fprintf(stderr, "Invalid choice.\n");
+        return 1;
+    }
+
+    if (sim_arena(ctx)->failed) {
+        ctx->error = SIM_ERROR_MEMORY;
+        return 1;
+    }
+    ctx->error = SIM_OK;
+    return 0;
+}
+
+/*---------- FUNCTION: sim_read_workload -------------------
+/  Function Description:
+/    Reads processes from a stream, one per line, as "id arrival
+/    burst" or, when with_priority is set, "id arrival burst priority".
+/    Reading stops at the end of the stream or after max_processes.
+/
+/  Caller Input:
+/    FILE *in: the stream to read from
+/    Process processes[]: array to fill in
+/    int max_processes: capacity of the array
+/    int with_priority: 1 to read a priority column
+/
+/  Caller Output:
+/    the number of processes read, or -1 on a malformed line or a
+/    duplicate process ID
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - processes without a priority get a priority of -1
+/    - errors are printed to stderr
+/---------------------------------------------------------*/
+int sim_read_workload(FILE *in, Process processes[], int max_processes, int with_priority) {
+    int i = 0;
+    char temp_id[10];
+    long long arrival, burst;
+    int priority, vals_read;
+
+    while (i < max_processes) {
+        if (with_priority) {
+            vals_read = fscanf(in, "%9s %lld %lld %d", temp_id, &arrival, &burst, &priority);
+        } else {
+            vals_read = fscanf(in, "%9s %lld %lld", temp_id, &arrival, &burst);
+        }
+
+        if (vals_read == EOF) break;
+        if (vals_read < 3) {
+            fprintf(stderr, "Error: malformed process on line %d.\n", i + 1);
+            return -1;
+        }
+        if (!is_unique_id(processes, i, temp_id)) {
+            fprintf(stderr, "Error: ID %s is taken. IDs must be unique.\n", temp_id);
+            return -1;
+        }
+
+        strcpy(processes[i].id, temp_id);
+        processes[i].arrival_time = arrival;
+        processes[i].burst_time = burst;
+        processes[i].priority = (vals_read == 3) ? -1 : priority;
+        reset_process(&processes[i], i);
+
+        i++;
+    }
+
+    return i;
+}
+
+/*---------- FUNCTION: reset_process -----------------------
+/  Function Description:
+/    Clears the metrics of a process so that it can be (re)run.
+/
+/  Caller Input:
+/    Process *process: the process to reset
+/    int index: the process's position in the input
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the id, arrival time, burst time and priority are left as is
+/    - the working set is cleared, the thread count set to 1 and the
+/      group to the root, so a reader that has them sets them 
+/      afterwards
+/---------------------------------------------------------*/
+void reset_process(Process *process, int index) {
+    process->remaining_time = process->burst_time;
+    process->start_time = -1;
+    process->completion_time = -1;
+    process->turnaround_time = -1;
+    process->waiting_time = -1;
+    process->response_time = -1;
+    process->predicted_burst = -1;
+    process->has_started = 0;
+    process->index = index;
+    process->dispatches = 0;
+    process->preemptions = 0;
+    process->expirations = 0;
+    process->working_set = 0;
+    process->cache_stamp = -HUGE_VAL;
+    process->work_carried = 0;
+    process->core = -1;
+    process->threads = 1;
+    process->group = 0;
+}
+
+/*---------- FUNCTION: is_unique_id ------------------------
+/  Function Description:
+/    Checks whether a given process ID is unique amongst the
+/    other array entries.
+/
+/  Caller Input:
+/    Process processes[]: array of process details
+/    int count: number of processes in the array
+/    char *id: the pid that needs to be validated as unique
+/
+/  Caller Output:
+/    1 if the ID is unique, 0 if it is taken
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - assumes the array contains valid data
+/---------------------------------------------------------*/
+int is_unique_id(Process processes[], int count, char *id) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(processes[i].id, id) == 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*---------- FUNCTION: calculate_results -------------------
+/  Function Description:
+/    Calculates the summary metrics of a finished run from its
+/    processes and stores them in ctx->result. The per-process 
+/    metrics are summarized from a columnar ProcessTable, and the 
+/    processes' switch counts are totalled.
+/
+/  Caller Input:
+/    SimContext *ctx: a context whose run has finished, with
+/      result.current_time and result.idle_time set
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - a run that ends at time 0 reports zero throughput and
+/      utilization rather than dividing by zero
+/---------------------------------------------------------*/
+void calculate_results(SimContext *ctx) {
+    SimResult *result = &ctx->result;
+    long long total_completion = result->current_time;
+    int n = ctx->num_processes;
+    ProcessTable table;
+
+    init_process_table(&table, sim_arena(ctx));
+    table_load(&table, ctx->processes, n);
+    table_compute_metrics(&table, &result->turnaround, &result->waiting, &result->response);
+    free_process_table(&table);
+
+    memset(&result->switches, 0, sizeof(SwitchCounts));
+    for (int i = 0; i < n; i++) {
+        add_switches(&result->switches, &ctx->processes[i]);
+    }
+
+    if (total_completion > 0) {
+        result->throughput = (double)n / total_completion;
+        result->cpu_utilization = (total_completion - result->idle_time) / (double)total_completion * 100;
+    } else {
+        result->throughput = 0;
+        result->cpu_utilization = 0;
+    }
+}
+
+/*---------- FUNCTION: add_switches ------------------------
+/  Function Description:
+/    Adds a completed process's dispatches, and how they ended, to 
+/    a run's totals.
+/
+/  Caller Input:
+/    SwitchCounts *total: the run's totals
+/    const Process *process: the completed process
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the dispatch that ended in its completion is counted as such
+/---------------------------------------------------------*/
+void add_switches(SwitchCounts *total, const Process *process) {
+    total->dispatches += process->dispatches;
+    total->completions++;
+    total->preemptions += process->preemptions;
+    total->expirations += process->expirations;
+}
+
+/*---------- FUNCTION: sim_arena ---------------------------
+/  Function Description:
+/    Returns the arena a context's runs allocate from: its own, if
+/    one was set, or else the calling thread's.
+/
+/  Caller Input:
+/    SimContext *ctx: the context
+/
+/  Caller Output:
+/    A pointer to the arena
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - a context shared by several threads must be given its own
+/      arena, or each thread resets only its own
+/---------------------------------------------------------*/
+Arena *sim_arena(SimContext *ctx) {
+    return ctx->arena != NULL ? ctx->arena : thread_arena();
+}
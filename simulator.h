@@ -0,0 +1,220 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   simulator.h
+/
+/  Program Purpose(s):
+/    This header file is the public interface of libsched, the
+/    simulator library. A program fills in a SimContext with a
+/    workload, an algorithm and an output sink, then calls sim_run.
+/    Everything a run touches lives in its context, so separate
+/    contexts can be run one after another or on different threads.
+/---------------------------------------------------------*/
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <stdio.h>
+#include "process.h"
+#include "histogram.h"
+#include "process_table.h"
+#include "arena.h"
+#include "report.h"
+#include "cost.h"
+#include "quantum.h"
+#include "cache.h"
+#include "cores.h"
+#include "groups.h"
+
+#define SIM_OK 0
+#define SIM_ERROR_INPUT 1
+#define SIM_ERROR_MEMORY 2
+
+/*---------- STRUCTURE: SwitchCounts -----------------------
+/  Structure Description:
+/    How often a run switched the CPU between processes. Every 
+/    dispatch ends in a completion, a preemption or a time slice 
+/    expiration, so those three add up to the dispatches.
+/
+/  Fields:
+/    long long dispatches
+/      Times a process was put on the CPU
+/    long long completions
+/      Times a process gave up the CPU by finishing its burst
+/    long long preemptions
+/      Times an arriving process took the CPU (SRTF and PPS)
+/    long long expirations
+/      Times a time slice ended with another process waiting (RR)
+/    long long migrations
+/      Times a process was dispatched on a different core than it
+/      last ran on, or moved to a faster one while running (multi-core
+/      runs only)
+/
+/  Relationships:
+/    - contained in SimResult, totalled from the processes' counts
+/      (but for migrations, which the multi-core simulator counts)
+/---------------------------------------------------------*/
+typedef struct {
+    long long dispatches;
+    long long completions;
+    long long preemptions;
+    long long expirations;
+    long long migrations;
+} SwitchCounts;
+
+/*---------- STRUCTURE: SimResult --------------------------
+/  Structure Description:
+/    The summary metrics of one simulation run. The per-process
+/    metrics are written into the context's processes array.
+/
+/  Fields:
+/    long long current_time
+/      Time at which the last process completed
+/    long long idle_time
+/      Total time the CPU spent idle
+/    MetricSummary turnaround, waiting, response
+/      Mean, min, max and variance of the per-process metrics
+/    double throughput
+/      Processes completed per time unit
+/    double cpu_utilization
+/      Percentage of the run the CPU was busy
+/    LatencyHistograms latency
+/      Distributions of the per-process metrics
+/    long long decisions
+/      Scheduling decisions charged for under the context's decision
+/      cost model (0 if it has none)
+/    long long overhead_time
+/      CPU time charged for them
+/    SwitchCounts switches
+/      Dispatches over the whole run, and how each one ended
+/    long long refill_time
+/      CPU time spent reloading caches under the context's cache
+/      model (0 if it has none)
+/    int num_classes
+/      Number of classes of cores in a multi-core run, or 0
+/    CoreUsage classes[MAX_CORE_CLASSES]
+/      What each class of cores did, fastest first; for a multi-core
+/      run, idle_time is the time every core was idle, and
+/      cpu_utilization is the share of all the cores' time spent busy
+/    GangUsage gang
+/      How multi-threaded processes were co-scheduled on the cores
+/
+/  Relationships:
+/    - contained in SimContext
+/---------------------------------------------------------*/
+typedef struct {
+    long long current_time;
+    long long idle_time;
+    MetricSummary turnaround;
+    MetricSummary waiting;
+    MetricSummary response;
+    double throughput;
+    double cpu_utilization;
+    LatencyHistograms latency;
+    long long decisions;
+    long long overhead_time;
+    SwitchCounts switches;
+    long long refill_time;
+    int num_classes;
+    CoreUsage classes[MAX_CORE_CLASSES];
+    GangUsage gang;
+} SimResult;
+
+/*---------- STRUCTURE: SimContext -------------------------
+/  Structure Description:
+/    Holds everything a single simulation run needs and produces.
+/
+/  Fields:
+/    Process *processes
+/      The workload. Owned by the caller and updated in place with
+/      each process's metrics (the array is re-sorted by the run).
+/    int num_processes
+/      Number of processes in the workload
+/    char algorithm[256]
+/      FCFS, SJF, SRTF, RR, PS or PPS; sized like the option it is
+/      copied from, so a long name is rejected rather than cut short
+/    int time_quantum
+/      Time slice used by RR
+/    int quantum_mode
+/      How RR sets each time slice from time_quantum: QUANTUM_FIXED,
+/      or one of the adaptive policies (see quantum.h)
+/    FILE *out
+/      Where the event table, metrics and Gantt chart are written, or
+/      NULL to run silently and only fill in result
+/    int format
+/      REPORT_TEXT for the tables and chart, or REPORT_JSON or
+/      REPORT_CSV for the per-process and summary metrics in that form
+/    int log_events
+/      1 to include the event list in a JSON or CSV report
+/    ReportWriter report
+/      Writes the JSON or CSV report to out during the run
+/    int colour
+/      1 to colour the Gantt chart with ANSI escape sequences
+/    char trace_file[256]
+/      Pathway of a Chrome trace-event file to write, or empty
+/    char window_file[256]
+/      Pathway of a CSV file for the windowed time series, or empty
+/    long long window_width
+/      Length of each window of the time series, in time units
+/    DecisionCost decision_cost
+/      What each scheduling decision costs, in CPU time; only the
+/      streaming simulator charges for decisions
+/    CacheModel cache
+/      How long processes take to reload their caches after a switch;
+/      only the streaming simulator charges for refills
+/    CoreSet cores
+/      The cores to run on, and how processes are placed on them; only
+/      the streaming simulator runs on more than one CPU
+/    GroupTree groups
+/      The groups processes are scheduled in, and what each one did
+/      over the run; only the streaming simulator schedules groups
+/    Arena *arena
+/      Where the run's transient state is allocated, or NULL for the
+/      calling thread's arena. It is reset at the start of each run.
+/    SimResult result
+/      Filled in by sim_run
+/    int error
+/      Why the last run failed: SIM_OK, SIM_ERROR_INPUT for a bad 
+/      workload or setting, or SIM_ERROR_MEMORY if its arena ran out
+/
+/  Relationships:
+/    - points to an array of Process structs
+/    - contains a SimResult
+/    - draws its working memory from an Arena
+/    - contains a ReportWriter
+/    - contains a DecisionCost, a CacheModel, a CoreSet and a 
+/      GroupTree
+/---------------------------------------------------------*/
+typedef struct {
+    Process *processes;
+    int num_processes;
+    char algorithm[256];
+    int time_quantum;
+    int quantum_mode;
+    FILE *out;
+    int format;
+    int log_events;
+    ReportWriter report;
+    int colour;
+    char trace_file[256];
+    char window_file[256];
+    long long window_width;
+    DecisionCost decision_cost;
+    CacheModel cache;
+    CoreSet cores;
+    GroupTree groups;
+    Arena *arena;
+    SimResult result;
+    int error;
+} SimContext;
+
+void init_sim_context(SimContext *ctx);
+int sim_run(SimContext *ctx);
+int sim_read_workload(FILE *in, Process processes[], int max_processes, int with_priority);
+void reset_process(Process *process, int index);
+int is_unique_id(Process processes[], int count, char *id);
+void calculate_results(SimContext *ctx);
+void add_switches(SwitchCounts *total, const Process *process);
+Arena *sim_arena(SimContext *ctx);
+
+#endif
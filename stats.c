@@ -0,0 +1,128 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   stats.c
+/
+/  File Description:
+/    This file holds the simulator's instrumentation counters and
+/    prints them, either as a table or as JSON. The counters are
+/    only updated in builds with SCHED_STATS defined; see stats.h.
+/---------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include "stats.h"
+
+_Thread_local SchedStats sched_stats;
+
+ssize_t stats_cookie_write(void *cookie, const char *buf, size_t size);
+int stats_cookie_close(void *cookie);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions manage and report the calling thread's counters.
+/
+/  Functions and Their Purpose:
+/    - stats_enabled: 1 if the program was built with SCHED_STATS.
+/    - stats_reset: Zeroes the counters.
+/    - stats_now: The monotonic clock, in nanoseconds, for the timers.
+/    - stats_count_output: Wraps a stream so that the bytes written
+/      through it are added to bytes_output. Closing the wrapper
+/      flushes it but leaves the wrapped stream open. Returns out
+/      itself if the wrapper cannot be made.
+/    - stats_print: Prints the counters and timers as an aligned
+/      table, or as a JSON object if json is set.
+/
+/  Input Parameters:
+/    - FILE *out: the stream to wrap, or to print to
+/    - int json: 1 for JSON, 0 for a table
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - stats_count_output uses the GNU fopencookie extension
+/------------------------------------------------------------------------*/
+int stats_enabled(void) {
+#ifdef SCHED_STATS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+void stats_reset(void) {
+    memset(&sched_stats, 0, sizeof(SchedStats));
+}
+
+long long stats_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+FILE *stats_count_output(FILE *out) {
+    cookie_io_functions_t io = {NULL, stats_cookie_write, NULL, stats_cookie_close};
+    FILE *counted = fopencookie(out, "w", io);
+
+    return counted != NULL ? counted : out;
+}
+
+void stats_print(FILE *out, int json) {
+    const struct {
+        const char *name;
+        long long value;
+    } rows[] = {
+        {"enqueues", sched_stats.enqueues},
+        {"dequeues", sched_stats.dequeues},
+        {"sorts", sched_stats.sorts},
+        {"sort_moves", sched_stats.sort_moves},
+        {"comparisons", sched_stats.comparisons},
+        {"id_lookups", sched_stats.id_lookups},
+        {"id_compares", sched_stats.id_compares},
+        {"steps", sched_stats.steps},
+        {"events", sched_stats.events},
+        {"ticks", sched_stats.ticks},
+        {"idle_skipped", sched_stats.idle_skipped},
+        {"bytes_output", sched_stats.bytes_output},
+        {"bytes_trace", sched_stats.bytes_trace},
+        {"bytes_series", sched_stats.bytes_series},
+        {"parse_ns", sched_stats.parse_ns},
+        {"simulate_ns", sched_stats.simulate_ns},
+        {"metrics_ns", sched_stats.metrics_ns},
+        {"chart_ns", sched_stats.chart_ns},
+    };
+    int num_rows = sizeof(rows) / sizeof(rows[0]);
+
+    if (json) {
+        fprintf(out, "{");
+        for (int r = 0; r < num_rows; r++) {
+            fprintf(out, "%s\"%s\":%lld", r > 0 ? "," : "", rows[r].name, rows[r].value);
+        }
+        fprintf(out, "}\n");
+        return;
+    }
+
+    fprintf(out, "\nEngine Statistics:\n");
+    for (int r = 0; r < num_rows; r++) {
+        fprintf(out, "  %-14s %16lld\n", rows[r].name, rows[r].value);
+    }
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+
+ssize_t stats_cookie_write(void *cookie, const char *buf, size_t size) {
+    size_t written = fwrite(buf, 1, size, (FILE *)cookie);
+    STAT_ADD(bytes_output, (long long)written);
+    return written;
+}
+
+int stats_cookie_close(void *cookie) {
+    return fflush((FILE *)cookie);
+}
@@ -0,0 +1,99 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   stats.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others. It
+/    also defines the STAT_* macros used to instrument the simulator.
+/    The macros expand to nothing unless the program is built with
+/    SCHED_STATS defined (make STATS=1), so the counters cost nothing
+/    in a normal build.
+/---------------------------------------------------------*/
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+
+/*---------- STRUCTURE: SchedStats -------------------------
+/  Structure Description:
+/    Counters and phase timers describing the work the simulator
+/    did. Each thread has its own copy, so runs on separate threads
+/    do not interfere with each other.
+/
+/  Fields:
+/    long long enqueues, dequeues
+/      Calls to enqueue/dequeue (or pushes/pops of the streaming heap)
+/    long long sorts, sort_moves
+/      Calls to sort_queue, and processes it copied in and out
+/    long long comparisons
+/      Calls to the comparison functions
+/    long long id_lookups, id_compares
+/      Searches of the process array by ID, and the strcmp calls
+/      they made
+/    long long steps
+/      Iterations of a simulator's main loop
+/    long long events
+/      Scheduling events (idle, dispatch, completion) processed
+/    long long ticks
+/      Simulated time units covered by the runs
+/    long long idle_skipped
+/      Idle time units jumped over rather than stepped through
+/    long long bytes_output, bytes_trace, bytes_series
+/      Bytes written to the results, trace and time series files
+/    long long parse_ns, simulate_ns, metrics_ns, chart_ns
+/      Wall-clock time spent in each phase, in nanoseconds
+/    long long parse_mark, simulate_mark, metrics_mark, chart_mark
+/      Start times of the phases currently being timed
+/
+/  Relationships:
+/    - one instance per thread, sched_stats
+/---------------------------------------------------------*/
+typedef struct {
+    long long enqueues;
+    long long dequeues;
+    long long sorts;
+    long long sort_moves;
+    long long comparisons;
+    long long id_lookups;
+    long long id_compares;
+    long long steps;
+    long long events;
+    long long ticks;
+    long long idle_skipped;
+    long long bytes_output;
+    long long bytes_trace;
+    long long bytes_series;
+    long long parse_ns;
+    long long simulate_ns;
+    long long metrics_ns;
+    long long chart_ns;
+    long long parse_mark;
+    long long simulate_mark;
+    long long metrics_mark;
+    long long chart_mark;
+} SchedStats;
+
+extern _Thread_local SchedStats sched_stats;
+
+#ifdef SCHED_STATS
+#define STAT_INC(field) (sched_stats.field++)
+#define STAT_ADD(field, n) (sched_stats.field += (n))
+#define STAT_TIMER_START(phase) (sched_stats.phase##_mark = stats_now())
+#define STAT_TIMER_STOP(phase) (sched_stats.phase##_ns += stats_now() - sched_stats.phase##_mark)
+#else
+#define STAT_INC(field) ((void)0)
+#define STAT_ADD(field, n) ((void)0)
+#define STAT_TIMER_START(phase) ((void)0)
+#define STAT_TIMER_STOP(phase) ((void)0)
+#endif
+
+int stats_enabled(void);
+void stats_reset(void);
+long long stats_now(void);
+FILE *stats_count_output(FILE *out);
+void stats_print(FILE *out, int json);
+
+#endif
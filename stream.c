@@ -0,0 +1,1453 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   stream.c
+/
+/  File Description:
+/    This file implements the streaming (online) simulator. Instead of
+/    reading the whole workload and sorting it, processes are read from
+/    an arrival-ordered stream only when simulated time reaches them,
+/    are dropped as soon as they complete, and have their metrics
+/    written out as they go. Memory use depends on the number of
+/    processes active at once rather than the length of the workload,
+/    so arbitrarily long traces can be replayed, including from a pipe.
+/
+/    The simulator is event driven: the running process is advanced
+/    straight to its completion, the end of its time slice (RR), or
+/    the next arrival (SRTF and PPS), whichever comes first. The ready
+/    processes are kept in a binary heap keyed by the algorithm.
+/
+/    With cores given, the processes share one ready set between
+/    several cores, possibly of different speeds (see cores.h), and
+/    time advances to the earliest event on any core. An idle core
+/    takes the next ready process as soon as there is one; under SRTF
+/    and PPS, a process that should run before one of those running
+/    takes the core of the one that should run last.
+/
+/    With groups given (see groups.h), each group at the bottom of the
+/    tree keeps its own ready set. The group whose process runs next 
+/    is picked first, and then the algorithm picks the process within
+/    it. A process runs for at most the tree's slice before its group 
+/    is weighed against the others again, and never past the point 
+/    where a group it is in uses its quota or reaches the end of its
+/    period. Arrivals only preempt processes in their own group.
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "process.h"
+#include "simulator.h"
+#include "display.h"
+#include "histogram.h"
+#include "trace.h"
+#include "series.h"
+#include "stats.h"
+#include "report.h"
+#include "stream.h"
+#include "arena.h"
+#include "workload.h"
+#include "cost.h"
+#include "cache.h"
+#include "cores.h"
+#include "groups.h"
+
+#define READY_INITIAL_CAPACITY 64
+#define BACKFILL_DEPTH 100
+
+/*---------- STRUCTURE: StreamState ------------------------
+/  Structure Description:
+/    The state of one streaming run, shared by its helper functions.
+/
+/  Fields:
+/    SimContext *ctx
+/      The run's settings and results
+/    FILE *in
+/      The arrival-ordered workload, as text
+/    const Workload *workload
+/      The arrival-ordered workload, mapped, if in is NULL
+/    int with_priority, preemptive, round_robin
+/      Which input format and dispatch rules the algorithm uses
+/    Process next
+/      The next process to arrive, read ahead of time
+/    int has_next
+/      1 if next holds a process, 0 at the end of the stream
+/    int num_read
+/      Number of processes read so far (used as their index)
+/    long long rr_seq
+/      Counter giving RR's ready queue its FIFO order
+/    ReadySet ready
+/      The processes that have arrived and are waiting
+/    int peak_active
+/      Largest number of processes in memory at once
+/    double m2[3]
+/      Running sums of squared deviations for the variances
+/    TraceWriter trace
+/      Optional Chrome trace-event output
+/    WindowSeries windows
+/      Optional windowed time series output
+/    long long window_time
+/      Time up to which the window series has been fed
+/    int window_running
+/      1 if the CPU has been busy since window_time
+/    QuantumPolicy quantum
+/      RR's time slice policy, told of every process that joins or
+/      leaves the ready set
+/    double overhead
+/      Total cost of the scheduling decisions so far under the
+/      context's decision cost model, of which the whole time units
+/      have been charged
+/    long long refill_due
+/      Time the running process must still spend reloading its cache
+/      before it makes progress, under the context's cache model (its
+/      remaining_time is only its own work)
+/    ReadySet *group_ready
+/      With groups, one ready set per group, of which only those at 
+/      the bottom of the tree are used, ready then keeping only the 
+/      count of all their processes; NULL otherwise
+/
+/  Relationships:
+/    - contains a ReadySet, a TraceWriter and a WindowSeries
+/---------------------------------------------------------*/
+typedef struct {
+    SimContext *ctx;
+    FILE *in;
+    const Workload *workload;
+    int with_priority;
+    int preemptive;
+    int round_robin;
+    Process next;
+    int has_next;
+    int num_read;
+    long long rr_seq;
+    ReadySet ready;
+    int peak_active;
+    double m2[3];
+    TraceWriter trace;
+    WindowSeries windows;
+    long long window_time;
+    int window_running;
+    QuantumPolicy quantum;
+    double overhead;
+    long long refill_due;
+    ReadySet *group_ready;
+} StreamState;
+
+int stream_run(SimContext *ctx, FILE *in, const Workload *workload);
+int stream_read_next(StreamState *state);
+int stream_read_line(StreamState *state, char *id, long long *arrival, long long *burst,
+                     int *priority, char *extra);
+int stream_admit(StreamState *state, long long current_time);
+long long stream_key(StreamState *state, Process *process);
+int stream_decide(StreamState *state, long long *current_time);
+int stream_preempts(StreamState *state, Process *running);
+int stream_push(StreamState *state, Process *process, long long seq);
+Process stream_pop(StreamState *state);
+Process stream_pop_group(StreamState *state, int g);
+int entry_before(ReadyEntry *a, ReadyEntry *b);
+void stream_complete(StreamState *state, Process *process, long long current_time);
+void stream_switch_out(StreamState *state, Process *process, long long busy);
+void summary_add(MetricSummary *summary, double *m2, long long n, long long x);
+const char *stream_title(const char *algorithm);
+void stream_window_to(StreamState *state, long long time);
+int stream_cores(StreamState *state, long long *end_time, long long *idle, long long *done);
+int stream_core_width(StreamState *state, Process *process, int free);
+void stream_core_start(StreamState *state, Core cores[], int c, Process *process, int width, long long current_time);
+void stream_core_slice(StreamState *state, Core *core, long long current_time);
+void stream_core_stop(StreamState *state, Core cores[], int c, long long current_time);
+void stream_core_progress(StreamState *state, Core cores[], int c, long long current_time);
+int stream_core_victim(StreamState *state, Core cores[], long long current_time, ReadyEntry *entry);
+int stream_backfill(StreamState *state, Core cores[], int free, long long current_time);
+int compare_end(const void *a, const void *b);
+Process *stream_peek(StreamState *state);
+Process *stream_at(StreamState *state, int i);
+Process stream_take(ReadySet *ready, int i);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions run the context's algorithm over a workload that
+/    is read as the simulation goes, writing one row of metrics per 
+/    process as it completes and a summary once the workload is 
+/    exhausted and all work is done.
+/
+/  Functions and Their Purpose:
+/    - sim_stream: Reads the workload from a text stream.
+/    - sim_stream_workload: Reads the workload from the columns of a 
+/      mapped binary workload, with no parsing.
+/
+/  Input Parameters:
+/    - SimContext *ctx: the run; its algorithm, time_quantum, 
+/      quantum_mode, decision_cost, cache, cores, out, format and 
+/      trace_file are used, and its processes array is not
+/    - FILE *in: the workload, one "id arrival burst [priority]" per
+/      line, sorted by arrival time; with a cache model, a line may 
+/      end with the process's working set, with a gang mode, with its
+/      number of threads, and with groups, with its group
+/    - const Workload *workload: the workload, sorted by arrival time
+/
+/  Output:
+/    - 0 on success, 1 on failure
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - input that is not sorted by arrival time is rejected when the
+/      out-of-order line is reached; rows already written stand
+/    - IDs are not checked for uniqueness, since completed processes
+/      are no longer held
+/    - no Gantt chart is drawn, as it would grow with the trace
+/    - with a JSON or CSV format, the rows are the report's processes
+/      section, and the event list is never written
+/    - with --stats, the simulate timer includes the time spent 
+/      reading the input, which is also counted under parse
+/    - ties are broken by input order (RR: by order of joining the
+/      ready queue)
+/    - time spent reloading a cache counts toward waiting time, as 
+/      time in which the process makes no progress
+/    - with cores, decisions, refills, the trace and the window series
+/      are not modelled, and waiting time includes the extra time a 
+/      burst takes on a slow core
+/    - a gang mode or groups need a text workload, as a binary one 
+/      has no thread counts or groups
+/    - with groups, cores, decisions and cache refills are not 
+/      charged to the groups, and IDs are still not checked
+/    - on failure, ctx->error says whether the input was bad or the
+/      run's arena ran out
+/------------------------------------------------------------------------*/
+int sim_stream(SimContext *ctx, FILE *in) {
+    return stream_run(ctx, in, NULL);
+}
+
+int sim_stream_workload(SimContext *ctx, const Workload *workload) {
+    ctx->error = SIM_ERROR_INPUT;
+    if (strcmp(ctx->algorithm, "PS") == 0 || strcmp(ctx->algorithm, "PPS") == 0) {
+        if (!workload->has_priority) {
+            fprintf(stderr, "Error: the workload has no priorities.\n");
+            return 1;
+        }
+    }
+    if (ctx->cores.gang != GANG_NONE) {
+        fprintf(stderr, "Error: the workload has no thread counts.\n");
+        return 1;
+    }
+    if (ctx->groups.num_groups > 0) {
+        fprintf(stderr, "Error: the workload has no groups.\n");
+        return 1;
+    }
+    return stream_run(ctx, NULL, workload);
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION: stream_run --------------------------
+/  Function Description:
+/    The streaming simulator behind sim_stream and 
+/    sim_stream_workload.
+/
+/  Caller Input:
+/    SimContext *ctx: the run
+/    FILE *in: the text workload, or NULL
+/    const Workload *workload: the mapped workload, if in is NULL
+/
+/  Caller Output:
+/    0 on success, 1 on failure
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - see sim_stream
+/---------------------------------------------------------*/
+int stream_run(SimContext *ctx, FILE *in, const Workload *workload) {
+    StreamState state;
+    SimResult *result = &ctx->result;
+    Arena *arena = sim_arena(ctx);
+    Process running;
+    int has_running = 0;
+    int last_index = -1;
+    int dispatched;
+    long long current_time = 0;
+    long long idle_time = 0;
+    long long completed = 0;
+    long long slice = ctx->time_quantum;
+    const char *title = stream_title(ctx->algorithm);
+    char adaptive_title[48];
+    char cores_title[128];
+    char groups_title[sizeof(cores_title) + 32];
+    int status = 0;
+
+    ctx->error = SIM_ERROR_INPUT;
+    if (title == NULL) {
+        fprintf(stderr, "Invalid choice.\n");
+        return 1;
+    }
+    if (strcmp(ctx->algorithm, "RR") == 0 && ctx->time_quantum < 1) {
+        fprintf(stderr, "Error: time quantum must be at least 1.\n");
+        return 1;
+    }
+
+    memset(&state, 0, sizeof(StreamState));
+    state.ctx = ctx;
+    state.in = in;
+    state.workload = workload;
+    state.with_priority = strcmp(ctx->algorithm, "PS") == 0 || strcmp(ctx->algorithm, "PPS") == 0;
+    state.preemptive = strcmp(ctx->algorithm, "SRTF") == 0 || strcmp(ctx->algorithm, "PPS") == 0;
+    state.round_robin = strcmp(ctx->algorithm, "RR") == 0;
+    arena_reset(arena);
+    state.ready.arena = arena;
+    state.ready.fifo = state.round_robin || strcmp(ctx->algorithm, "FCFS") == 0;
+    quantum_init(&state.quantum, state.round_robin ? ctx->quantum_mode : QUANTUM_FIXED, ctx->time_quantum, arena);
+    if (state.round_robin && ctx->quantum_mode != QUANTUM_FIXED) {
+        snprintf(adaptive_title, sizeof(adaptive_title), "RR (Round Robin, %s quantum)",
+                 quantum_mode_name(ctx->quantum_mode));
+        title = adaptive_title;
+    }
+    if (ctx->cores.num_cores > 0) {
+        snprintf(cores_title, sizeof(cores_title), "%s on %d cores, %s placement%s%s",
+                 title, ctx->cores.num_cores, placement_name(ctx->cores.placement),
+                 ctx->cores.gang != GANG_NONE ? ", gangs " : "",
+                 ctx->cores.gang != GANG_NONE ? gang_mode_name(ctx->cores.gang) : "");
+        title = cores_title;
+    }
+    if (ctx->groups.num_groups > 0) {
+        groups_reset(&ctx->groups);
+        state.group_ready = arena_alloc(arena, ctx->groups.num_groups * sizeof(ReadySet));
+        if (state.group_ready == NULL) {
+            quantum_release(&state.quantum);
+            ctx->error = SIM_ERROR_MEMORY;
+            return 1;
+        }
+        memset(state.group_ready, 0, ctx->groups.num_groups * sizeof(ReadySet));
+        for (int g = 0; g < ctx->groups.num_groups; g++) {
+            state.group_ready[g].arena = arena;
+            state.group_ready[g].fifo = state.ready.fifo;
+        }
+        snprintf(groups_title, sizeof(groups_title), "%s in %d groups", title, ctx->groups.num_groups - 1);
+        title = groups_title;
+    }
+
+    memset(result, 0, sizeof(SimResult));
+    init_latency(&result->latency);
+
+    trace_open(&state.trace, ctx->trace_file, ctx->algorithm);
+    window_open(&state.windows, ctx->window_file, ctx->window_width, arena);
+    if (ctx->out != NULL && ctx->format != REPORT_TEXT) {
+        report_begin(&ctx->report, ctx->out, ctx->format);
+        report_section(&ctx->report, "processes", REPORT_PROCESS_COLUMNS, 1);
+    } else if (ctx->out != NULL) {
+        display_stream_header(ctx->out, title);
+    }
+
+    if (stream_read_next(&state) != 0) {
+        status = 1;
+    }
+
+    STAT_TIMER_START(simulate);
+    if (status == 0 && ctx->cores.num_cores > 0) {
+        status = stream_cores(&state, &current_time, &idle_time, &completed);
+    }
+    while (status == 0 && (state.has_next || state.ready.count > 0 || has_running)) {
+        long long run_until;
+        long long run_from;
+
+        STAT_INC(steps);
+        if (!has_running) {
+            if (state.ready.count == 0) {
+                /* nothing to run: jump to the next arrival */
+                state.window_running = 0;
+                if (state.next.arrival_time > current_time) {
+                    STAT_ADD(idle_skipped, state.next.arrival_time - current_time);
+                    idle_time += state.next.arrival_time - current_time;
+                    current_time = state.next.arrival_time;
+                }
+                if (stream_admit(&state, current_time) != 0) {
+                    status = 1;
+                    break;
+                }
+                if (state.ready.count > state.peak_active) {
+                    state.peak_active = state.ready.count;
+                }
+            }
+
+            stream_window_to(&state, current_time);
+            if (state.group_ready != NULL) {
+                int g = group_pick(&ctx->groups, -1, current_time);
+
+                if (g < 0) {
+                    /* every group with work has used its quota: wait for a refill or an arrival */
+                    long long wake = group_refill(&ctx->groups, current_time);
+
+                    if (state.has_next && state.next.arrival_time < wake) wake = state.next.arrival_time;
+                    state.window_running = 0;
+                    idle_time += wake - current_time;
+                    current_time = wake;
+                    last_index = -1;
+                    if (stream_admit(&state, current_time) != 0) {
+                        status = 1;
+                        break;
+                    }
+                    if (state.ready.count > state.peak_active) {
+                        state.peak_active = state.ready.count;
+                    }
+                    continue;
+                }
+                running = stream_pop_group(&state, g);
+            } else {
+                running = stream_pop(&state);
+            }
+            has_running = 1;
+            /* a process that keeps the CPU after its time slice is not switched */
+            dispatched = running.index != last_index;
+            if (dispatched) {
+                running.dispatches++;
+                last_index = running.index;
+            }
+            STAT_INC(events);
+            state.window_running = 1;
+            if (ctx->decision_cost.model != COST_NONE) {
+                if (stream_decide(&state, &current_time) != 0) {
+                    status = 1;
+                    break;
+                }
+                /* an arrival during the decision may call for another */
+                if (stream_preempts(&state, &running)) {
+                    running.preemptions++;
+                    has_running = 0;
+                    if (stream_push(&state, &running, running.index) != 0) {
+                        status = 1;
+                        break;
+                    }
+                    continue;
+                }
+            }
+            if (state.round_robin) {
+                slice = quantum_next(&state.quantum);
+                quantum_remove(&state.quantum, running.remaining_time);
+            } else if (state.group_ready != NULL) {
+                slice = ctx->groups.slice;
+            }
+            if (dispatched) {
+                state.refill_due = cache_refill(&ctx->cache, &running, current_time - idle_time);
+            }
+            if (!running.has_started) {
+                running.has_started = 1;
+                running.start_time = current_time;
+                running.response_time = current_time - running.arrival_time;
+            }
+            trace_run(&state.trace, &running, running.index + 1, current_time);
+        }
+
+        /* the refill is paid ahead of the process's own work, and not out of its slice */
+        run_until = current_time + state.refill_due + running.remaining_time;
+        if ((state.round_robin || state.group_ready != NULL) && run_until > current_time + state.refill_due + slice) {
+            run_until = current_time + state.refill_due + slice;
+        }
+        if (state.group_ready != NULL) {
+            long long budget = group_budget(&ctx->groups, running.group, current_time);
+
+            if (run_until - current_time > budget) run_until = current_time + budget;
+        }
+        if (state.preemptive && state.has_next && state.next.arrival_time < run_until) {
+            run_until = state.next.arrival_time;
+        }
+        run_from = current_time;
+
+        if (state.refill_due > 0) {
+            long long paid = run_until - current_time < state.refill_due ? run_until - current_time : state.refill_due;
+
+            state.refill_due -= paid;
+            result->refill_time += paid;
+            current_time += paid;
+        }
+        if (state.round_robin || state.group_ready != NULL) slice -= run_until - current_time;
+        running.remaining_time -= run_until - current_time;
+        current_time = run_until;
+        if (state.group_ready != NULL) {
+            group_charge(&ctx->groups, running.group, current_time - run_from, current_time,
+                         running.remaining_time > 0);
+        }
+
+        if (stream_admit(&state, current_time) != 0) {
+            status = 1;
+            break;
+        }
+        stream_window_to(&state, current_time);
+        /* the running process is held outside the heap */
+        if (state.ready.count + 1 > state.peak_active) {
+            state.peak_active = state.ready.count + 1;
+        }
+
+        if (running.remaining_time == 0) {
+            trace_stop(&state.trace, current_time);
+            stream_complete(&state, &running, current_time);
+            STAT_INC(events);
+            completed++;
+            has_running = 0;
+            last_index = -1;
+        } else if (state.group_ready != NULL && group_pick(&ctx->groups, running.group, current_time) != running.group) {
+            /* another group's turn, or this one's quota is used up */
+            running.preemptions++;
+            stream_switch_out(&state, &running, current_time - idle_time);
+            status = stream_push(&state, &running, state.round_robin ? state.rr_seq++ : running.index);
+            has_running = 0;
+        } else if (state.round_robin && slice == 0) {
+            ReadySet *ready = state.group_ready != NULL ? &state.group_ready[running.group] : &state.ready;
+
+            if (ready->count > 0) {
+                running.expirations++;
+                trace_expire(&state.trace, current_time);
+                stream_switch_out(&state, &running, current_time - idle_time);
+            }
+            /* arrivals during the slice join the queue ahead of it */
+            status = stream_push(&state, &running, state.rr_seq++);
+            has_running = 0;
+        } else if (stream_preempts(&state, &running)) {
+            running.preemptions++;
+            stream_switch_out(&state, &running, current_time - idle_time);
+            status = stream_push(&state, &running, running.index);
+            has_running = 0;
+        } else if (state.group_ready != NULL && slice == 0) {
+            /* its group is still the one to run */
+            slice = ctx->groups.slice;
+        }
+    }
+
+    STAT_TIMER_STOP(simulate);
+    STAT_ADD(ticks, current_time);
+    if (arena->failed) {
+        /* a process may have been dropped, so the summary would be wrong */
+        status = 1;
+    }
+
+    trace_close(&state.trace, current_time);
+    window_close(&state.windows, current_time);
+    arena_release(arena, state.ready.heap);
+    if (state.group_ready != NULL) {
+        for (int g = 0; g < ctx->groups.num_groups; g++) {
+            arena_release(arena, state.group_ready[g].heap);
+        }
+        arena_release(arena, state.group_ready);
+    }
+    quantum_release(&state.quantum);
+
+    result->current_time = current_time;
+    result->idle_time = idle_time;
+    for (int m = 0; m < 3; m++) {
+        MetricSummary *summary = m == 0 ? &result->turnaround : m == 1 ? &result->waiting : &result->response;
+        summary->variance = completed > 0 ? state.m2[m] / completed : 0;
+    }
+    if (current_time > 0) {
+        result->throughput = (double)completed / current_time;
+        result->cpu_utilization = (current_time - idle_time) / (double)current_time * 100;
+    }
+    if (result->num_classes > 0 && current_time > 0) {
+        long long busy = 0;
+
+        for (int cls = 0; cls < result->num_classes; cls++) {
+            busy += result->classes[cls].busy_time;
+        }
+        result->cpu_utilization = busy / ((double)current_time * ctx->cores.num_cores) * 100;
+    }
+
+    if (ctx->out != NULL && ctx->format != REPORT_TEXT) {
+        if (status == 0) {
+            display_report_summary(&ctx->report, ctx->algorithm, ctx->time_quantum,
+                                   completed, state.peak_active, result);
+            if (state.group_ready != NULL) {
+                display_report_groups(&ctx->report, &ctx->groups, current_time);
+            }
+        }
+        report_end(&ctx->report);
+    } else if (ctx->out != NULL && status == 0) {
+        display_stream_summary(ctx->out, completed, state.peak_active, result,
+                               state.group_ready != NULL ? &ctx->groups : NULL);
+    }
+
+    if (status == 0) {
+        ctx->error = SIM_OK;
+    } else if (arena->failed) {
+        ctx->error = SIM_ERROR_MEMORY;
+    }
+    return status;
+}
+
+
+/*---------- FUNCTION: stream_cores ------------------------
+/  Function Description:
+/    The multi-core simulator behind stream_run, used when the 
+/    context has cores. Each pass places ready processes on the idle
+/    cores, as many cores at once as the gang mode has a process 
+/    take, lets a process that should run before one of those running
+/    take its cores (SRTF and PPS), then advances to the next 
+/    completion, time slice end or arrival on any core.
+/
+/  Caller Input:
+/    StreamState *state: the run, with the first process read ahead
+/    long long *end_time: set to the time the last process completed
+/    long long *idle: set to the time every core was idle
+/    long long *done: set to the number of processes completed
+/
+/  Caller Output:
+/    0 on success, 1 on bad input
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - fills in the result's core classes and gang usage; stream_run
+/      works out the rest of the summary
+/    - an arrival only interrupts the cores under SRTF and PPS, or 
+/      when a core is idle
+/---------------------------------------------------------*/
+int stream_cores(StreamState *state, long long *end_time, long long *idle, long long *done) {
+    SimResult *result = &state->ctx->result;
+    const CoreSet *set = &state->ctx->cores;
+    Core *cores = arena_alloc(state->ready.arena, set->num_cores * sizeof(Core));
+    int busy = 0;
+    long long current_time = 0;
+    long long idle_time = 0;
+    long long completed = 0;
+    double slowdown_sum = 0;
+    int status = 0;
+
+    if (cores == NULL) {
+        return 1;
+    }
+    cores_init(set, cores);
+    result->num_classes = set->num_classes;
+    for (int cls = 0; cls < set->num_classes; cls++) {
+        result->classes[cls].speed = set->speed[cls];
+        result->classes[cls].cores = set->count[cls];
+    }
+    result->gang.mode = set->gang;
+
+    while (status == 0 && (state->has_next || state->ready.count > 0 || busy > 0)) {
+        long long next_time = LLONG_MAX;
+        int c;
+        int to;
+        int width;
+
+        STAT_INC(steps);
+        if (busy == 0 && state->ready.count == 0) {
+            /* nothing to run: jump to the next arrival */
+            if (state->next.arrival_time > current_time) {
+                STAT_ADD(idle_skipped, state->next.arrival_time - current_time);
+                idle_time += state->next.arrival_time - current_time;
+                current_time = state->next.arrival_time;
+            }
+            if (stream_admit(state, current_time) != 0) {
+                status = 1;
+                break;
+            }
+        }
+
+        while (state->ready.count > 0 && busy < set->num_cores) {
+            width = stream_core_width(state, stream_peek(state), set->num_cores - busy);
+            if (width > 0) {
+                Process process = stream_pop(state);
+
+                stream_core_start(state, cores, core_pick(set, cores, process.core), &process, width, current_time);
+            } else if (set->gang != GANG_BACKFILL ||
+                       (width = stream_backfill(state, cores, set->num_cores - busy, current_time)) == 0) {
+                break;
+            }
+            busy += width;
+            STAT_INC(events);
+        }
+        /* only the big placement moves a process that is running; it carries on, not dispatched again.
+           A core left idle with processes waiting is kept for them */
+        while (state->ready.count == 0 && (c = core_promote(set, cores, &to)) >= 0) {
+            Process process;
+
+            stream_core_stop(state, cores, c, current_time);
+            if (stream_push(state, &cores[c].running, state->round_robin ? state->rr_seq++ : cores[c].running.index) != 0) {
+                status = 1;
+                break;
+            }
+            process = stream_pop(state);
+            process.core = to;
+            result->switches.migrations++;
+            cores[to].last_index = process.index;
+            stream_core_start(state, cores, to, &process, 1, current_time);
+            STAT_INC(events);
+        }
+        while (state->preemptive && state->ready.count > 0 && busy > 0) {
+            ReadyEntry last;
+            Process process;
+
+            c = stream_core_victim(state, cores, current_time, &last);
+            if (!entry_before(&state->ready.heap[0], &last)) break;
+            width = stream_core_width(state, &state->ready.heap[0].process, set->num_cores - busy + cores[c].width);
+            if (width == 0) break;
+
+            busy -= cores[c].width;
+            stream_core_stop(state, cores, c, current_time);
+            cores[c].running.preemptions++;
+            if (stream_push(state, &cores[c].running, cores[c].running.index) != 0) {
+                status = 1;
+                break;
+            }
+            process = stream_pop(state);
+            stream_core_start(state, cores, core_pick(set, cores, process.core), &process, width, current_time);
+            busy += width;
+            STAT_INC(events);
+        }
+        if (state->ready.count + busy > state->peak_active) {
+            state->peak_active = state->ready.count + busy;
+        }
+
+        for (c = 0; c < set->num_cores; c++) {
+            if (cores[c].lead == c && cores[c].until < next_time) next_time = cores[c].until;
+        }
+        if (state->has_next && (state->preemptive || busy < set->num_cores) &&
+            state->next.arrival_time < next_time) {
+            next_time = state->next.arrival_time;
+        }
+        if (state->ready.count > 0 && busy < set->num_cores) {
+            result->gang.fragmentation_time += (set->num_cores - busy) * (next_time - current_time);
+        }
+        current_time = next_time;
+
+        if (stream_admit(state, current_time) != 0) {
+            status = 1;
+            break;
+        }
+
+        for (c = 0; c < set->num_cores; c++) {
+            Core *core = &cores[c];
+
+            if (core->lead != c || core->until != current_time) continue;
+            stream_core_progress(state, cores, c, current_time);
+            if (core->running.remaining_time > 0 && state->ready.count == 0 &&
+                stream_core_width(state, &core->running, set->num_cores - busy + core->width) == core->width) {
+                /* the time slice ended (RR) with nothing waiting: the process keeps its cores for another */
+                quantum_add(&state->quantum, core->running.remaining_time);
+                stream_core_slice(state, core, current_time);
+                continue;
+            }
+            busy -= core->width;
+            stream_core_stop(state, cores, c, current_time);
+            if (core->running.remaining_time == 0) {
+                CoreUsage *usage = &result->classes[core->cls];
+                long long ideal = core_time(core->running.burst_time, 0, set->speed[0]);
+                double slowdown;
+
+                stream_complete(state, &core->running, current_time);
+                usage->completed++;
+                usage->turnaround_sum += core->running.turnaround_time;
+                completed++;
+                STAT_INC(events);
+
+                slowdown = (double)core->running.turnaround_time / (ideal > 1 ? ideal : 1);
+                slowdown_sum += slowdown;
+                if (slowdown > result->gang.slowdown_max) result->gang.slowdown_max = slowdown;
+            } else if (state->ready.count == 0) {
+                /* it keeps its core, and takes more that have come free */
+                Process process;
+
+                if (stream_push(state, &core->running, state->rr_seq++) != 0) {
+                    status = 1;
+                    break;
+                }
+                process = stream_pop(state);
+                core->last_index = process.index;
+                width = stream_core_width(state, &process, set->num_cores - busy);
+                stream_core_start(state, cores, c, &process, width, current_time);
+                busy += width;
+            } else {
+                /* arrivals during the slice join the queue ahead of it */
+                core->running.expirations++;
+                if (stream_push(state, &core->running, state->rr_seq++) != 0) {
+                    status = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (set->gang == GANG_NONE) {
+        result->gang.slowdown_max = 0;
+    } else if (completed > 0) {
+        result->gang.slowdown_mean = slowdown_sum / completed;
+    }
+    arena_release(state->ready.arena, cores);
+    *end_time = current_time;
+    *idle = idle_time;
+    *done = completed;
+    return status;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions put processes on the cores of a multi-core run 
+/    and take them off.
+/
+/  Functions and Their Purpose:
+/    - stream_core_width: The number of cores a process starts on, 
+/      given that free cores are idle: one per thread, but under the
+/      relaxed gang mode as few as 1. 0 if it cannot start.
+/    - stream_core_start: Puts a process on core c and width - 1 more
+/      idle cores chosen by the placement, until it would complete, or
+/      for RR until its time slice ends. It is counted as dispatched 
+/      (and migrated, if it last ran on another lead core) unless it 
+/      was the last process on core c. A process moved up by the big
+/      placement is counted as migrated by the caller, and carries on
+/      rather than being dispatched.
+/    - stream_core_slice: Sets when the process on a core, as of 
+/      current_time, completes or for RR ends its time slice. A time 
+/      slice is stretched to at least one unit of work.
+/    - stream_core_stop: Takes the process off lead core c and the 
+/      others it runs on, through stream_core_progress. The process is
+/      left in the lead core's running field, and the cores forget it,
+/      so that it is dispatched when it next starts unless the caller
+/      says otherwise through last_index.
+/    - stream_core_progress: Brings the process on lead core c up to
+/      current_time, keeping the whole units of work it did and 
+/      carrying the part of a unit over, and adds the time to the 
+/      cores' classes. A process whose time slice ends with nothing
+/      waiting carries on from here, with its slice set again.
+/    - stream_core_victim: The lead core of the process that should 
+/      run last, and that process's ready-set entry as of 
+/      current_time, or -1 if no core is busy.
+/    - stream_backfill: Under the backfill gang mode, when the first
+/      ready process cannot start, starts the first of the next 
+/      BACKFILL_DEPTH ready processes that fits in the free cores and 
+/      would not delay it: one that will be done, even on the slowest
+/      idle core, before enough cores free up for the first, or that 
+/      leaves that many cores free then. Returns the number of cores 
+/      it took, or 0 if none could start.
+/
+/  Input Parameters:
+/    - StreamState *state: the run
+/    - Core cores[]: the run's cores
+/    - int c: the lead core
+/    - Process *process: the process
+/    - int free: the number of idle cores
+/    - int width: the number of cores to start the process on
+/    - long long current_time: the simulated time
+/    - ReadyEntry *entry: filled in by stream_core_victim
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - stream_core_start assumes core c and enough others are idle
+/    - stream_backfill takes the running processes to free their 
+/      cores at the end of their time slices, although under RR they 
+/      may take them again
+/------------------------------------------------------------------------*/
+int stream_core_width(StreamState *state, Process *process, int free) {
+    int gang = state->ctx->cores.gang;
+    int need = gang == GANG_STRICT || gang == GANG_BACKFILL ? process->threads : 1;
+
+    if (free < need) return 0;
+    return process->threads < free ? process->threads : free;
+}
+
+void stream_core_start(StreamState *state, Core cores[], int c, Process *process, int width, long long current_time) {
+    Core *core = &cores[c];
+    SimResult *result = &state->ctx->result;
+    CoreUsage *usage = &result->classes[core->cls];
+    double rate = core->speed;
+    int member = c;
+
+    if (core->last_index != process->index) {
+        process->dispatches++;
+        if (process->core >= 0 && process->core != c) result->switches.migrations++;
+        process->core = c;
+    }
+    if (!process->has_started) {
+        process->has_started = 1;
+        process->start_time = current_time;
+        process->response_time = current_time - process->arrival_time;
+        usage->started++;
+        usage->response_sum += process->response_time;
+    }
+
+    for (int k = 0; k < width; k++) {
+        if (k > 0) member = core_pick(&state->ctx->cores, cores, -1);
+        if (cores[member].last_index != process->index) {
+            result->classes[cores[member].cls].dispatches++;
+            cores[member].last_index = process->index;
+        }
+        cores[member].has_running = 1;
+        cores[member].lead = c;
+        cores[member].since = current_time;
+        if (cores[member].speed < rate) rate = cores[member].speed;
+    }
+    /* threads without a core of their own share one */
+    if (width < process->threads) rate = rate * width / process->threads;
+
+    core->running = *process;
+    core->width = width;
+    core->rate = rate;
+    stream_core_slice(state, core, current_time);
+}
+
+void stream_core_slice(StreamState *state, Core *core, long long current_time) {
+    const Process *process = &core->running;
+
+    core->until = current_time + core_time(process->remaining_time, process->work_carried, core->rate);
+    if (state->round_robin) {
+        long long slice = quantum_next(&state->quantum);
+        long long least = core_time(1, process->work_carried, core->rate);
+
+        quantum_remove(&state->quantum, process->remaining_time);
+        if (slice < least) slice = least;
+        if (core->until > current_time + slice) core->until = current_time + slice;
+    }
+}
+
+void stream_core_stop(StreamState *state, Core cores[], int c, long long current_time) {
+    stream_core_progress(state, cores, c, current_time);
+    for (int k = cores[c].width > 1 ? 0 : c; k < state->ctx->cores.num_cores; k++) {
+        if (cores[k].lead != c) continue;
+        cores[k].has_running = 0;
+        cores[k].lead = -1;
+        cores[k].last_index = -1;
+        if (cores[c].width == 1) break;
+    }
+}
+
+void stream_core_progress(StreamState *state, Core cores[], int c, long long current_time) {
+    Core *core = &cores[c];
+    Process *process = &core->running;
+    CoreUsage *classes = state->ctx->result.classes;
+    double done = process->work_carried + (double)(current_time - core->since) * core->rate;
+    long long work = core_work(current_time - core->since, process->work_carried, core->rate);
+
+    if (work >= process->remaining_time) {
+        work = process->remaining_time;
+        process->work_carried = 0;
+    } else if (core->rate != 1) {
+        process->work_carried = done - work > 0 ? done - work : 0;
+    }
+    process->remaining_time -= work;
+
+    for (int k = core->width > 1 ? 0 : c; k < state->ctx->cores.num_cores; k++) {
+        if (cores[k].lead != c) continue;
+        classes[cores[k].cls].busy_time += current_time - cores[k].since;
+        cores[k].since = current_time;
+        if (core->width == 1) break;
+    }
+}
+
+int stream_core_victim(StreamState *state, Core cores[], long long current_time, ReadyEntry *entry) {
+    int victim = -1;
+
+    for (int c = 0; c < state->ctx->cores.num_cores; c++) {
+        Process running = cores[c].running;
+        ReadyEntry current;
+        long long work;
+
+        if (cores[c].lead != c) continue;
+        work = core_work(current_time - cores[c].since, running.work_carried, cores[c].rate);
+        running.remaining_time -= work < running.remaining_time ? work : running.remaining_time;
+        current.key = stream_key(state, &running);
+        current.seq = running.index;
+        if (victim == -1 || entry_before(entry, &current)) {
+            *entry = current;
+            victim = c;
+        }
+    }
+    return victim;
+}
+
+int stream_backfill(StreamState *state, Core cores[], int free, long long current_time) {
+    const CoreSet *set = &state->ctx->cores;
+    long long ends[MAX_CORES];
+    int num_ends = 0;
+    int avail = free;
+    int need = stream_peek(state)->threads;
+    long long shadow = LLONG_MAX;
+    int extra = 0;
+    double slowest = 0;
+    int depth = state->ready.count < BACKFILL_DEPTH ? state->ready.count : BACKFILL_DEPTH;
+
+    for (int c = 0; c < set->num_cores; c++) {
+        if (cores[c].has_running) {
+            ends[num_ends++] = cores[cores[c].lead].until;
+        } else if (slowest == 0 || cores[c].speed < slowest) {
+            slowest = cores[c].speed;
+        }
+    }
+    /* the first ready process's reservation: when enough cores will be idle, and how many spare */
+    qsort(ends, num_ends, sizeof(long long), compare_end);
+    for (int k = 0; k < num_ends && shadow == LLONG_MAX; k++) {
+        avail++;
+        if (avail >= need && (k + 1 == num_ends || ends[k + 1] > ends[k])) {
+            shadow = ends[k];
+            extra = avail - need;
+        }
+    }
+
+    for (int i = 1; i < depth; i++) {
+        Process *process = stream_at(state, i);
+        int width = stream_core_width(state, process, free);
+        Process taken;
+
+        if (width == 0) continue;
+        if (current_time + core_time(process->remaining_time, process->work_carried, slowest) > shadow &&
+            width > extra) continue;
+
+        taken = stream_take(&state->ready, i);
+        stream_core_start(state, cores, core_pick(set, cores, taken.core), &taken, width, current_time);
+        state->ctx->result.gang.backfilled++;
+        return width;
+    }
+    return 0;
+}
+
+/*---------- FUNCTION: compare_end -------------------------
+/  Function Description:
+/    Orders the end times of the processes on the cores for qsort.
+/
+/  Caller Input:
+/    const void *a, *b: pointers to the long long times
+/
+/  Caller Output:
+/    Negative, 0 or positive as a is before, at or after b
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+int compare_end(const void *a, const void *b) {
+    long long x = *(const long long *)a;
+    long long y = *(const long long *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions feed processes from the input stream into the
+/    ready set and retire them once they complete.
+/
+/  Functions and Their Purpose:
+/    - stream_read_next: Reads the next process into state->next,
+/      checking that arrivals are in order. Returns 1 on bad input.
+/    - stream_read_line: Reads a text line for stream_read_next when
+/      a cache model, gang mode or groups are set, as the algorithm's
+/      columns and then an optional extra one, as text: the process's
+/      working set, which replaces the model's, its number of threads,
+/      or its group. extra is left empty if the line has none. Returns
+/      the number of the algorithm's columns read, 0 if the line does
+/      not fit, or EOF.
+/    - stream_admit: Moves every process that has arrived by
+/      current_time into the ready set. Returns 1 on bad input.
+/    - stream_key: The algorithm's ordering key for a process.
+/    - stream_decide: Charges the decision that just took a process
+/      from the ready set under the context's decision cost model, 
+/      advancing current_time by the whole time units owed and 
+/      admitting what arrives meanwhile. Returns 1 on bad input.
+/    - stream_preempts: 1 if the algorithm is preemptive and the 
+/      ready set (with groups, that of its group) holds a process 
+/      that should run before process.
+/    - stream_complete: Fills in a finished process's metrics, adds
+/      them and its switch counts to the running totals and writes 
+/      its row.
+/    - stream_switch_out: Records the cache warmth of a process that
+/      is switched away. The part of its refill it has not paid is 
+/      dropped: that part of its working set is still missing, and is
+/      owed again when it next runs.
+/    - summary_add: Adds the n-th value to a MetricSummary, updating
+/      the mean and variance with Welford's method.
+/    - stream_title: The full name of an algorithm, or NULL if unknown.
+/    - stream_window_to: Feeds the window series up to time, with the 
+/      CPU busy or idle as set by window_running and the ready set's 
+/      current size as the queue length.
+/
+/  Input Parameters:
+/    - StreamState *state: the run
+/    - long long current_time: the simulated time (for stream_decide, 
+/      a pointer to it)
+/    - Process *process: the process in question
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - errors are printed to stderr
+/    - a decision is made between the processes in the ready set and 
+/      the one taken from it; the time it takes counts as busy
+/    - lines longer than 255 characters are split by stream_read_line
+/------------------------------------------------------------------------*/
+int stream_read_next(StreamState *state) {
+    char temp_id[10];
+    long long arrival, burst;
+    int priority = -1;
+    char extra[GROUP_NAME_LENGTH] = "";
+    long number = -1;
+    int threads = 1;
+    int group = 0;
+    int vals_read;
+
+    STAT_TIMER_START(parse);
+    if (state->workload != NULL) {
+        const Workload *workload = state->workload;
+        long long i = state->num_read;
+
+        vals_read = EOF;
+        if (i < workload->count) {
+            vals_read = 0;
+            if (workload->id[i] < workload->num_ids) {
+                memcpy(temp_id, workload->ids[workload->id[i]], sizeof(temp_id));
+                temp_id[sizeof(temp_id) - 1] = '\0';
+                arrival = workload->arrival[i];
+                burst = workload->burst[i];
+                if (workload->has_priority) priority = workload->priority[i];
+                vals_read = state->with_priority ? 4 : 3;
+            }
+        }
+    } else if (state->ctx->cache.enabled || state->ctx->cores.gang != GANG_NONE || state->group_ready != NULL) {
+        vals_read = stream_read_line(state, temp_id, &arrival, &burst, &priority, extra);
+    } else if (state->with_priority) {
+        vals_read = fscanf(state->in, "%9s %lld %lld %d", temp_id, &arrival, &burst, &priority);
+    } else {
+        vals_read = fscanf(state->in, "%9s %lld %lld", temp_id, &arrival, &burst);
+    }
+    STAT_TIMER_STOP(parse);
+
+    if (vals_read == EOF) {
+        state->has_next = 0;
+        return 0;
+    }
+    if (extra[0] != '\0' && state->group_ready == NULL) {
+        char *end;
+
+        number = strtol(extra, &end, 10);
+        if (*end != '\0' || number < 0 || number > INT_MAX) vals_read = 0;
+    }
+    if (state->ctx->cores.gang != GANG_NONE && number != -1) threads = (int)number;
+    if (vals_read < 3 || arrival < 0 || burst < 0 || threads < 1) {
+        fprintf(stderr, "Error: malformed process on line %d.\n", state->num_read + 1);
+        state->has_next = 0;
+        return 1;
+    }
+    if ((state->ctx->cores.gang == GANG_STRICT || state->ctx->cores.gang == GANG_BACKFILL) &&
+        threads > state->ctx->cores.num_cores) {
+        fprintf(stderr, "Error: process %s needs %d threads, but there are only %d cores.\n",
+                temp_id, threads, state->ctx->cores.num_cores);
+        state->has_next = 0;
+        return 1;
+    }
+    if (state->group_ready != NULL) {
+        /* a line without a group is in the root, which only holds processes when it is the only group */
+        group = group_find(&state->ctx->groups, extra[0] != '\0' ? extra : "/");
+        if (group < 0 || state->ctx->groups.group[group].size > 1) {
+            fprintf(stderr, "Error: process %s is not in a group at the bottom of the group tree.\n", temp_id);
+            state->has_next = 0;
+            return 1;
+        }
+    }
+    if (state->num_read > 0 && arrival < state->next.arrival_time) {
+        fprintf(stderr, "Error: process %s arrives before the process on the line above it. "
+                "Streaming input must be sorted by arrival time.\n", temp_id);
+        state->has_next = 0;
+        return 1;
+    }
+
+    strcpy(state->next.id, temp_id);
+    state->next.arrival_time = arrival;
+    state->next.burst_time = burst;
+    state->next.priority = (vals_read == 3) ? -1 : priority;
+    reset_process(&state->next, state->num_read);
+    state->next.working_set = state->ctx->cache.enabled && number != -1 ? (int)number : state->ctx->cache.working_set;
+    state->next.threads = threads;
+    state->next.group = group;
+    state->num_read++;
+    state->has_next = 1;
+    return 0;
+}
+
+int stream_read_line(StreamState *state, char *id, long long *arrival, long long *burst,
+                     int *priority, char *extra) {
+    char line[256];
+    char rest[2];
+    int vals_read;
+
+    do {
+        if (fgets(line, sizeof(line), state->in) == NULL) return EOF;
+    } while (line[strspn(line, " \t\r\n")] == '\0');
+
+    if (state->with_priority) {
+        vals_read = sscanf(line, "%9s %lld %lld %d %31s %1s", id, arrival, burst, priority, extra, rest);
+        if (vals_read == 3 || vals_read > 5) return 0;
+        if (vals_read == 5) vals_read = 4;
+    } else {
+        vals_read = sscanf(line, "%9s %lld %lld %31s %1s", id, arrival, burst, extra, rest);
+        if (vals_read > 4) return 0;
+        if (vals_read == 4) vals_read = 3;
+    }
+    if (vals_read == EOF) return 0;
+    return vals_read;
+}
+
+int stream_admit(StreamState *state, long long current_time) {
+    while (state->has_next && state->next.arrival_time <= current_time) {
+        stream_window_to(state, state->next.arrival_time);
+        trace_arrival(&state->trace, &state->next, state->next.index + 1);
+        if (state->group_ready != NULL) {
+            group_arrive(&state->ctx->groups, state->next.group, state->next.arrival_time);
+        }
+        if (stream_push(state, &state->next, state->round_robin ? state->rr_seq++ : state->next.index) != 0 ||
+            stream_read_next(state) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+long long stream_key(StreamState *state, Process *process) {
+    const char *algorithm = state->ctx->algorithm;
+
+    if (strcmp(algorithm, "SJF") == 0) return process->burst_time;
+    if (strcmp(algorithm, "SRTF") == 0) return process->remaining_time;
+    if (state->with_priority) return process->priority;
+    return 0;
+}
+
+int stream_decide(StreamState *state, long long *current_time) {
+    SimResult *result = &state->ctx->result;
+    long long charge;
+
+    state->overhead += decision_cost(&state->ctx->decision_cost, state->ready.count + 1);
+    result->decisions++;
+    charge = (long long)state->overhead - result->overhead_time;
+    if (charge <= 0) return 0;
+
+    result->overhead_time += charge;
+    *current_time += charge;
+    if (stream_admit(state, *current_time) != 0) {
+        return 1;
+    }
+    if (state->ready.count + 1 > state->peak_active) {
+        state->peak_active = state->ready.count + 1;
+    }
+    return 0;
+}
+
+int stream_preempts(StreamState *state, Process *running) {
+    ReadySet *ready = state->group_ready != NULL ? &state->group_ready[running->group] : &state->ready;
+    ReadyEntry current;
+
+    if (!state->preemptive || ready->count == 0) return 0;
+    current.key = stream_key(state, running);
+    current.seq = running->index;
+    return entry_before(&ready->heap[0], &current);
+}
+
+void stream_complete(StreamState *state, Process *process, long long current_time) {
+    SimResult *result = &state->ctx->result;
+    long long n = result->latency.turnaround.count + 1;
+
+    process->completion_time = current_time;
+    process->turnaround_time = current_time - process->arrival_time;
+    process->waiting_time = process->turnaround_time - process->burst_time;
+
+    add_switches(&result->switches, process);
+    summary_add(&result->turnaround, &state->m2[0], n, process->turnaround_time);
+    summary_add(&result->waiting, &state->m2[1], n, process->waiting_time);
+    summary_add(&result->response, &state->m2[2], n, process->response_time);
+    record_latency(&result->latency, process);
+    if (state->group_ready != NULL) {
+        group_complete(&state->ctx->groups, process->group, process->waiting_time, process->turnaround_time);
+    }
+    window_complete(&state->windows, current_time, process->waiting_time);
+
+    if (state->ctx->out != NULL && state->ctx->format != REPORT_TEXT) {
+        display_report_process(&state->ctx->report, process);
+    } else if (state->ctx->out != NULL) {
+        display_stream_row(state->ctx->out, process);
+    }
+}
+
+void stream_switch_out(StreamState *state, Process *process, long long busy) {
+    cache_leave(&state->ctx->cache, process, state->refill_due, busy);
+    state->refill_due = 0;
+}
+
+void summary_add(MetricSummary *summary, double *m2, long long n, long long x) {
+    double delta = x - summary->mean;
+
+    if (n == 1 || x < summary->min) summary->min = x;
+    if (n == 1 || x > summary->max) summary->max = x;
+    summary->sum += x;
+    summary->mean += delta / n;
+    *m2 += delta * (x - summary->mean);
+}
+
+void stream_window_to(StreamState *state, long long time) {
+    if (time > state->window_time) {
+        window_advance(&state->windows, state->window_time, time, state->window_running, state->ready.count);
+        state->window_time = time;
+    }
+}
+
+const char *stream_title(const char *algorithm) {
+    if (strcmp(algorithm, "FCFS") == 0) return "FCFS (First Come First Served)";
+    if (strcmp(algorithm, "SJF") == 0) return "SJF (Shortest Job First)";
+    if (strcmp(algorithm, "SRTF") == 0) return "SRTF (Shortest Remaining Time First)";
+    if (strcmp(algorithm, "RR") == 0) return "RR (Round Robin)";
+    if (strcmp(algorithm, "PS") == 0) return "Priority Scheduling";
+    if (strcmp(algorithm, "PPS") == 0) return "PP (Preemptive Priority)";
+    return NULL;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions maintain the ready set as a binary min-heap, or 
+/    as a FIFO ring buffer where that gives the same order.
+/
+/  Functions and Their Purpose:
+/    - stream_push: Adds a process to the ready set (with groups, that
+/      of its group), and for RR tells the time slice policy. A full 
+/      ring buffer is unwrapped into the new space as it grows. 
+/      Returns 0, or 1 if the ready set could not be grown.
+/    - stream_pop: Removes and returns the process that should run next.
+/    - stream_pop_group: Removes and returns the process of group g
+/      that should run next.
+/    - stream_peek: The process that should run next, left in place.
+/    - stream_at: The i-th process of the ready set, left in place: 
+/      the i-th in line for a ring buffer, but for a heap only roughly
+/      so, the heap being kept in array order.
+/    - stream_take: Removes and returns the i-th process of a ready 
+/      set, as numbered by stream_at.
+/    - entry_before: 1 if entry a should run before entry b.
+/
+/  Input Parameters:
+/    - StreamState *state: the run
+/    - Process *process: the process to add
+/    - long long seq: its tie-breaker
+/    - ReadySet *ready: the ready set
+/    - int g: a group at the bottom of the tree, with processes ready
+/    - int i: the position in the ready set, below its count
+/    - ReadyEntry *a, *b: the entries to compare
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - stream_pop and stream_peek assume the ready set is not empty,
+/      and are not used with groups
+/    - stream_take shifts the ring buffer entries ahead of i along
+/    - a process that stream_push could not add is left out of the
+/      ready set, with nothing else changed
+/------------------------------------------------------------------------*/
+int stream_push(StreamState *state, Process *process, long long seq) {
+    ReadySet *ready = &state->ready;
+    int i;
+
+    if (state->group_ready != NULL) {
+        ready = &state->group_ready[process->group];
+    }
+    if (ready->count == ready->capacity) {
+        int capacity = ready->capacity ? ready->capacity * 2 : READY_INITIAL_CAPACITY;
+        ReadyEntry *heap = arena_grow(ready->arena, ready->heap,
+                                      ready->capacity * sizeof(ReadyEntry),
+                                      capacity * sizeof(ReadyEntry));
+
+        if (heap == NULL) {
+            return 1;
+        }
+        ready->heap = heap;
+        if (ready->fifo && ready->head > 0) {
+            memcpy(&ready->heap[ready->capacity], &ready->heap[0], ready->head * sizeof(ReadyEntry));
+        }
+        ready->capacity = capacity;
+    }
+
+    STAT_INC(enqueues);
+    if (state->round_robin) {
+        quantum_add(&state->quantum, process->remaining_time);
+    }
+    if (state->group_ready != NULL) {
+        state->ready.count++;
+        group_join(&state->ctx->groups, process->group);
+    }
+
+    if (ready->fifo) {
+        i = (ready->head + ready->count++) % ready->capacity;
+        ready->heap[i].key = 0;
+        ready->heap[i].seq = seq;
+        ready->heap[i].process = *process;
+        return 0;
+    }
+
+    i = ready->count++;
+    ready->heap[i].key = stream_key(state, process);
+    ready->heap[i].seq = seq;
+    ready->heap[i].process = *process;
+
+    while (i > 0 && entry_before(&ready->heap[i], &ready->heap[(i - 1) / 2])) {
+        ReadyEntry temp = ready->heap[i];
+        ready->heap[i] = ready->heap[(i - 1) / 2];
+        ready->heap[(i - 1) / 2] = temp;
+        i = (i - 1) / 2;
+    }
+    return 0;
+}
+
+Process stream_pop(StreamState *state) {
+    return stream_take(&state->ready, 0);
+}
+
+Process stream_pop_group(StreamState *state, int g) {
+    state->ready.count--;
+    group_leave(&state->ctx->groups, g);
+    return stream_take(&state->group_ready[g], 0);
+}
+
+Process stream_take(ReadySet *ready, int i) {
+    Process taken;
+
+    STAT_INC(dequeues);
+    if (ready->fifo) {
+        taken = ready->heap[(ready->head + i) % ready->capacity].process;
+        for (; i > 0; i--) {
+            ready->heap[(ready->head + i) % ready->capacity] = ready->heap[(ready->head + i - 1) % ready->capacity];
+        }
+        ready->head = (ready->head + 1) % ready->capacity;
+        ready->count--;
+        return taken;
+    }
+
+    taken = ready->heap[i].process;
+    ready->heap[i] = ready->heap[--ready->count];
+    if (i == ready->count) return taken;
+
+    while (i > 0 && entry_before(&ready->heap[i], &ready->heap[(i - 1) / 2])) {
+        ReadyEntry temp = ready->heap[i];
+        ready->heap[i] = ready->heap[(i - 1) / 2];
+        ready->heap[(i - 1) / 2] = temp;
+        i = (i - 1) / 2;
+    }
+    for (;;) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+
+        if (left < ready->count && entry_before(&ready->heap[left], &ready->heap[smallest])) smallest = left;
+        if (right < ready->count && entry_before(&ready->heap[right], &ready->heap[smallest])) smallest = right;
+        if (smallest == i) break;
+
+        ReadyEntry temp = ready->heap[i];
+        ready->heap[i] = ready->heap[smallest];
+        ready->heap[smallest] = temp;
+        i = smallest;
+    }
+
+    return taken;
+}
+
+Process *stream_peek(StreamState *state) {
+    ReadySet *ready = &state->ready;
+
+    return &ready->heap[ready->fifo ? ready->head : 0].process;
+}
+
+Process *stream_at(StreamState *state, int i) {
+    ReadySet *ready = &state->ready;
+
+    return &ready->heap[ready->fifo ? (ready->head + i) % ready->capacity : i].process;
+}
+
+int entry_before(ReadyEntry *a, ReadyEntry *b) {
+    STAT_INC(comparisons);
+    if (a->key != b->key) return a->key < b->key;
+    return a->seq < b->seq;
+}
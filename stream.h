@@ -0,0 +1,83 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   stream.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdio.h>
+#include "process.h"
+#include "simulator.h"
+#include "arena.h"
+#include "workload.h"
+
+/*---------- STRUCTURE: ReadyEntry -------------------------
+/  Structure Description:
+/    A process waiting in the streaming simulator's ready set, along
+/    with the values it is ordered by.
+/
+/  Fields:
+/    long long key
+/      The algorithm's ordering key (burst, remaining time or
+/      priority; 0 for FCFS and RR)
+/    long long seq
+/      Tie-breaker: the process's input position, or for RR the
+/      order in which it joined the ready queue
+/    Process process
+/      The waiting process
+/
+/  Relationships:
+/    - stored in the heap of a ReadySet
+/---------------------------------------------------------*/
+typedef struct {
+    long long key;
+    long long seq;
+    Process process;
+} ReadyEntry;
+
+/*---------- STRUCTURE: ReadySet ---------------------------
+/  Structure Description:
+/    A growable set of ReadyEntries, ordered by key and then seq. It
+/    is a binary min-heap, unless every entry is added in order (FCFS
+/    and RR, whose key is always 0 and whose seq only grows), when it
+/    is a ring buffer used as a FIFO queue, so that adding and taking
+/    an entry cost O(1) rather than O(log n). Only processes that have
+/    arrived and not completed are held, so its size follows the
+/    number of active processes.
+/
+/  Fields:
+/    ReadyEntry *heap
+/      Array of entries
+/    int count
+/      Number of entries in use
+/    int capacity
+/      Number of entries allocated
+/    int fifo
+/      1 if the array is a ring buffer rather than a heap
+/    int head
+/      Position of the first entry of the ring buffer
+/    Arena *arena
+/      Where the array is allocated, or NULL for the heap
+/
+/  Relationships:
+/    - contains an array of ReadyEntry structs
+/---------------------------------------------------------*/
+typedef struct {
+    ReadyEntry *heap;
+    int count;
+    int capacity;
+    int fifo;
+    int head;
+    Arena *arena;
+} ReadySet;
+
+int sim_stream(SimContext *ctx, FILE *in);
+int sim_stream_workload(SimContext *ctx, const Workload *workload);
+
+#endif
@@ -0,0 +1,675 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   sweep.c
+/
+/  File Description:
+/    This file implements the sweep executor, which runs a grid of
+/    algorithms x time quanta x load levels x seeds across forked
+/    worker processes. Unlike the ensemble's threads, each worker has
+/    its own address space and allocator, so the largest sweeps scale
+/    with the number of cores, and a worker that crashes takes only
+/    its own shard down.
+/
+/    The grid points are numbered and cut into shards of consecutive
+/    points. The parent forks a worker per shard, keeping at most a
+/    set number alive, and each worker writes one fixed-size binary
+/    record per point down a pipe. The parent polls the pipes and
+/    copies each record into the slot for its point. When a worker
+/    exits, any points of its shard that did not arrive are handed to
+/    a new worker, up to a set number of attempts. Once every point
+/    has arrived, the seeds of each cell are merged into estimates.
+/
+/    A record is followed by the nonzero buckets of the run's latency
+/    histograms, which the parent merges into the cell's as the
+/    record arrives, so each cell's tail percentiles are taken over
+/    every process of every seed. A run's histograms seldom use more
+/    than a few hundred of their buckets, so sending only those keeps
+/    the pipes from carrying mostly zeros.
+/
+/    A point's result depends only on the point, so the table is the
+/    same whatever the number of workers, shard size or crashes.
+/
+/    For make check, setting SCHED_SWEEP_CRASH to a shard's number
+/    makes the first worker of that shard kill itself after sending
+/    its first record, so that the recovery is tested.
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "process.h"
+#include "globals.h"
+#include "simulator.h"
+#include "ensemble.h"
+#include "sweep.h"
+
+/*---------- STRUCTURE: SweepRecord ------------------------
+/  Structure Description:
+/    The result of one grid point, as written down a worker's pipe.
+/
+/  Fields:
+/    int point
+/      The grid point's number
+/    int status
+/      0 if the run succeeded, 1 if it failed
+/    double metrics[ENSEMBLE_METRICS]
+/      The run's metrics, as stored by ensemble_record
+/    int num_buckets
+/      The number of SweepBuckets written after the record
+/    long long min[3], max[3]
+/      The smallest and largest turnaround, waiting and response
+/      times of the run
+/
+/  Relationships:
+/    - written by sweep_child, read by run_sweep
+/---------------------------------------------------------*/
+typedef struct {
+    int point;
+    int status;
+    double metrics[ENSEMBLE_METRICS];
+    int num_buckets;
+    long long min[3];
+    long long max[3];
+} SweepRecord;
+
+/*---------- STRUCTURE: SweepBucket ------------------------
+/  Structure Description:
+/    One nonzero bucket of a run's latency histograms, as written
+/    down a worker's pipe after the run's record.
+/
+/  Fields:
+/    int histogram
+/      0 for turnaround, 1 for waiting and 2 for response times
+/    int bucket
+/      The bucket's index in the histogram
+/    unsigned long long count
+/      The bucket's count
+/
+/  Relationships:
+/    - written by sweep_child, read by run_sweep
+/---------------------------------------------------------*/
+typedef struct {
+    int histogram;
+    int bucket;
+    unsigned long long count;
+} SweepBucket;
+
+/*---------- STRUCTURE: SweepSlot --------------------------
+/  Structure Description:
+/    A running worker process, as seen by the parent.
+/
+/  Fields:
+/    pid_t pid
+/      The worker's process ID
+/    int fd
+/      The read end of the worker's pipe, or -1 if the slot is free
+/    int shard
+/      The shard the worker is running
+/    SweepRecord pending
+/      The record being read
+/    SweepBucket *buckets
+/      Room for the buckets that follow it
+/    size_t filled
+/      Bytes of pending, then of its buckets, read so far
+/
+/  Relationships:
+/    - one per concurrent worker in run_sweep
+/---------------------------------------------------------*/
+typedef struct {
+    pid_t pid;
+    int fd;
+    int shard;
+    SweepRecord pending;
+    SweepBucket *buckets;
+    size_t filled;
+} SweepSlot;
+
+int sweep_point_cell(SweepSpec *spec, int cell, char *algorithm, int *time_quantum, double *mean_gap);
+int sweep_launch(SweepSpec *spec, SweepSlot *slot, SweepSlot slots[], int num_slots,
+                 int shard, int first, int last, const unsigned char *received, int crash);
+void sweep_child(SweepSpec *spec, int fd, int first, int last, const unsigned char *received, int crash);
+int sweep_run_point(SweepSpec *spec, int point, double *sample, LatencyHistograms *latency);
+int sweep_pack(const LatencyHistograms *latency, SweepRecord *record, SweepBucket buckets[]);
+void sweep_unpack(const SweepRecord *record, const SweepBucket buckets[], LatencyHistograms *latency);
+int write_all(int fd, const void *buf, size_t size);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions describe a sweep.
+/
+/  Functions and Their Purpose:
+/    - init_sweep_spec: Sets a spec to its defaults: the ensemble
+/      defaults for the workload, a quantum of 1, a single load level
+/      equal to the default gap, one worker per CPU, shards chosen by
+/      run_sweep, and 3 attempts per shard.
+/    - sweep_num_cells: The number of cells in the grid. RR has one
+/      cell per quantum and load level, the other algorithms one per
+/      load level.
+/
+/  Input Parameters:
+/    - SweepSpec *spec: the sweep
+/
+/  Output:
+/    - sweep_num_cells returns the number of cells
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+void init_sweep_spec(SweepSpec *spec) {
+    memset(spec, 0, sizeof(SweepSpec));
+    init_ensemble_spec(&spec->base);
+    spec->num_quanta = 1;
+    spec->quanta[0] = 1;
+    spec->num_loads = 1;
+    spec->loads[0] = spec->base.mean_gap;
+    spec->workers = 0;
+    spec->shard_size = 0;
+    spec->max_attempts = 3;
+}
+
+int sweep_num_cells(SweepSpec *spec) {
+    int cells = 0;
+
+    for (int a = 0; a < spec->base.num_algorithms; a++) {
+        cells += strcmp(spec->base.algorithms[a], "RR") == 0 ? spec->num_quanta : 1;
+    }
+    return cells * spec->num_loads;
+}
+
+/*---------- FUNCTION: run_sweep ---------------------------
+/  Function Description:
+/    Runs every point of the sweep's grid on worker processes and
+/    merges the results into one estimate per cell, and the latency
+/    histograms of each cell's points into the cell's. Cells are
+/    ordered by algorithm, then quantum, then load level.
+/
+/  Caller Input:
+/    SweepSpec *spec: the sweep to run
+/    SweepCell cells[]: room for sweep_num_cells(spec) cells
+/    int *restarts: set to the number of shards that were restarted
+/      after a worker failed
+/
+/  Caller Output:
+/    0 on success, 1 on failure
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - errors are printed to stderr
+/    - fails if a shard has not completed after max_attempts workers,
+/      or if a run reports an error (which a retry cannot fix)
+/    - all output streams are flushed before the workers are forked,
+/      so that no buffered output is written twice
+/---------------------------------------------------------*/
+int run_sweep(SweepSpec *spec, SweepCell cells[], int *restarts) {
+    int seeds = spec->base.replications;
+    int num_cells = sweep_num_cells(spec);
+    int num_points = num_cells * seeds;
+    int shard_size = spec->shard_size;
+    int num_workers = spec->workers;
+    int num_shards, next_shard = 0, active = 0, done = 0, failed = 0;
+    int *queue, *attempts;
+    int queued = 0;
+    unsigned char *received;
+    double *samples;
+    SweepSlot *slots;
+    struct pollfd *fds;
+    LatencyHistograms *unpacked;
+    int no_buckets = 0;
+    const char *crash = getenv("SCHED_SWEEP_CRASH");
+    int crash_shard = crash != NULL ? atoi(crash) : -1;
+
+    *restarts = 0;
+    if (seeds < 2) {
+        fprintf(stderr, "Error: a sweep needs at least 2 seeds per cell.\n");
+        return 1;
+    }
+    if (num_cells < 1 || spec->num_loads < 1 || spec->num_quanta < 1) {
+        fprintf(stderr, "Error: the sweep's grid is empty.\n");
+        return 1;
+    }
+    for (int q = 0; q < spec->num_quanta; q++) {
+        if (spec->quanta[q] < 1) {
+            fprintf(stderr, "Error: time quantum must be at least 1.\n");
+            return 1;
+        }
+    }
+    for (int l = 0; l < spec->num_loads; l++) {
+        if (spec->loads[l] < 0) {
+            fprintf(stderr, "Error: invalid workload parameters.\n");
+            return 1;
+        }
+    }
+    if (spec->base.num_processes < 1 || spec->base.num_processes > ENSEMBLE_MAX_PROCESSES ||
+        spec->base.mean_burst < 1 || spec->base.max_priority < 1) {
+        fprintf(stderr, "Error: invalid workload parameters.\n");
+        return 1;
+    }
+
+    if (num_workers < 1) {
+        num_workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_workers < 1) num_workers = 1;
+    }
+    if (shard_size < 1) {
+        /* several shards per worker, so a lost shard costs little */
+        shard_size = num_points / (num_workers * 4);
+        if (shard_size < 1) shard_size = 1;
+    }
+    num_shards = (num_points + shard_size - 1) / shard_size;
+    if (num_workers > num_shards) num_workers = num_shards;
+
+    received = calloc(num_points, 1);
+    samples = malloc((size_t)num_points * ENSEMBLE_METRICS * sizeof(double));
+    queue = malloc((size_t)num_shards * spec->max_attempts * sizeof(int));
+    attempts = calloc(num_shards, sizeof(int));
+    slots = calloc(num_workers, sizeof(SweepSlot));
+    fds = malloc(num_workers * sizeof(struct pollfd));
+    unpacked = malloc(sizeof(LatencyHistograms));
+    for (int w = 0; slots != NULL && w < num_workers; w++) {
+        slots[w].fd = -1;
+        slots[w].buckets = malloc(3 * HIST_BUCKETS * sizeof(SweepBucket));
+        if (slots[w].buckets == NULL) no_buckets = 1;
+    }
+    if (!received || !samples || !queue || !attempts || !slots || !fds || !unpacked || no_buckets) {
+        fprintf(stderr, "Error: out of memory starting the sweep.\n");
+        for (int w = 0; slots != NULL && w < num_workers; w++) {
+            free(slots[w].buckets);
+        }
+        free(received);
+        free(samples);
+        free(queue);
+        free(attempts);
+        free(slots);
+        free(fds);
+        free(unpacked);
+        return 1;
+    }
+    for (int s = 0; s < num_shards; s++) {
+        queue[queued++] = s;
+    }
+    for (int c = 0; c < num_cells; c++) {
+        init_latency(&cells[c].latency);
+    }
+    fflush(NULL);
+
+    while (!failed && (next_shard < queued || active > 0)) {
+        int num_fds = 0;
+
+        /* fill the free slots with shards */
+        for (int w = 0; w < num_workers && next_shard < queued; w++) {
+            if (slots[w].fd >= 0) continue;
+            int shard = queue[next_shard];
+            int first = shard * shard_size;
+            int last = first + shard_size < num_points ? first + shard_size : num_points;
+
+            attempts[shard]++;
+            if (sweep_launch(spec, &slots[w], slots, num_workers, shard, first, last, received,
+                             shard == crash_shard && attempts[shard] == 1) != 0) {
+                failed = 1;
+                break;
+            }
+            next_shard++;
+            active++;
+        }
+        if (failed) break;
+
+        for (int w = 0; w < num_workers; w++) {
+            if (slots[w].fd < 0) continue;
+            fds[num_fds].fd = slots[w].fd;
+            fds[num_fds].events = POLLIN;
+            fds[num_fds].revents = 0;
+            num_fds++;
+        }
+        if (poll(fds, num_fds, -1) < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Error: could not wait for the sweep's workers.\n");
+            failed = 1;
+            break;
+        }
+
+        for (int w = 0, f = 0; w < num_workers; w++) {
+            SweepSlot *slot = &slots[w];
+            ssize_t got;
+
+            if (slot->fd < 0) continue;
+            if (fds[f++].revents == 0) continue;
+
+            if (slot->filled < sizeof(SweepRecord)) {
+                got = read(slot->fd, (char *)&slot->pending + slot->filled, sizeof(SweepRecord) - slot->filled);
+            } else {
+                size_t length = slot->pending.num_buckets * sizeof(SweepBucket) + sizeof(SweepRecord);
+                got = read(slot->fd, (char *)slot->buckets + (slot->filled - sizeof(SweepRecord)),
+                           length - slot->filled);
+            }
+            if (got < 0 && errno == EINTR) continue;
+
+            if (got > 0) {
+                SweepRecord *record = &slot->pending;
+
+                slot->filled += got;
+                if (slot->filled == sizeof(SweepRecord) &&
+                    (record->num_buckets < 0 || record->num_buckets > 3 * HIST_BUCKETS)) {
+                    fprintf(stderr, "Error: a sweep worker sent a bad record.\n");
+                    failed = 1;
+                    continue;
+                }
+                if (slot->filled == sizeof(SweepRecord) + record->num_buckets * sizeof(SweepBucket)) {
+                    slot->filled = 0;
+                    if (record->point < 0 || record->point >= num_points) continue;
+                    if (record->status != 0) {
+                        fprintf(stderr, "Error: a sweep run failed.\n");
+                        failed = 1;
+                        continue;
+                    }
+                    if (!received[record->point]) {
+                        memcpy(samples + (size_t)record->point * ENSEMBLE_METRICS, record->metrics,
+                               sizeof(record->metrics));
+                        sweep_unpack(record, slot->buckets, unpacked);
+                        merge_latency(&cells[record->point / seeds].latency, unpacked);
+                        received[record->point] = 1;
+                        done++;
+                    }
+                }
+                continue;
+            }
+
+            /* end of the pipe: the worker has finished or died */
+            {
+                int status = 0;
+                int first = slot->shard * shard_size;
+                int last = first + shard_size < num_points ? first + shard_size : num_points;
+                int complete = 1;
+
+                close(slot->fd);
+                slot->fd = -1;
+                active--;
+                waitpid(slot->pid, &status, 0);
+
+                for (int p = first; p < last; p++) {
+                    if (!received[p]) complete = 0;
+                }
+                if (complete) continue;
+
+                if (attempts[slot->shard] >= spec->max_attempts) {
+                    fprintf(stderr, "Error: shard %d of the sweep failed %d times", slot->shard, attempts[slot->shard]);
+                    if (WIFSIGNALED(status)) {
+                        fprintf(stderr, " (last worker killed by signal %d)", WTERMSIG(status));
+                    }
+                    fprintf(stderr, ".\n");
+                    failed = 1;
+                } else {
+                    queue[queued++] = slot->shard;
+                    (*restarts)++;
+                }
+            }
+        }
+    }
+
+    /* on failure, stop the workers that are still running */
+    for (int w = 0; w < num_workers; w++) {
+        if (slots[w].fd < 0) continue;
+        kill(slots[w].pid, SIGKILL);
+        close(slots[w].fd);
+        waitpid(slots[w].pid, NULL, 0);
+    }
+
+    if (!failed && done == num_points) {
+        for (int c = 0; c < num_cells; c++) {
+            sweep_point_cell(spec, c, cells[c].algorithm, &cells[c].time_quantum, &cells[c].mean_gap);
+            for (int m = 0; m < ENSEMBLE_METRICS; m++) {
+                ensemble_estimate(samples + (size_t)c * seeds * ENSEMBLE_METRICS + m, seeds, ENSEMBLE_METRICS,
+                                  &cells[c].metrics[m]);
+            }
+        }
+    } else {
+        failed = 1;
+    }
+
+    for (int w = 0; w < num_workers; w++) {
+        free(slots[w].buckets);
+    }
+    free(received);
+    free(samples);
+    free(queue);
+    free(attempts);
+    free(slots);
+    free(fds);
+    free(unpacked);
+    return failed;
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION: sweep_point_cell --------------------
+/  Function Description:
+/    Finds the algorithm, quantum and load level of a cell. Points
+/    are numbered cell by cell, so point p is seed p % seeds of cell
+/    p / seeds.
+/
+/  Caller Input:
+/    SweepSpec *spec: the sweep
+/    int cell: the cell's number
+/    char *algorithm: room for the algorithm's name
+/    int *time_quantum: set to the quantum (0 unless RR)
+/    double *mean_gap: set to the load level
+/
+/  Caller Output:
+/    0 on success, 1 if cell is out of range
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+int sweep_point_cell(SweepSpec *spec, int cell, char *algorithm, int *time_quantum, double *mean_gap) {
+    for (int a = 0; a < spec->base.num_algorithms; a++) {
+        int rr = strcmp(spec->base.algorithms[a], "RR") == 0;
+        int cells = (rr ? spec->num_quanta : 1) * spec->num_loads;
+
+        if (cell < cells) {
+            strcpy(algorithm, spec->base.algorithms[a]);
+            *time_quantum = rr ? spec->quanta[cell / spec->num_loads] : 0;
+            *mean_gap = spec->loads[cell % spec->num_loads];
+            return 0;
+        }
+        cell -= cells;
+    }
+    return 1;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions run a shard in a worker process.
+/
+/  Functions and Their Purpose:
+/    - sweep_launch: Forks a worker for a shard, connected to the
+/      slot by a pipe. The worker inherits the parent's record of
+/      which points have arrived, so a restarted shard only runs the
+/      points that were lost.
+/    - sweep_child: The worker's body. Runs each missing point of the
+/      shard and writes its record and buckets, then exits without
+/      returning.
+/    - sweep_run_point: Generates the workload of one point and runs
+/      it through the point's algorithm. Every cell uses the same
+/      seeds, so the cells are compared on the same workloads apart
+/      from their load level. The workload is allocated for the 
+/      point, as it may be too large for the stack.
+/    - sweep_pack: Stores the nonzero buckets of a run's histograms
+/      in buckets, and their number, minimums and maximums in the
+/      record. Returns the number of buckets.
+/    - sweep_unpack: Rebuilds the histograms from a record and its
+/      buckets.
+/    - write_all: Writes a buffer in full, retrying short writes.
+/
+/  Input Parameters:
+/    - SweepSpec *spec: the sweep
+/    - SweepSlot *slot: the free slot to start the worker in
+/    - SweepSlot slots[], int num_slots: every slot, whose pipes the
+/      worker closes
+/    - int shard: the shard to run
+/    - int first, int last: the shard's points, last exclusive
+/    - const unsigned char *received: which points have arrived
+/    - int crash: 1 for the worker to kill itself after its first
+/      record, as SCHED_SWEEP_CRASH asks
+/    - int fd: the write end of the worker's pipe
+/    - int point: a grid point
+/    - double *sample: where to store its metrics
+/    - LatencyHistograms *latency: a run's histograms
+/    - SweepRecord *record: the run's record
+/    - SweepBucket buckets[]: room for 3 * HIST_BUCKETS buckets
+/    - const void *buf, size_t size: the bytes to write
+/
+/  Output:
+/    - 0 on success, 1 on failure
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - a worker's arena and other memory are released by its exit
+/------------------------------------------------------------------------*/
+int sweep_launch(SweepSpec *spec, SweepSlot *slot, SweepSlot slots[], int num_slots,
+                 int shard, int first, int last, const unsigned char *received, int crash) {
+    int pipe_fds[2];
+    pid_t pid;
+
+    if (pipe(pipe_fds) != 0) {
+        fprintf(stderr, "Error: could not create a pipe for a sweep worker.\n");
+        return 1;
+    }
+
+    pid = fork();
+    if (pid < 0) {
+        fprintf(stderr, "Error: could not start a sweep worker.\n");
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+        return 1;
+    }
+
+    if (pid == 0) {
+        close(pipe_fds[0]);
+        for (int w = 0; w < num_slots; w++) {
+            if (slots[w].fd >= 0) close(slots[w].fd);
+        }
+        sweep_child(spec, pipe_fds[1], first, last, received, crash);
+    }
+
+    close(pipe_fds[1]);
+    slot->pid = pid;
+    slot->fd = pipe_fds[0];
+    slot->shard = shard;
+    slot->filled = 0;
+    return 0;
+}
+
+void sweep_child(SweepSpec *spec, int fd, int first, int last, const unsigned char *received, int crash) {
+    SweepBucket *buckets = malloc(3 * HIST_BUCKETS * sizeof(SweepBucket));
+    LatencyHistograms *latency = malloc(sizeof(LatencyHistograms));
+
+    if (buckets == NULL || latency == NULL) _exit(1);
+    for (int p = first; p < last; p++) {
+        SweepRecord record;
+
+        if (received[p]) continue;
+        memset(&record, 0, sizeof(SweepRecord));
+        record.point = p;
+        record.status = sweep_run_point(spec, p, record.metrics, latency);
+        if (record.status == 0) sweep_pack(latency, &record, buckets);
+        if (write_all(fd, &record, sizeof(SweepRecord)) != 0 ||
+            write_all(fd, buckets, record.num_buckets * sizeof(SweepBucket)) != 0) {
+            _exit(1);
+        }
+        if (crash) kill(getpid(), SIGKILL);
+    }
+
+    close(fd);
+    _exit(0);
+}
+
+int sweep_run_point(SweepSpec *spec, int point, double *sample, LatencyHistograms *latency) {
+    EnsembleSpec workload_spec = spec->base;
+    Process *processes;
+    SimContext ctx;
+    Rng rng;
+    int seeds = spec->base.replications;
+    int status;
+
+    init_sim_context(&ctx);
+    if (sweep_point_cell(spec, point / seeds, ctx.algorithm, &ctx.time_quantum, &workload_spec.mean_gap) != 0) {
+        return 1;
+    }
+    if (ctx.time_quantum < 1) ctx.time_quantum = 1;
+
+    processes = malloc(workload_spec.num_processes * sizeof(Process));
+    if (processes == NULL) {
+        fprintf(stderr, "Error: out of memory.\n");
+        return 1;
+    }
+    rng_seed(&rng, spec->base.seed, (unsigned long long)(point % seeds));
+    generate_workload(&rng, &workload_spec, processes);
+
+    ctx.processes = processes;
+    ctx.num_processes = workload_spec.num_processes;
+    status = sim_run(&ctx);
+    if (status == 0) {
+        ensemble_record(sample, &ctx.result);
+        *latency = ctx.result.latency;
+    }
+    free(processes);
+    return status;
+}
+
+int sweep_pack(const LatencyHistograms *latency, SweepRecord *record, SweepBucket buckets[]) {
+    const Histogram *hists[3] = {&latency->turnaround, &latency->waiting, &latency->response};
+    int n = 0;
+
+    for (int h = 0; h < 3; h++) {
+        record->min[h] = hists[h]->min;
+        record->max[h] = hists[h]->max;
+        for (int b = 0; b < HIST_BUCKETS; b++) {
+            if (hists[h]->counts[b] == 0) continue;
+            buckets[n].histogram = h;
+            buckets[n].bucket = b;
+            buckets[n].count = hists[h]->counts[b];
+            n++;
+        }
+    }
+    record->num_buckets = n;
+    return n;
+}
+
+void sweep_unpack(const SweepRecord *record, const SweepBucket buckets[], LatencyHistograms *latency) {
+    Histogram *hists[3] = {&latency->turnaround, &latency->waiting, &latency->response};
+
+    init_latency(latency);
+    for (int i = 0; i < record->num_buckets; i++) {
+        Histogram *hist;
+
+        if (buckets[i].histogram < 0 || buckets[i].histogram > 2 ||
+            buckets[i].bucket < 0 || buckets[i].bucket >= HIST_BUCKETS) continue;
+        hist = hists[buckets[i].histogram];
+        hist->counts[buckets[i].bucket] += buckets[i].count;
+        hist->count += buckets[i].count;
+    }
+    for (int h = 0; h < 3; h++) {
+        if (hists[h]->count == 0) continue;
+        hists[h]->min = record->min[h];
+        hists[h]->max = record->max[h];
+    }
+}
+
+int write_all(int fd, const void *buf, size_t size) {
+    const char *bytes = (const char *)buf;
+
+    while (size > 0) {
+        ssize_t wrote = write(fd, bytes, size);
+        if (wrote < 0) {
+            if (errno == EINTR) continue;
+            return 1;
+        }
+        bytes += wrote;
+        size -= wrote;
+    }
+    return 0;
+}
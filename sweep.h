@@ -0,0 +1,90 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   sweep.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "ensemble.h"
+
+#define SWEEP_MAX_VALUES 16
+
+/*---------- STRUCTURE: SweepSpec --------------------------
+/  Structure Description:
+/    Describes a parameter sweep: a grid of algorithms, RR time
+/    quanta and load levels, each cell of which is run on the same
+/    set of seeds, spread across worker processes.
+/
+/  Fields:
+/    EnsembleSpec base
+/      The workload shape, seed, algorithms and number of seeds per
+/      cell (its replications); its mean_gap and time_quantum are
+/      replaced by each cell's
+/    int num_quanta
+/      Number of entries in quanta
+/    int quanta[]
+/      Time quanta RR is swept over (other algorithms ignore them)
+/    int num_loads
+/      Number of entries in loads
+/    double loads[]
+/      Mean arrival gaps swept over; smaller gaps are heavier loads
+/    int workers
+/      Worker processes to run at once, or 0 for one per CPU
+/    int shard_size
+/      Grid points handed to a worker at a time, or 0 to choose
+/    int max_attempts
+/      Times a shard is started before the sweep gives up on it
+/
+/  Relationships:
+/    - contains an EnsembleSpec
+/    - read by run_sweep
+/---------------------------------------------------------*/
+typedef struct {
+    EnsembleSpec base;
+    int num_quanta;
+    int quanta[SWEEP_MAX_VALUES];
+    int num_loads;
+    double loads[SWEEP_MAX_VALUES];
+    int workers;
+    int shard_size;
+    int max_attempts;
+} SweepSpec;
+
+/*---------- STRUCTURE: SweepCell --------------------------
+/  Structure Description:
+/    One cell of the sweep's grid and its merged results.
+/
+/  Fields:
+/    char algorithm[8]
+/      The algorithm
+/    int time_quantum
+/      The time quantum, or 0 for algorithms other than RR
+/    double mean_gap
+/      The load level
+/    Estimate metrics[ENSEMBLE_METRICS]
+/      Estimates over the cell's seeds
+/    LatencyHistograms latency
+/      The latency histograms of the cell's seeds, merged
+/
+/  Relationships:
+/    - filled in by run_sweep
+/---------------------------------------------------------*/
+typedef struct {
+    char algorithm[8];
+    int time_quantum;
+    double mean_gap;
+    Estimate metrics[ENSEMBLE_METRICS];
+    LatencyHistograms latency;
+} SweepCell;
+
+void init_sweep_spec(SweepSpec *spec);
+int sweep_num_cells(SweepSpec *spec);
+int run_sweep(SweepSpec *spec, SweepCell cells[], int *restarts);
+
+#endif
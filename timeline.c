@@ -0,0 +1,81 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   timeline.c
+/
+/  File Description:
+/    This file implements the Timeline, which records the run
+/    segments produced by a simulation so that they can be charted
+/    once the simulation is complete.
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "timeline.h"
+#include "arena.h"
+
+#define TIMELINE_INITIAL_CAPACITY 64
+
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions manage the lifetime and contents of a Timeline.
+/
+/  Functions and Their Purpose:
+/    - init_timeline: Initializes an empty timeline whose segments
+/      are allocated from arena (NULL for the heap).
+/    - free_timeline: Releases the segment array.
+/    - timeline_run: Records that process proc ran from start to end.
+/      If the most recent segment belongs to the same process and ends
+/      at start, it is extended instead of adding a new segment.
+/
+/  Input Parameters:
+/    - Timeline *timeline: the timeline to operate on
+/    - Arena *arena: where to allocate the segments
+/    - int proc: the index member of the process that ran
+/    - long long start, long long end: the interval it ran for, end exclusive
+/
+/  Output:
+/    - N/A - the timeline is modified directly
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - assumes runs are recorded in time order
+/    - a run that the segment array cannot be grown for is dropped,
+/      and the arena is marked failed
+/------------------------------------------------------------------------*/
+void init_timeline(Timeline *timeline, Arena *arena) {
+    timeline->segments = NULL;
+    timeline->count = 0;
+    timeline->capacity = 0;
+    timeline->arena = arena;
+}
+
+void free_timeline(Timeline *timeline) {
+    arena_release(timeline->arena, timeline->segments);
+    init_timeline(timeline, timeline->arena);
+}
+
+void timeline_run(Timeline *timeline, int proc, long long start, long long end) {
+    if (timeline->count > 0) {
+        Segment *last = &timeline->segments[timeline->count - 1];
+        if (last->proc == proc && last->end == start) {
+            last->end = end;
+            return;
+        }
+    }
+
+    if (timeline->count == timeline->capacity) {
+        int capacity = timeline->capacity ? timeline->capacity * 2 : TIMELINE_INITIAL_CAPACITY;
+        Segment *segments = arena_grow(timeline->arena, timeline->segments,
+                                       timeline->capacity * sizeof(Segment),
+                                       capacity * sizeof(Segment));
+
+        if (segments == NULL) return;
+        timeline->segments = segments;
+        timeline->capacity = capacity;
+    }
+
+    timeline->segments[timeline->count].proc = proc;
+    timeline->segments[timeline->count].start = start;
+    timeline->segments[timeline->count].end = end;
+    timeline->count++;
+}
@@ -0,0 +1,70 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   timeline.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include "arena.h"
+
+/*---------- STRUCTURE: Segment ----------------------------
+/  Structure Description:
+/    One uninterrupted interval during which a process held the CPU.
+/
+/  Fields:
+/    int proc
+/      The process's index member (its position in the input)
+/    long long start
+/      Time at which the process was dispatched
+/    long long end
+/      Time at which the process stopped running (exclusive)
+/
+/  Relationships:
+/    - stored in the segments array of a Timeline
+/---------------------------------------------------------*/
+typedef struct {
+    int proc;
+    long long start;
+    long long end;
+} Segment;
+
+/*---------- STRUCTURE: Timeline ---------------------------
+/  Structure Description:
+/    The run history of a simulation, kept as a growable array of
+/    Segments in the order they were run. Adjacent runs of the same
+/    process are merged, so its size grows with the number of
+/    dispatches rather than with the length of the simulation.
+/
+/  Fields:
+/    Segment *segments
+/      Array of run segments
+/    int count
+/      Number of segments in use
+/    int capacity
+/      Number of segments allocated
+/    Arena *arena
+/      Where the segments are allocated, or NULL for the heap. The
+/      Gantt chart takes its scratch space from here too.
+/
+/  Relationships:
+/    - contains an array of Segment structs
+/    - read by display_gantt to draw the Gantt chart
+/---------------------------------------------------------*/
+typedef struct {
+    Segment *segments;
+    int count;
+    int capacity;
+    Arena *arena;
+} Timeline;
+
+void init_timeline(Timeline *timeline, Arena *arena);
+void free_timeline(Timeline *timeline);
+void timeline_run(Timeline *timeline, int proc, long long start, long long end);
+
+#endif
@@ -0,0 +1,232 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   trace.c
+/
+/  File Description:
+/    This file implements a streaming exporter that writes the
+/    schedule produced by a simulation as Chrome trace-event JSON.
+/    Each process gets its own track (tid = its position in the
+/    arrival-sorted process array), and track 0 shows the CPU. Running
+/    intervals are written as complete ("X") slices, and arrivals,
+/    preemptions and the ends of RR time slices as instant ("i")
+/    events. One simulated time unit is
+/    written as one microsecond.
+/
+/  Citations:
+/  - Trace Event Format: https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "process.h"
+#include "trace.h"
+#include "stats.h"
+#include "report.h"
+
+#define TRACE_PID 1
+#define TRACE_CPU_TID 0
+
+void trace_begin_event(TraceWriter *trace);
+void trace_slice(TraceWriter *trace, int tid, const char *name, long long start, long long end);
+void trace_instant(TraceWriter *trace, int tid, const char *name, long long time);
+void trace_track_name(TraceWriter *trace, int tid, const char *prefix, const char *name);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: trace_open --------------------------
+/  Function Description:
+/    Opens the trace file and writes the JSON preamble along with the
+/    metadata that names the simulated process and the CPU track.
+/    If path is empty, the writer is left disabled.
+/
+/  Caller Input:
+/    TraceWriter *trace: the writer to initialize
+/    const char *path: pathway of the trace file, or "" for none
+/    const char *alg_name: algorithm name, shown as the process name
+/
+/  Caller Output:
+/    0 on success (or when disabled), 1 if the file could not be opened
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - prints to stderr if the file does not open, and leaves the
+/      writer disabled so the simulation can still run
+/---------------------------------------------------------*/
+int trace_open(TraceWriter *trace, const char *path, const char *alg_name) {
+    trace->fp = NULL;
+    trace->num_events = 0;
+    trace->running_tid = -1;
+    trace->running_id[0] = '\0';
+    trace->running_start = 0;
+
+    if (path == NULL || path[0] == '\0') {
+        return 0;
+    }
+
+    trace->fp = fopen(path, "w");
+    if (trace->fp == NULL) {
+        fprintf(stderr, "Error: trace file did not open.\n");
+        return 1;
+    }
+
+    fprintf(trace->fp, "{\"traceEvents\":[\n");
+
+    trace_begin_event(trace);
+    fprintf(trace->fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+            "\"args\":{\"name\":\"", TRACE_PID);
+    report_json_escaped(trace->fp, alg_name);
+    fputs("\"}}", trace->fp);
+    trace_track_name(trace, TRACE_CPU_TID, "", "CPU");
+
+    return 0;
+}
+
+/*---------- FUNCTION: trace_close -------------------------
+/  Function Description:
+/    Closes any slice that is still open, terminates the JSON
+/    document and closes the trace file.
+/
+/  Caller Input:
+/    TraceWriter *trace: the writer to close
+/    long long current_time: simulation time at which the run ended
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void trace_close(TraceWriter *trace, long long current_time) {
+    if (trace->fp == NULL) return;
+
+    trace_stop(trace, current_time);
+    fprintf(trace->fp, "\n]}\n");
+    STAT_ADD(bytes_trace, ftell(trace->fp));
+    fclose(trace->fp);
+    trace->fp = NULL;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions are called by the simulators as the schedule
+/    unfolds, and write the matching trace events straight to the file.
+/
+/  Functions and Their Purpose:
+/    - trace_arrival: Names the process's track and marks its arrival.
+/    - trace_run: Records that a process holds the CPU at current_time.
+/      Repeated calls for the same process extend the open slice. A call
+/      for a different process closes the open slice and marks it as
+/      preempted, since completed processes are closed by trace_stop.
+/    - trace_stop: Closes the open slice (the process completed, or the
+/      CPU is about to go idle).
+/    - trace_expire: Closes the open slice and marks its time slice as
+/      expired, for an RR process that gives up the CPU to another, so
+/      that it is not marked as preempted by trace_run.
+/
+/  Input Parameters:
+/    - TraceWriter *trace: the writer, a no-op if it is disabled
+/    - Process *process: the process the event belongs to
+/    - int tid: the process's track id (index in the arrival-sorted
+/      process array, plus one)
+/    - long long current_time: simulation time of the event
+/
+/  Output:
+/    - N/A - events are written to the trace file
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - assumes a single CPU, so at most one slice is open at a time
+/------------------------------------------------------------------------*/
+void trace_arrival(TraceWriter *trace, Process *process, int tid) {
+    if (trace->fp == NULL) return;
+
+    trace_track_name(trace, tid, "P", process->id);
+    trace_instant(trace, tid, "Arrival", process->arrival_time);
+}
+
+void trace_run(TraceWriter *trace, Process *process, int tid, long long current_time) {
+    if (trace->fp == NULL || trace->running_tid == tid) return;
+
+    if (trace->running_tid != -1) {
+        trace_instant(trace, trace->running_tid, "Preempted", current_time);
+        trace_stop(trace, current_time);
+    }
+
+    trace->running_tid = tid;
+    trace->running_start = current_time;
+    strcpy(trace->running_id, process->id);
+}
+
+void trace_stop(TraceWriter *trace, long long current_time) {
+    if (trace->fp == NULL || trace->running_tid == -1) return;
+
+    trace_slice(trace, trace->running_tid, trace->running_id,
+                trace->running_start, current_time);
+    trace_slice(trace, TRACE_CPU_TID, trace->running_id,
+                trace->running_start, current_time);
+    trace->running_tid = -1;
+}
+
+void trace_expire(TraceWriter *trace, long long current_time) {
+    if (trace->fp == NULL || trace->running_tid == -1) return;
+
+    trace_instant(trace, trace->running_tid, "Expired", current_time);
+    trace_stop(trace, current_time);
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions write single trace events.
+/
+/  Functions and Their Purpose:
+/    - trace_begin_event: Writes the comma before every event but the
+/      first.
+/    - trace_slice: Writes a complete slice of a process's run.
+/    - trace_instant: Writes an instant event.
+/    - trace_track_name: Names a track and sets its sort order.
+/      Process IDs are escaped with report_json_escaped.
+/
+/  Input Parameters:
+/    - TraceWriter *trace: the writer
+/    - int tid: the track id
+/    - const char *name, *prefix, *value: the text to write
+/    - long long start, end, time: simulation times of the event
+/
+/  Output:
+/    - N/A - events are written to the trace file
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+void trace_begin_event(TraceWriter *trace) {
+    if (trace->num_events > 0) {
+        fputs(",\n", trace->fp);
+    }
+    trace->num_events++;
+}
+
+void trace_slice(TraceWriter *trace, int tid, const char *name, long long start, long long end) {
+    trace_begin_event(trace);
+    fputs("{\"name\":\"P", trace->fp);
+    report_json_escaped(trace->fp, name);
+    fprintf(trace->fp, "\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,"
+            "\"pid\":%d,\"tid\":%d}", start, end - start, TRACE_PID, tid);
+}
+
+void trace_instant(TraceWriter *trace, int tid, const char *name, long long time) {
+    trace_begin_event(trace);
+    fprintf(trace->fp, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lld,"
+            "\"pid\":%d,\"tid\":%d}", name, time, TRACE_PID, tid);
+}
+
+void trace_track_name(TraceWriter *trace, int tid, const char *prefix, const char *name) {
+    trace_begin_event(trace);
+    fprintf(trace->fp, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+            "\"args\":{\"name\":\"%s", TRACE_PID, tid, prefix);
+    report_json_escaped(trace->fp, name);
+    fputs("\"}}", trace->fp);
+    trace_begin_event(trace);
+    fprintf(trace->fp, "{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+            "\"args\":{\"sort_index\":%d}}", TRACE_PID, tid, tid);
+}
@@ -0,0 +1,55 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   trace.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include "process.h"
+
+/*---------- STRUCTURE: TraceWriter -----------------------
+/  Structure Description:
+/    Streams a simulated schedule to a file in the Chrome trace-event
+/    JSON format, which can be opened in Perfetto or chrome://tracing.
+/    Events are written as soon as they happen, so only the slice that
+/    is currently running is held in memory.
+/
+/  Fields:
+/    FILE *fp
+/      The trace file, or NULL when tracing is disabled. Every trace_*
+/      function is a no-op when this is NULL.
+/    long long num_events
+/      Number of events written so far (used for comma placement)
+/    int running_tid
+/      Track id of the process whose slice is open, or -1 if none
+/    char running_id[10]
+/      Process ID of the open slice, used as the slice name
+/    long long running_start
+/      Time at which the open slice started
+/
+/  Relationships:
+/    - reads Process structs to name tracks and slices
+/---------------------------------------------------------*/
+typedef struct {
+    FILE *fp;
+    long long num_events;
+    int running_tid;
+    char running_id[10];
+    long long running_start;
+} TraceWriter;
+
+int trace_open(TraceWriter *trace, const char *path, const char *alg_name);
+void trace_close(TraceWriter *trace, long long current_time);
+void trace_arrival(TraceWriter *trace, Process *process, int tid);
+void trace_run(TraceWriter *trace, Process *process, int tid, long long current_time);
+void trace_stop(TraceWriter *trace, long long current_time);
+void trace_expire(TraceWriter *trace, long long current_time);
+
+#endif
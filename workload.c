@@ -0,0 +1,517 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   workload.c
+/
+/  File Description:
+/    This file implements the binary workload format: a header, then
+/    a fixed-width column for each of the arrival times, burst times,
+/    priorities and IDs, with the IDs interned in a table of their own
+/    (see WorkloadHeader). A file in this format is mapped into memory
+/    and its columns read where they lie, so opening one costs the
+/    same for a hundred million processes as for ten, and a workload
+/    that is run again and again is only ever parsed once, by
+/    workload_convert.
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "process.h"
+#include "simulator.h"
+#include "workload.h"
+
+#define WORKLOAD_LINE_MAX 256
+#define WORKLOAD_COPY_SIZE 65536
+
+/*---------- STRUCTURE: IdTable ----------------------------
+/  Structure Description:
+/    The IDs seen by workload_convert, each stored once, with a hash
+/    table to find them.
+/
+/  Fields:
+/    char (*ids)[WORKLOAD_ID_SIZE]
+/      The distinct IDs, in the order first seen
+/    long long count, capacity
+/      Number of IDs held, and room for
+/    uint32_t *slots
+/      Open-addressed hash table of indices into ids, plus one (0
+/      marks an empty slot)
+/    size_t num_slots
+/      Size of slots, a power of two at least twice count
+/
+/  Relationships:
+/    - used only by workload_convert
+/---------------------------------------------------------*/
+typedef struct {
+    char (*ids)[WORKLOAD_ID_SIZE];
+    long long count;
+    long long capacity;
+    uint32_t *slots;
+    size_t num_slots;
+} IdTable;
+
+void workload_process(const Workload *workload, long long index, int with_priority, Process *process);
+long long id_intern(IdTable *table, const char *id);
+size_t id_hash(const char *id);
+int id_grow(IdTable *table);
+int copy_column(FILE *from, FILE *to, int64_t *offset);
+int64_t column_end(int64_t offset, long long count, size_t width);
+
+
+/*---------- Public Functions Used Outside Module ----------------------------*/
+/*---------- FUNCTION: workload_is_binary ------------------
+/  Function Description:
+/    Checks whether a file is a binary workload, by its magic number.
+/
+/  Caller Input:
+/    const char *path: pathway of the file
+/
+/  Caller Output:
+/    1 if it is a binary workload, 0 if not or if it does not open
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - only regular files are checked, since reading the magic number 
+/      from a pipe or terminal (e.g. /dev/stdin) would consume it, and 
+/      a binary workload must be mapped anyway
+/---------------------------------------------------------*/
+int workload_is_binary(const char *path) {
+    char magic[8];
+    struct stat info;
+    FILE *fp;
+    int is_binary;
+
+    if (stat(path, &info) != 0 || !S_ISREG(info.st_mode)) return 0;
+    fp = fopen(path, "rb");
+    if (fp == NULL) return 0;
+    is_binary = fread(magic, 1, sizeof(magic), fp) == sizeof(magic) &&
+                memcmp(magic, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC)) == 0;
+    fclose(fp);
+    return is_binary;
+}
+
+/*---------- FUNCTION: workload_map ------------------------
+/  Function Description:
+/    Maps a binary workload file into memory, read-only, and checks
+/    that its header and columns are in order.
+/
+/  Caller Input:
+/    Workload *workload: filled in with the mapping and its columns
+/    const char *path: pathway of the file
+/
+/  Caller Output:
+/    0 on success, 1 if the file does not open or is not a valid
+/    workload (an error is printed)
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - the mapping is advised to be read in order, as the streaming
+/      simulator does; pages are only read from disk when reached
+/    - the columns themselves are not read here, so an ID index that is
+/      out of range is only found when its process is read
+/---------------------------------------------------------*/
+int workload_map(Workload *workload, const char *path) {
+    const WorkloadHeader *header;
+    struct stat info;
+    int fd = open(path, O_RDONLY);
+    int valid;
+
+    memset(workload, 0, sizeof(Workload));
+    if (fd < 0) {
+        fprintf(stderr, "Error: input file did not open.\n");
+        return 1;
+    }
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(WorkloadHeader)) {
+        fprintf(stderr, "Error: %s is not a valid workload file.\n", path);
+        close(fd);
+        return 1;
+    }
+
+    workload->size = info.st_size;
+    workload->base = mmap(NULL, workload->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (workload->base == MAP_FAILED) {
+        fprintf(stderr, "Error: input file could not be mapped.\n");
+        workload->base = NULL;
+        return 1;
+    }
+
+    header = workload->base;
+    valid = memcmp(header->magic, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC)) == 0 &&
+            header->version == WORKLOAD_VERSION &&
+            header->count >= 0 && header->count <= INT_MAX &&
+            header->num_ids >= 0 && header->num_ids <= UINT32_MAX &&
+            column_end(header->arrival_offset, header->count, sizeof(int64_t)) <= (int64_t)workload->size &&
+            column_end(header->burst_offset, header->count, sizeof(int64_t)) <= (int64_t)workload->size &&
+            column_end(header->priority_offset, header->count, sizeof(int32_t)) <= (int64_t)workload->size &&
+            column_end(header->id_offset, header->count, sizeof(uint32_t)) <= (int64_t)workload->size &&
+            column_end(header->ids_offset, header->num_ids, WORKLOAD_ID_SIZE) <= (int64_t)workload->size;
+    if (!valid) {
+        fprintf(stderr, "Error: %s is not a valid workload file.\n", path);
+        workload_unmap(workload);
+        return 1;
+    }
+
+    workload->count = header->count;
+    workload->has_priority = (header->flags & WORKLOAD_HAS_PRIORITY) != 0;
+    workload->arrival = (const int64_t *)((const char *)workload->base + header->arrival_offset);
+    workload->burst = (const int64_t *)((const char *)workload->base + header->burst_offset);
+    workload->priority = (const int32_t *)((const char *)workload->base + header->priority_offset);
+    workload->id = (const uint32_t *)((const char *)workload->base + header->id_offset);
+    workload->ids = (const char (*)[WORKLOAD_ID_SIZE])((const char *)workload->base + header->ids_offset);
+    workload->num_ids = header->num_ids;
+    madvise(workload->base, workload->size, MADV_SEQUENTIAL);
+    return 0;
+}
+
+/*---------- FUNCTION: workload_unmap ----------------------
+/  Function Description:
+/    Unmaps a workload mapped by workload_map.
+/
+/  Caller Input:
+/    Workload *workload: the workload
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - safe to call on a workload that failed to map
+/---------------------------------------------------------*/
+void workload_unmap(Workload *workload) {
+    if (workload->base != NULL) {
+        munmap(workload->base, workload->size);
+    }
+    memset(workload, 0, sizeof(Workload));
+}
+
+/*---------- FUNCTION: workload_load -----------------------
+/  Function Description:
+/    Copies a mapped workload into a processes array, for the
+/    simulators that hold the whole workload at once. Does what
+/    sim_read_workload does for a text file.
+/
+/  Caller Input:
+/    const Workload *workload: the workload
+/    Process processes[]: where to put the processes
+/    int max_processes: room in processes
+/    int with_priority: 1 if the algorithm uses priorities
+/
+/  Caller Output:
+/    The number of processes, or -1 if they do not fit, lack the
+/    priorities the algorithm needs, or have duplicate IDs (an error
+/    is printed)
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+int workload_load(const Workload *workload, Process processes[], int max_processes, int with_priority) {
+    if (workload->count > max_processes) {
+        fprintf(stderr, "Error: the workload has %lld processes; at most %d can be simulated "
+                "without -s.\n", workload->count, max_processes);
+        return -1;
+    }
+    if (with_priority && !workload->has_priority) {
+        fprintf(stderr, "Error: the workload has no priorities.\n");
+        return -1;
+    }
+
+    for (int i = 0; i < workload->count; i++) {
+        if (workload->id[i] >= workload->num_ids) {
+            fprintf(stderr, "Error: malformed process on line %d.\n", i + 1);
+            return -1;
+        }
+        workload_process(workload, i, with_priority, &processes[i]);
+        if (!is_unique_id(processes, i, processes[i].id)) {
+            fprintf(stderr, "Error: ID %s is taken. IDs must be unique.\n", processes[i].id);
+            return -1;
+        }
+    }
+    return (int)workload->count;
+}
+
+/*---------- FUNCTION: workload_convert --------------------
+/  Function Description:
+/    Converts a workload from the text format, one "id arrival burst
+/    [priority]" per line, to a binary workload file. The columns are
+/    collected in temporary files as the text is read, so only the
+/    distinct IDs are held in memory, and are then gathered behind the
+/    header.
+/
+/  Caller Input:
+/    FILE *in: the text workload
+/    const char *path: pathway of the binary file to write
+/
+/  Caller Output:
+/    The number of processes converted, or -1 on failure (an error is
+/    printed)
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - unlike the simulators' readers, the text is read a line at a
+/      time, so a file with priorities converts the same whichever
+/      algorithm it is meant for
+/    - the priority column is kept only if every line has one
+/    - blank lines are skipped
+/---------------------------------------------------------*/
+long long workload_convert(FILE *in, const char *path) {
+    WorkloadHeader header;
+    IdTable table;
+    FILE *columns[4];
+    FILE *out;
+    char line[WORKLOAD_LINE_MAX];
+    long long count = 0;
+    long long line_number = 0;
+    int all_priorities = 1;
+    int status = 0;
+
+    memset(&table, 0, sizeof(IdTable));
+    for (int c = 0; c < 4; c++) {
+        columns[c] = tmpfile();
+        if (columns[c] == NULL) {
+            fprintf(stderr, "Error: temporary file did not open.\n");
+            while (--c >= 0) fclose(columns[c]);
+            return -1;
+        }
+    }
+
+    while (status == 0 && fgets(line, sizeof(line), in) != NULL) {
+        char id[16], extra[2];
+        long long arrival, burst;
+        int priority = -1;
+        int vals_read = sscanf(line, "%15s %lld %lld %d %1s", id, &arrival, &burst, &priority, extra);
+        int64_t arrival64, burst64;
+        int32_t priority32;
+        long long interned;
+        uint32_t index;
+
+        line_number++;
+        if (vals_read == EOF) continue;
+        if (vals_read < 3 || vals_read > 4 || strlen(id) >= WORKLOAD_ID_SIZE || arrival < 0 || burst < 0) {
+            fprintf(stderr, "Error: malformed process on line %lld.\n", line_number);
+            status = 1;
+            break;
+        }
+        if (count == INT_MAX) {
+            fprintf(stderr, "Error: a workload holds at most %d processes.\n", INT_MAX);
+            status = 1;
+            break;
+        }
+        if (vals_read == 3) all_priorities = 0;
+
+        arrival64 = arrival;
+        burst64 = burst;
+        priority32 = priority;
+        interned = id_intern(&table, id);
+        if (interned < 0) {
+            status = 1;
+            break;
+        }
+        index = (uint32_t)interned;
+        fwrite(&arrival64, sizeof(arrival64), 1, columns[0]);
+        fwrite(&burst64, sizeof(burst64), 1, columns[1]);
+        fwrite(&priority32, sizeof(priority32), 1, columns[2]);
+        fwrite(&index, sizeof(index), 1, columns[3]);
+        count++;
+    }
+
+    out = status == 0 ? fopen(path, "wb") : NULL;
+    if (status == 0 && out == NULL) {
+        fprintf(stderr, "Error: output file did not open.\n");
+        status = 1;
+    }
+
+    if (status == 0) {
+        int64_t offset = sizeof(WorkloadHeader);
+
+        memset(&header, 0, sizeof(WorkloadHeader));
+        memcpy(header.magic, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC));
+        header.version = WORKLOAD_VERSION;
+        header.flags = (all_priorities && count > 0) ? WORKLOAD_HAS_PRIORITY : 0;
+        header.count = count;
+        header.num_ids = table.count;
+        fwrite(&header, sizeof(WorkloadHeader), 1, out);
+
+        /* the offsets are filled in as the columns are copied */
+        header.arrival_offset = offset;
+        status |= copy_column(columns[0], out, &offset);
+        header.burst_offset = offset;
+        status |= copy_column(columns[1], out, &offset);
+        header.priority_offset = offset;
+        status |= copy_column(columns[2], out, &offset);
+        header.id_offset = offset;
+        status |= copy_column(columns[3], out, &offset);
+        header.ids_offset = offset;
+        if (table.count > 0) {
+            fwrite(table.ids, WORKLOAD_ID_SIZE, table.count, out);
+        }
+
+        fseek(out, 0, SEEK_SET);
+        fwrite(&header, sizeof(WorkloadHeader), 1, out);
+        if (ferror(out)) status = 1;
+        if (fclose(out) != 0) status = 1;
+        if (status != 0) {
+            fprintf(stderr, "Error: workload file could not be written.\n");
+        }
+    }
+
+    for (int c = 0; c < 4; c++) fclose(columns[c]);
+    free(table.ids);
+    free(table.slots);
+    return status == 0 ? count : -1;
+}
+
+
+/*---------- Helper Functions Not Used Outside Module ------------------------*/
+/*---------- FUNCTION: workload_process --------------------
+/  Function Description:
+/    Copies one process out of a mapped workload.
+/
+/  Caller Input:
+/    const Workload *workload: the workload
+/    long long index: the process's position
+/    int with_priority: 1 to copy its priority, 0 to leave it -1
+/    Process *process: where to put it
+/
+/  Caller Output:
+/    N/A - No output values
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/---------------------------------------------------------*/
+void workload_process(const Workload *workload, long long index, int with_priority, Process *process) {
+    memcpy(process->id, workload->ids[workload->id[index]], WORKLOAD_ID_SIZE);
+    process->id[WORKLOAD_ID_SIZE - 1] = '\0';
+    process->arrival_time = workload->arrival[index];
+    process->burst_time = workload->burst[index];
+    process->priority = (with_priority && workload->has_priority) ? workload->priority[index] : -1;
+    reset_process(process, (int)index);
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions intern the IDs read by workload_convert.
+/
+/  Functions and Their Purpose:
+/    - id_intern: Returns the index of an ID, adding it if it is new,
+/      or -1 if memory runs out.
+/    - id_hash: Hashes an ID (FNV-1a).
+/    - id_grow: Doubles the hash table and re-inserts every ID.
+/      Returns 1 if memory runs out, leaving the table as it was.
+/
+/  Input Parameters:
+/    - IdTable *table: the table
+/    - const char *id: an ID of at most WORKLOAD_ID_SIZE - 1 characters
+/
+/  Output:
+/    - see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    - prints an error if memory runs out
+/------------------------------------------------------------------------*/
+long long id_intern(IdTable *table, const char *id) {
+    size_t slot;
+
+    if ((size_t)(table->count + 1) * 2 > table->num_slots && id_grow(table) != 0) {
+        return -1;
+    }
+
+    slot = id_hash(id) & (table->num_slots - 1);
+    while (table->slots[slot] != 0) {
+        uint32_t index = table->slots[slot] - 1;
+        if (strncmp(table->ids[index], id, WORKLOAD_ID_SIZE) == 0) return index;
+        slot = (slot + 1) & (table->num_slots - 1);
+    }
+
+    if (table->count == table->capacity) {
+        long long capacity = table->capacity > 0 ? table->capacity * 2 : 1024;
+        char (*ids)[WORKLOAD_ID_SIZE] = realloc(table->ids, capacity * WORKLOAD_ID_SIZE);
+
+        if (ids == NULL) {
+            fprintf(stderr, "Error: out of memory converting the workload.\n");
+            return -1;
+        }
+        table->ids = ids;
+        table->capacity = capacity;
+    }
+    memset(table->ids[table->count], 0, WORKLOAD_ID_SIZE);
+    strcpy(table->ids[table->count], id);
+    table->slots[slot] = (uint32_t)(table->count + 1);
+    return table->count++;
+}
+
+size_t id_hash(const char *id) {
+    size_t hash = 14695981039346656037ULL;
+
+    for (const char *c = id; *c != '\0'; c++) {
+        hash = (hash ^ (unsigned char)*c) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+int id_grow(IdTable *table) {
+    size_t num_slots = table->num_slots > 0 ? table->num_slots * 2 : 2048;
+    uint32_t *slots = calloc(num_slots, sizeof(uint32_t));
+
+    if (slots == NULL) {
+        fprintf(stderr, "Error: out of memory converting the workload.\n");
+        return 1;
+    }
+    for (long long i = 0; i < table->count; i++) {
+        size_t slot = id_hash(table->ids[i]) & (num_slots - 1);
+        while (slots[slot] != 0) slot = (slot + 1) & (num_slots - 1);
+        slots[slot] = (uint32_t)(i + 1);
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->num_slots = num_slots;
+    return 0;
+}
+
+/*---------- FUNCTION DOCUMENTATION BLOCK ------------------------------
+/  Functions Overview:
+/    These functions lay out the columns of a workload file.
+/
+/  Functions and Their Purpose:
+/    - copy_column: Appends a column from its temporary file to the
+/      workload file, then pads it to an 8-byte boundary.
+/    - column_end: Returns where a column of count entries of the given
+/      width ends, or INT64_MAX if its offset is out of place.
+/
+/  Input Parameters:
+/    - FILE *from, *to: the temporary file and the workload file
+/    - int64_t *offset: the offset of the column; moved past it
+/    - long long count: entries in the column
+/    - size_t width: size of an entry
+/
+/  Output:
+/    - copy_column: 0 on success, 1 on failure
+/    - column_end: see above
+/
+/  Assumptions, Limitations, Known Bugs:
+/    N/A
+/------------------------------------------------------------------------*/
+int copy_column(FILE *from, FILE *to, int64_t *offset) {
+    static const char padding[8] = {0};
+    char buffer[WORKLOAD_COPY_SIZE];
+    size_t length;
+
+    rewind(from);
+    while ((length = fread(buffer, 1, sizeof(buffer), from)) > 0) {
+        if (fwrite(buffer, 1, length, to) != length) return 1;
+        *offset += length;
+    }
+    if (ferror(from)) return 1;
+
+    length = (8 - (*offset % 8)) % 8;
+    fwrite(padding, 1, length, to);
+    *offset += length;
+    return 0;
+}
+
+int64_t column_end(int64_t offset, long long count, size_t width) {
+    if (offset < (int64_t)sizeof(WorkloadHeader) || offset % 8 != 0) return INT64_MAX;
+    return offset + count * (int64_t)width;
+}
@@ -0,0 +1,121 @@
+/*---------- ID HEADER -------------------------------------
+/  Author(s):   Andrew Boisvert, Kyle Scidmore
+/  Email(s):    abois526@mtroyal.ca, kscid125@mtroyal.ca
+/  File Name:   workload.h
+/
+/  Program Purpose(s):
+/    This header file describes the public interface of the accompanying
+/    ".c" file, describing how this module may be used by others.
+/---------------------------------------------------------*/
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "process.h"
+
+#define WORKLOAD_MAGIC "SCHEDWL"
+#define WORKLOAD_VERSION 1
+#define WORKLOAD_HAS_PRIORITY 1
+#define WORKLOAD_ID_SIZE 10
+
+/*---------- STRUCTURE: WorkloadHeader ---------------------
+/  Structure Description:
+/    The start of a binary workload file. The header is followed by
+/    one column per field, each an array with one entry per process,
+/    and then by the table of interned IDs. Columns start on 8-byte
+/    boundaries, at the offsets given here, and hold native-endian
+/    integers, so a file is only read on machines like the one that
+/    wrote it.
+/
+/  Fields:
+/    char magic[8]
+/      WORKLOAD_MAGIC, NUL-terminated
+/    uint32_t version
+/      WORKLOAD_VERSION
+/    uint32_t flags
+/      WORKLOAD_HAS_PRIORITY if the priority column was given
+/    int64_t count
+/      Number of processes
+/    int64_t num_ids
+/      Number of distinct IDs
+/    int64_t arrival_offset, burst_offset
+/      Offsets of the int64_t arrival and burst time columns
+/    int64_t priority_offset
+/      Offset of the int32_t priority column, which is always
+/      written; without WORKLOAD_HAS_PRIORITY its entries are -1
+/      where a line gave no priority, and are not read
+/    int64_t id_offset
+/      Offset of the uint32_t column of indices into the ID table
+/    int64_t ids_offset
+/      Offset of the ID table: num_ids NUL-padded WORKLOAD_ID_SIZE
+/      byte entries
+/
+/  Relationships:
+/    - written by workload_convert, read by workload_map
+/---------------------------------------------------------*/
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    int64_t count;
+    int64_t num_ids;
+    int64_t arrival_offset;
+    int64_t burst_offset;
+    int64_t priority_offset;
+    int64_t id_offset;
+    int64_t ids_offset;
+} WorkloadHeader;
+
+/*---------- STRUCTURE: Workload ---------------------------
+/  Structure Description:
+/    A binary workload file mapped into memory, read-only. The
+/    columns are used where they lie, so nothing is parsed or copied
+/    when it is opened, however many processes it holds.
+/
+/  Fields:
+/    void *base
+/      Start of the mapping
+/    size_t size
+/      Length of the mapping
+/    long long count
+/      Number of processes
+/    int has_priority
+/      1 if the priority column was given
+/    const int64_t *arrival, *burst
+/      The arrival and burst time columns
+/    const int32_t *priority
+/      The priority column
+/    const uint32_t *id
+/      Each process's index into ids
+/    const char (*ids)[WORKLOAD_ID_SIZE]
+/      The interned IDs
+/    long long num_ids
+/      Number of entries in ids
+/
+/  Relationships:
+/    - filled in by workload_map; read by sim_stream_workload and
+/      workload_load
+/---------------------------------------------------------*/
+typedef struct {
+    void *base;
+    size_t size;
+    long long count;
+    int has_priority;
+    const int64_t *arrival;
+    const int64_t *burst;
+    const int32_t *priority;
+    const uint32_t *id;
+    const char (*ids)[WORKLOAD_ID_SIZE];
+    long long num_ids;
+} Workload;
+
+int workload_is_binary(const char *path);
+int workload_map(Workload *workload, const char *path);
+void workload_unmap(Workload *workload);
+int workload_load(const Workload *workload, Process processes[], int max_processes, int with_priority);
+long long workload_convert(FILE *in, const char *path);
+
+#endif